@@ -11,37 +11,104 @@
  */
 
 #include <string.h>
+#include <unistd.h>
 
 #include "array_list.h"
+#include "thread_pool.h"
+
+// 扩容阈值，容量小于该值时成倍扩容
+const static int ExpandThreshold = CLIB_ARRAY_LIST_EXPAND_THRESHOLD;
+
+// 默认容量策略
+const static ListGrowthPolicy DefaultPolicy = CLIB_ARRAY_LIST_DEFAULT_POLICY;
+
+// 元素少于该值时不分线程排序，每个线程至少分到该值的八分之一
+const static size_t ParallelSortThreshold = 1 << 16;
+
+// 多线程排序的一个合并任务：把第run段与第run+1段合并后的第[from, to)个输出
+typedef struct {
+    size_t run, from, to;
+} MergeTask;
+
+// 多线程排序的共享状态，各线程只写互不相交的区间
+typedef struct {
+    unsigned char *src, *dst;
+    size_t size;
+    ListElemCtxComparer *cmp;
+    void *ctx;
+    _Bool stable;
+    size_t *bounds; // 第i段为[bounds[i], bounds[i+1])
+    size_t runs;
+    MergeTask *tasks;
+} ParallelSort;
+
+typedef void ParallelSortStep(ParallelSort *job, size_t task);
+
+// 一步中要执行的任务，由共享线程池分给各线程
+typedef struct {
+    ParallelSort *job;
+    ParallelSortStep *step;
+} SortStep;
 
-// 扩容阈值
-const static int ExpandThreshold = 256;
+// 判断是否需要缩容
+static _Bool needReduce(ArrayList *list);
 
-// 扩容系数
-const static long double ExpandFactor = 1.25L;
+// 扩容到至少能容纳minCapacity个元素
+static int expand(ArrayList *list, size_t minCapacity);
 
-// 缩容系数
-const static long double ReduceFactor = 2L;
+// 缩容
+static void reduce(ArrayList *list);
 
-// 判断是否需要缩容
-static _Bool needReduce(ArrayList *list);
+// 重新分配容量
+static int resize(ArrayList *list, size_t capacity);
+
+// 多线程排序
+static int parallelSort(ArrayList *list, ListElemCtxComparer cmp, void *ctx, size_t threads, _Bool stable);
 
-// 判断是否需要扩容
-static _Bool needExpand(ArrayList *list);
+// 由至多threads个线程执行tasks个任务，线程池不可用时由当前线程逐个执行
+static void parallelRun(ParallelSort *job, ParallelSortStep *step, size_t tasks, size_t threads);
 
-// 扩容并插入元素
-static int expandAndInsert(ArrayList *list, size_t index, const void *elem);
+static void sortSteps(size_t from, size_t to, void *ctx);
 
-// 缩容并弹出元素
-static int deallocAndPop(ArrayList *list, size_t index, void *elem);
+// 排序第task段
+static void sortRun(ParallelSort *job, size_t task);
+
+// 执行第task个合并任务
+static void mergeRun(ParallelSort *job, size_t task);
+
+// 把dst的第task段复制回src
+static void copyRun(ParallelSort *job, size_t task);
 
 extern void *pointerAdd(void *p1, size_t delta);
 
+extern void memorySwap(void *p0, void *p1, size_t size);
+
+extern size_t memoryFind(const void *base, size_t count, size_t stride, size_t offset, const void *key,
+                         size_t keySize);
+
+extern void memorySort(void *base, size_t count, size_t size, ListElemCtxComparer cmp, void *ctx);
+
+extern int memorySortStable(void *base, size_t count, size_t size, ListElemCtxComparer cmp, void *ctx);
+
+extern void memorySortStableWithBuffer(void *base, size_t count, size_t size, ListElemCtxComparer cmp, void *ctx,
+                                       void *buf);
+
+extern void memoryMerge(const void *a, size_t na, const void *b, size_t nb, void *dst, size_t size,
+                        ListElemCtxComparer cmp, void *ctx);
+
+extern size_t memoryMergeSplit(const void *a, size_t na, const void *b, size_t nb, size_t k, size_t size,
+                               ListElemCtxComparer cmp, void *ctx);
+
 ArrayList *arrayList_alloc(size_t elemSize) {
+    return arrayList_allocWithPolicy(elemSize, NULL);
+}
+
+ArrayList *arrayList_allocWithPolicy(size_t elemSize, const ListGrowthPolicy *policy) {
     ArrayList *list = malloc(sizeof(ArrayList));
     list->elemSize = elemSize;
     list->length = list->capacity = 0;
     list->elems = NULL;
+    list->policy = policy ? *policy : DefaultPolicy;
     return list;
 }
 
@@ -65,41 +132,11 @@ int arrayList_get(const ArrayList *list, size_t index, void *elem) {
 }
 
 int arrayList_insert(ArrayList *list, size_t index, const void *elem) {
-    if (index > list->length)
-        return 1;
-
-    // 扩容
-    if (needExpand(list))
-        return expandAndInsert(list, index, elem);
-
-    // 从index往后移动一位
-    if (list->length - index)
-        memmove(pointerAdd(list->elems, (index + 1) * list->elemSize),
-                pointerAdd(list->elems, index * list->elemSize),
-                list->elemSize * (list->length - index));
-    // 设置元素
-    memcpy(pointerAdd(list->elems, index * list->elemSize), elem, list->elemSize);
-
-    list->length++;
-    return 0;
+    return arrayList_insertRange(list, index, elem, 1);
 }
 
 int arrayList_del(ArrayList *list, size_t index) {
-    if (index >= list->length)
-        return 1;
-
-    // 缩容
-    if (needReduce(list))
-        return deallocAndPop(list, index, NULL);
-
-    // 从index往前移动一位
-    if (list->length - index - 1)
-        memmove(pointerAdd(list->elems, index * list->elemSize),
-                pointerAdd(list->elems, (index + 1) * list->elemSize),
-                (list->length - index - 1) * list->elemSize);
-
-    list->length--;
-    return 0;
+    return arrayList_delRange(list, index, 1);
 }
 
 int arrayList_locate(const ArrayList *list, ListElemComparer cmp, const void *elem, size_t *index) {
@@ -112,6 +149,16 @@ int arrayList_locate(const ArrayList *list, ListElemComparer cmp, const void *el
     return 1;
 }
 
+int arrayList_locateKey(const ArrayList *list, size_t offset, const void *key, size_t keySize, size_t *index) {
+    if (!list->length || offset > list->elemSize || keySize > list->elemSize - offset)
+        return 1;
+    size_t i = memoryFind(list->elems, list->length, list->elemSize, offset, key, keySize);
+    if (i == list->length)
+        return 1;
+    *index = i;
+    return 0;
+}
+
 int arrayList_travel(const ArrayList *list, ListElemVisitor visit) {
     for (size_t i = 0; i < list->length; i++)
         visit(pointerAdd(list->elems, i * list->elemSize));
@@ -119,6 +166,25 @@ int arrayList_travel(const ArrayList *list, ListElemVisitor visit) {
     return 0;
 }
 
+int arrayList_locateCtx(const ArrayList *list, ListElemCtxComparer cmp, const void *elem, void *ctx, size_t *index) {
+    for (size_t i = 0; i < list->length; i++) {
+        if (!cmp(pointerAdd(list->elems, i * list->elemSize), elem, ctx)) {
+            *index = i;
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int arrayList_travelCtx(const ArrayList *list, ListElemCtxVisitor visit, void *ctx) {
+    for (size_t i = 0; i < list->length; i++) {
+        int res = visit(pointerAdd(list->elems, i * list->elemSize), ctx);
+        if (res)
+            return res;
+    }
+    return 0;
+}
+
 int arrayList_clear(ArrayList *list) {
     free(list->elems);
     list->elems = NULL;
@@ -152,36 +218,147 @@ int arrayList_set(ArrayList *list, size_t index, const void *elem) {
 int arrayList_getDel(ArrayList *list, size_t index, void *elem) {
     if (index >= list->length)
         return 1;
+    memcpy(elem, pointerAdd(list->elems, index * list->elemSize), list->elemSize);
+    return arrayList_delRange(list, index, 1);
+}
 
-    // 缩容
-    if (needReduce(list))
-        return deallocAndPop(list, index, elem);
+int arrayList_getSet(ArrayList *list, size_t index, void *elem) {
+    if (index >= list->length)
+        return 1;
+
+    memorySwap(pointerAdd(list->elems, index * list->elemSize), elem, list->elemSize);
+    return 0;
+}
+
+int arrayList_insertRange(ArrayList *list, size_t index, const void *elems, size_t count) {
+    if (index > list->length)
+        return 1;
+    if (!count)
+        return 0;
 
+    // 扩容
+    if (list->length + count > list->capacity && expand(list, list->length + count))
+        return 2;
+
+    // 从index往后移动count位
+    if (list->length - index)
+        memmove(pointerAdd(list->elems, (index + count) * list->elemSize),
+                pointerAdd(list->elems, index * list->elemSize),
+                list->elemSize * (list->length - index));
     // 设置元素
-    memcpy(elem, pointerAdd(list->elems, index * list->elemSize), list->elemSize);
+    memcpy(pointerAdd(list->elems, index * list->elemSize), elems, list->elemSize * count);
+
+    list->length += count;
+    return 0;
+}
 
-    // 从index往前移动一位
-    if (list->length - 1 - index)
+int arrayList_delRange(ArrayList *list, size_t index, size_t count) {
+    if (index > list->length || count > list->length - index)
+        return 1;
+    if (!count)
+        return 0;
+
+    // 从index+count往前移动count位
+    if (list->length - index - count)
         memmove(pointerAdd(list->elems, index * list->elemSize),
-                pointerAdd(list->elems, (list->length - 1) * list->elemSize),
-                list->elemSize);
+                pointerAdd(list->elems, (index + count) * list->elemSize),
+                (list->length - index - count) * list->elemSize);
+    list->length -= count;
 
-    list->length--;
+    // 缩容
+    if (needReduce(list))
+        reduce(list);
     return 0;
 }
 
-int arrayList_getSet(ArrayList *list, size_t index, void *elem) {
+int arrayList_rpushN(ArrayList *list, const void *elems, size_t count) {
+    return arrayList_insertRange(list, list->length, elems, count);
+}
+
+int arrayList_getRange(const ArrayList *list, size_t index, size_t count, void *elems) {
+    if (index > list->length || count > list->length - index)
+        return 1;
+    if (count)
+        memcpy(elems, pointerAdd(list->elems, index * list->elemSize), list->elemSize * count);
+    return 0;
+}
+
+int arrayList_reserve(ArrayList *list, size_t capacity) {
+    if (capacity <= list->capacity)
+        return 0;
+    return resize(list, capacity);
+}
+
+int arrayList_shrinkToFit(ArrayList *list) {
+    if (list->length < list->capacity)
+        return resize(list, list->length);
+    return 0;
+}
+
+void *arrayList_at(const ArrayList *list, size_t index) {
     if (index >= list->length)
+        return NULL;
+    return pointerAdd(list->elems, index * list->elemSize);
+}
+
+int arrayList_span(const ArrayList *list, size_t index, size_t count, ListSpan *span) {
+    if (index > list->length || count > list->length - index)
         return 1;
+    span->base = pointerAdd(list->elems, index * list->elemSize);
+    span->length = count;
+    span->stride = list->elemSize;
+    return 0;
+}
+
+int arrayList_lowerBound(const ArrayList *list, ListElemCtxComparer cmp, const void *elem, void *ctx, size_t *index) {
+    const unsigned char *elems = list->elems;
+    size_t lo = 0, count = list->length;
+    while (count) {
+        size_t half = count / 2;
+        if (cmp(elems + (lo + half) * list->elemSize, elem, ctx) < 0) {
+            lo += half + 1;
+            count -= half + 1;
+        } else {
+            count = half;
+        }
+    }
+    *index = lo;
+    return 0;
+}
 
-    void *tmp = malloc(list->elemSize);
-    memcpy(tmp, pointerAdd(list->elems, index * list->elemSize), list->elemSize);  // 元素先放临时变量中
-    memcpy(pointerAdd(list->elems, index * list->elemSize), elem, list->elemSize); // 设置元素
-    memcpy(elem, tmp, list->elemSize);
-    free(tmp);
+int arrayList_upperBound(const ArrayList *list, ListElemCtxComparer cmp, const void *elem, void *ctx, size_t *index) {
+    const unsigned char *elems = list->elems;
+    size_t lo = 0, count = list->length;
+    while (count) {
+        size_t half = count / 2;
+        if (cmp(elems + (lo + half) * list->elemSize, elem, ctx) <= 0) {
+            lo += half + 1;
+            count -= half + 1;
+        } else {
+            count = half;
+        }
+    }
+    *index = lo;
+    return 0;
+}
+
+int arrayList_sort(ArrayList *list, ListElemCtxComparer cmp, void *ctx) {
+    memorySort(list->elems, list->length, list->elemSize, cmp, ctx);
     return 0;
 }
 
+int arrayList_sortStable(ArrayList *list, ListElemCtxComparer cmp, void *ctx) {
+    return memorySortStable(list->elems, list->length, list->elemSize, cmp, ctx);
+}
+
+int arrayList_parallelSort(ArrayList *list, ListElemCtxComparer cmp, void *ctx, size_t threads) {
+    return parallelSort(list, cmp, ctx, threads, 0);
+}
+
+int arrayList_parallelSortStable(ArrayList *list, ListElemCtxComparer cmp, void *ctx, size_t threads) {
+    return parallelSort(list, cmp, ctx, threads, 1);
+}
+
 int arrayList_fprint(const ArrayList *list, FILE *f, ListElemToString str, size_t sizeOfElem) {
     fprintf(f, "[");
     char s[sizeOfElem + 1];
@@ -202,62 +379,149 @@ int arrayList_fprint(const ArrayList *list, FILE *f, ListElemToString str, size_
 
 // 判断是否需要缩容
 static _Bool needReduce(ArrayList *list) {
-    return list->length > ExpandThreshold && (list->length * ReduceFactor <= list->capacity);
-}
-
-// 判断是否需要扩容
-static _Bool needExpand(ArrayList *list) {
-    return list->length >= list->capacity;
+    return !list->policy.neverShrink && list->length > ExpandThreshold &&
+           list->length * list->policy.shrinkFactor <= list->capacity;
 }
 
-// 扩容并插入元素
-static int expandAndInsert(ArrayList *list, size_t index, const void *elem) {
-    if (list->capacity < ExpandThreshold)
-        list->capacity += list->capacity + 1;
+// 扩容到至少能容纳minCapacity个元素
+static int expand(ArrayList *list, size_t minCapacity) {
+    size_t capacity;
+    if (!list->capacity && list->policy.initCapacity)
+        capacity = list->policy.initCapacity;
+    else if (list->capacity < ExpandThreshold)
+        capacity = list->capacity + list->capacity + 1;
     else
-        list->capacity = (size_t) (list->capacity * ExpandFactor);
-
-    void *newElems = malloc(list->elemSize * list->capacity);
-
-    // 复制前段
-    if (index && list->elems != NULL)
-        memcpy(newElems, list->elems, list->elemSize * index);
+        capacity = (size_t) (list->capacity * list->policy.growFactor);
+    if (capacity <= list->capacity)
+        capacity = list->capacity + 1;
+    if (capacity < minCapacity)
+        capacity = minCapacity;
+    return resize(list, capacity);
+}
 
-    // 复制后段
-    if ((list->length - index) && list->elems != NULL)
-        memcpy(pointerAdd(newElems, (index + 1) * list->elemSize),
-               pointerAdd(list->elems, index * list->elemSize),
-               list->elemSize * (list->length - index));
+// 缩容，保留的空闲区间使得再次扩容或缩容都需要元素个数成倍变化
+static void reduce(ArrayList *list) {
+    size_t capacity = (size_t) (list->length * list->policy.shrinkFactor / 2);
+    resize(list, capacity > list->length ? capacity : list->length);
+}
 
-    // 设置新元素
-    memcpy(pointerAdd(newElems, index * list->elemSize), elem, list->elemSize);
+// 重新分配容量，realloc在可能时原地扩展，大块内存由mremap完成而无需复制
+static int resize(ArrayList *list, size_t capacity) {
+    if (!capacity) {
+        free(list->elems);
+        list->elems = NULL;
+        list->capacity = 0;
+        return 0;
+    }
+    void *elems = realloc(list->elems, list->elemSize * capacity);
+    if (elems == NULL)
+        return 2;
+    list->elems = elems;
+    list->capacity = capacity;
+    return 0;
+}
 
-    free(list->elems);
-    list->elems = newElems;
-    list->length++;
+static int parallelSort(ArrayList *list, ListElemCtxComparer cmp, void *ctx, size_t threads, _Bool stable) {
+    size_t length = list->length;
+    if (!threads) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = online > 0 ? online : 1;
+    }
+    if (threads > length / (ParallelSortThreshold / 8))
+        threads = length / (ParallelSortThreshold / 8);
+    if (length < ParallelSortThreshold || threads < 2)
+        return stable ? arrayList_sortStable(list, cmp, ctx) : arrayList_sort(list, cmp, ctx);
+
+    ParallelSort job = {.src = list->elems, .size = list->elemSize, .cmp = cmp, .ctx = ctx, .stable = stable,
+                        .runs = threads};
+    job.dst = malloc(length * list->elemSize);
+    job.bounds = malloc((threads + 1) * sizeof(size_t));
+    job.tasks = malloc(threads * 2 * sizeof(MergeTask));
+    if (!job.dst || !job.bounds || !job.tasks) {
+        free(job.dst);
+        free(job.bounds);
+        free(job.tasks);
+        return 2;
+    }
+    for (size_t i = 0; i <= threads; i++)
+        job.bounds[i] = length / threads * i + (i < length % threads ? i : length % threads);
+    parallelRun(&job, sortRun, threads, threads);
+
+    // 每轮把相邻两段合并，合并后长度为total的一对按total*threads/length切成几个任务。
+    while (job.runs > 1) {
+        size_t tasks = 0;
+        for (size_t run = 0; run < job.runs; run += 2) {
+            size_t end = run + 2 < job.runs ? run + 2 : job.runs;
+            size_t total = job.bounds[end] - job.bounds[run];
+            size_t pieces = total * threads / length;
+            if (!pieces)
+                pieces = 1;
+            for (size_t i = 0; i < pieces; i++) {
+                job.tasks[tasks].run = run;
+                job.tasks[tasks].from = total / pieces * i + (i < total % pieces ? i : total % pieces);
+                job.tasks[tasks].to = total / pieces * (i + 1) + (i + 1 < total % pieces ? i + 1 : total % pieces);
+                tasks++;
+            }
+        }
+        parallelRun(&job, mergeRun, tasks, threads);
+        size_t runs = 0;
+        for (size_t run = 0; run < job.runs; run += 2)
+            job.bounds[++runs] = job.bounds[run + 2 < job.runs ? run + 2 : job.runs];
+        job.runs = runs;
+        unsigned char *tmp = job.src;
+        job.src = job.dst;
+        job.dst = tmp;
+    }
 
+    if (job.src != list->elems) {
+        job.dst = job.src;
+        job.src = list->elems;
+        for (size_t i = 0; i <= threads; i++)
+            job.bounds[i] = length / threads * i + (i < length % threads ? i : length % threads);
+        parallelRun(&job, copyRun, threads, threads);
+    }
+    free(job.dst);
+    free(job.bounds);
+    free(job.tasks);
     return 0;
 }
 
-// 缩容并弹出元素
-static int deallocAndPop(ArrayList *list, size_t index, void *elem) {
-    if (elem != NULL)
-        memcpy(elem, pointerAdd(list->elems, index * list->elemSize), list->elemSize);
+static void parallelRun(ParallelSort *job, ParallelSortStep *step, size_t tasks, size_t threads) {
+    SortStep range = {.job = job, .step = step};
+    ThreadPool *pool = threadPool_shared();
+    if (!pool || threadPool_parallelFor(pool, 0, tasks, 1, threads, sortSteps, &range))
+        sortSteps(0, tasks, &range);
+}
 
-    void *newElems = malloc(list->elemSize * (size_t) (list->length * ExpandFactor));
+static void sortSteps(size_t from, size_t to, void *ctx) {
+    SortStep *range = ctx;
+    for (size_t task = from; task < to; task++)
+        range->step(range->job, task);
+}
 
-    // 复制前段
-    if (index)
-        memcpy(newElems, list->elems, list->elemSize * index);
+static void sortRun(ParallelSort *job, size_t task) {
+    size_t from = job->bounds[task], count = job->bounds[task + 1] - from;
+    if (job->stable)
+        memorySortStableWithBuffer(job->src + from * job->size, count, job->size, job->cmp, job->ctx,
+                                   job->dst + from * job->size);
+    else
+        memorySort(job->src + from * job->size, count, job->size, job->cmp, job->ctx);
+}
 
-    // 复制后段
-    if (list->length - index)
-        memcpy(pointerAdd(newElems, (index + 1) * list->elemSize),
-               pointerAdd(list->elems, index * list->elemSize),
-               list->elemSize * (list->length - index));
+static void mergeRun(ParallelSort *job, size_t task) {
+    MergeTask *merge = job->tasks + task;
+    size_t size = job->size, base = job->bounds[merge->run];
+    size_t mid = job->bounds[merge->run + 1];
+    size_t end = merge->run + 2 <= job->runs ? job->bounds[merge->run + 2] : mid;
+    const unsigned char *a = job->src + base * size, *b = job->src + mid * size;
+    size_t na = mid - base, nb = end - mid;
+    size_t i0 = memoryMergeSplit(a, na, b, nb, merge->from, size, job->cmp, job->ctx);
+    size_t i1 = memoryMergeSplit(a, na, b, nb, merge->to, size, job->cmp, job->ctx);
+    memoryMerge(a + i0 * size, i1 - i0, b + (merge->from - i0) * size, merge->to - i1 - (merge->from - i0),
+                job->dst + (base + merge->from) * size, size, job->cmp, job->ctx);
+}
 
-    free(list->elems);
-    list->elems = newElems;
-    list->length--;
-    return 0;
+static void copyRun(ParallelSort *job, size_t task) {
+    size_t from = job->bounds[task], count = job->bounds[task + 1] - from;
+    memcpy(job->src + from * job->size, job->dst + from * job->size, count * job->size);
 }
@@ -14,13 +14,21 @@
 #define CLIB_ARRAY_LIST_H
 
 #include <stdlib.h>
+#include <string.h>
 
 #include "list.h"
 
+// 扩容阈值，容量小于该值时成倍扩容。
+#define CLIB_ARRAY_LIST_EXPAND_THRESHOLD 256
+
+// 默认容量策略。
+#define CLIB_ARRAY_LIST_DEFAULT_POLICY {.initCapacity = 0, .growFactor = 1.25, .shrinkFactor = 4, .neverShrink = 0}
+
 // 顺序线性表。
 typedef struct {
     size_t length, capacity, elemSize;
     void *elems;
+    ListGrowthPolicy policy;
 } ArrayList;
 
 // 新建顺序表。
@@ -29,6 +37,13 @@ typedef struct {
 // 空间复杂度：O(1)
 ArrayList *arrayList_alloc(size_t elemSize);
 
+// 按容量策略新建顺序表。
+// elemSize：每个元素占用的字节大小。
+// policy：容量策略，NULL表示默认策略。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+ArrayList *arrayList_allocWithPolicy(size_t elemSize, const ListGrowthPolicy *policy);
+
 // 销毁顺序表。
 // list：顺序表。
 // 时间复杂度：O(1)
@@ -57,6 +72,7 @@ int arrayList_get(const ArrayList *list, size_t index, void *elem);
 // 时间复杂度：O(1)
 // 空间复杂度：O(1)
 // 返回1: 越界。
+// 返回2: 内存不足。
 int arrayList_insert(ArrayList *list, size_t index, const void *elem);
 
 // 删除顺序表中一个元素。
@@ -77,6 +93,19 @@ int arrayList_del(ArrayList *list, size_t index);
 // 返回1: 未找到。
 int arrayList_locate(const ArrayList *list, ListElemComparer cmp, const void *elem, size_t *index);
 
+// 按字节查找元素在顺序表中的位置，不调用比较函数。
+// 比较每个元素offset处的keySize个字节，4、8、16字节的元素整体作为键时按运行时检测到的指令集以SIMD比较。
+// 浮点数按位比较，+0.0与-0.0不等，位模式相同的NaN相等。
+// list：顺序表。
+// offset：键在元素中的字节偏移。
+// key：要寻找的键。
+// keySize：键的字节大小。
+// index：元素位置塞入index中。
+// 时间复杂度：O(n)
+// 空间复杂度：O(1)
+// 返回1: 未找到，或键超出了元素范围。
+int arrayList_locateKey(const ArrayList *list, size_t offset, const void *key, size_t keySize, size_t *index);
+
 // 遍历顺序表。
 // list：顺序表。
 // visit：遍历函数。
@@ -84,6 +113,26 @@ int arrayList_locate(const ArrayList *list, ListElemComparer cmp, const void *el
 // 空间复杂度：O(1)
 int arrayList_travel(const ArrayList *list, ListElemVisitor visit);
 
+// 带上下文查找元素在顺序表中的位置。
+// list：顺序表。
+// cmp：元素比较函数。
+// elem：要寻找的元素。
+// ctx：传给比较函数的上下文。
+// index：元素位置塞入index中。
+// 时间复杂度：O(n)
+// 空间复杂度：O(1)
+// 返回1: 未找到。
+int arrayList_locateCtx(const ArrayList *list, ListElemCtxComparer cmp, const void *elem, void *ctx, size_t *index);
+
+// 带上下文遍历顺序表，遍历函数返回非0时停止。
+// list：顺序表。
+// visit：遍历函数。
+// ctx：传给遍历函数的上下文。
+// 时间复杂度：O(n)
+// 空间复杂度：O(1)
+// 返回visit的非0返回值: 遍历提前结束。
+int arrayList_travelCtx(const ArrayList *list, ListElemCtxVisitor visit, void *ctx);
+
 // 清除顺序表中所有元素。
 // list：顺序表。
 // 时间复杂度：O(1)
@@ -146,6 +195,135 @@ int arrayList_getDel(ArrayList *list, size_t index, void *elem);
 // 返回1: 越界。
 int arrayList_getSet(ArrayList *list, size_t index, void *elem);
 
+// 向顺序表中插入连续多个元素。
+// list：顺序表。
+// index：插入第一个元素的位置。
+// elems：被插入的元素数组。
+// count：元素个数。
+// 时间复杂度：O(n)
+// 空间复杂度：O(1)
+// 返回1: 越界。
+// 返回2: 内存不足。
+int arrayList_insertRange(ArrayList *list, size_t index, const void *elems, size_t count);
+
+// 删除顺序表中连续多个元素。
+// list：顺序表。
+// index：第一个元素所在位置。
+// count：元素个数。
+// 时间复杂度：O(n)
+// 空间复杂度：O(1)
+// 返回1: 越界。
+int arrayList_delRange(ArrayList *list, size_t index, size_t count);
+
+// 在顺序表中的最右边位置添加多个元素。
+// list：顺序表。
+// elems：被添加的元素数组。
+// count：元素个数。
+// 时间复杂度：O(count)
+// 空间复杂度：O(1)
+int arrayList_rpushN(ArrayList *list, const void *elems, size_t count);
+
+// 获取顺序表中连续多个元素。
+// list：顺序表。
+// index：第一个元素所在位置。
+// count：元素个数。
+// elems：元素值塞入elems数组中。
+// 时间复杂度：O(count)
+// 空间复杂度：O(1)
+// 返回1: 越界。
+int arrayList_getRange(const ArrayList *list, size_t index, size_t count, void *elems);
+
+// 预留顺序表容量，之后插入元素直到容量用尽都不再重新分配内存。
+// list：顺序表。
+// capacity：至少能容纳的元素个数。
+// 时间复杂度：O(n)
+// 空间复杂度：O(n)
+// 返回2: 内存不足。
+int arrayList_reserve(ArrayList *list, size_t capacity);
+
+// 将顺序表容量缩减到元素个数。
+// list：顺序表。
+// 时间复杂度：O(n)
+// 空间复杂度：O(1)
+// 返回2: 内存不足，容量不变。
+int arrayList_shrinkToFit(ArrayList *list);
+
+// 获取顺序表中元素的存储地址，可原地读写元素，插入或删除元素后地址失效。
+// list：顺序表。
+// index：元素所在位置。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+// 返回NULL: 越界。
+void *arrayList_at(const ArrayList *list, size_t index);
+
+// 获取顺序表中连续多个元素的视图，插入或删除元素后视图失效。
+// list：顺序表。
+// index：第一个元素所在位置。
+// count：元素个数。
+// span：视图塞入span中。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+// 返回1: 越界。
+int arrayList_span(const ArrayList *list, size_t index, size_t count, ListSpan *span);
+
+// 在按cmp升序排列的顺序表中二分查找第一个不小于elem的元素。
+// list：顺序表，须已按cmp升序排列。
+// cmp：元素比较函数。
+// elem：要比较的元素。
+// ctx：传给比较函数的上下文。
+// index：将被设置为该元素的位置，都小于elem时为元素个数。
+// 时间复杂度：O(log(n))
+// 空间复杂度：O(1)
+int arrayList_lowerBound(const ArrayList *list, ListElemCtxComparer cmp, const void *elem, void *ctx, size_t *index);
+
+// 在按cmp升序排列的顺序表中二分查找第一个大于elem的元素。
+// list：顺序表，须已按cmp升序排列。
+// cmp：元素比较函数。
+// elem：要比较的元素。
+// ctx：传给比较函数的上下文。
+// index：将被设置为该元素的位置，都不大于elem时为元素个数。
+// 时间复杂度：O(log(n))
+// 空间复杂度：O(1)
+int arrayList_upperBound(const ArrayList *list, ListElemCtxComparer cmp, const void *elem, void *ctx, size_t *index);
+
+// 按比较函数升序排列顺序表，不保证相等元素的相对顺序。
+// list：顺序表。
+// cmp：元素比较函数。
+// ctx：传给比较函数的上下文。
+// 时间复杂度：O(n*log(n))，内省排序
+// 空间复杂度：O(log(n))
+int arrayList_sort(ArrayList *list, ListElemCtxComparer cmp, void *ctx);
+
+// 按比较函数升序排列顺序表，相等元素保持原有顺序。
+// list：顺序表。
+// cmp：元素比较函数。
+// ctx：传给比较函数的上下文。
+// 时间复杂度：O(n*log(n))，归并排序
+// 空间复杂度：O(n)
+// 返回2: 内存不足。
+int arrayList_sortStable(ArrayList *list, ListElemCtxComparer cmp, void *ctx);
+
+// 多线程排序顺序表，不保证相等元素的相对顺序。
+// 各线程先排序一段，再逐轮两两合并，每轮合并按输出位置切分给全部线程。元素较少或只有一个线程时同arrayList_sort。
+// list：顺序表。
+// cmp：元素比较函数，会被多个线程同时调用。
+// ctx：传给比较函数的上下文。
+// threads：线程数，0表示在线CPU个数。
+// 时间复杂度：O(n*log(n)/t + n*log(t)/t)，t为线程数
+// 空间复杂度：O(n)
+// 返回2: 内存不足。
+int arrayList_parallelSort(ArrayList *list, ListElemCtxComparer cmp, void *ctx, size_t threads);
+
+// 多线程稳定排序顺序表，结果与arrayList_sortStable相同，与线程数无关。
+// list：顺序表。
+// cmp：元素比较函数，会被多个线程同时调用。
+// ctx：传给比较函数的上下文。
+// threads：线程数，0表示在线CPU个数。
+// 时间复杂度：O(n*log(n)/t + n*log(t)/t)，t为线程数
+// 空间复杂度：O(n)
+// 返回2: 内存不足。
+int arrayList_parallelSortStable(ArrayList *list, ListElemCtxComparer cmp, void *ctx, size_t threads);
+
 // 打印顺序表中的元素。
 // list：顺序表。
 // f：打印输出对象。
@@ -155,4 +333,218 @@ int arrayList_getSet(ArrayList *list, size_t index, void *elem);
 // 空间复杂度：O(1)
 int arrayList_fprint(const ArrayList *list, FILE *f, ListElemToString str, size_t sizeOfElem);
 
+// 生成元素类型为T的顺序表类型Name及其static inline操作函数，元素大小是编译期常量，存取、移动元素可被编译器内联和向量化。
+// 函数名为Name_加上同名arrayList_*函数的名字，参数与返回值相同，只是元素指针为T *，alloc无需元素大小，at返回T *。
+// 提供alloc、allocWithPolicy、free、len、at、get、set、getSet、insert、insertRange、rpush、rpushN、lpush、
+// del、delRange、getDel、rpop、lpop、getRange、locate、travel、clear、reserve、shrinkToFit，容量策略同arrayList。
+// 同时定义元素类型Name_Elem，使用时以分号结尾，例如：CLIB_ARRAY_LIST_DEFINE(IntList, int);
+#define CLIB_ARRAY_LIST_DEFINE(Name, T)                                                                              \
+    typedef struct {                                                                                                 \
+        size_t length, capacity;                                                                                     \
+        T *elems;                                                                                                    \
+        ListGrowthPolicy policy;                                                                                     \
+    } Name;                                                                                                          \
+                                                                                                                     \
+    static inline int Name##_resize(Name *list, size_t capacity) {                                                   \
+        if (!capacity) {                                                                                             \
+            free(list->elems);                                                                                       \
+            list->elems = NULL;                                                                                      \
+            list->capacity = 0;                                                                                      \
+            return 0;                                                                                                \
+        }                                                                                                            \
+        T *elems = realloc(list->elems, sizeof(T) * capacity);                                                       \
+        if (elems == NULL)                                                                                           \
+            return 2;                                                                                                \
+        list->elems = elems;                                                                                         \
+        list->capacity = capacity;                                                                                   \
+        return 0;                                                                                                    \
+    }                                                                                                                \
+                                                                                                                     \
+    static inline int Name##_expand(Name *list, size_t minCapacity) {                                                \
+        size_t capacity;                                                                                             \
+        if (!list->capacity && list->policy.initCapacity)                                                            \
+            capacity = list->policy.initCapacity;                                                                    \
+        else if (list->capacity < CLIB_ARRAY_LIST_EXPAND_THRESHOLD)                                                  \
+            capacity = list->capacity + list->capacity + 1;                                                          \
+        else                                                                                                         \
+            capacity = (size_t) (list->capacity * list->policy.growFactor);                                          \
+        if (capacity <= list->capacity)                                                                              \
+            capacity = list->capacity + 1;                                                                           \
+        if (capacity < minCapacity)                                                                                  \
+            capacity = minCapacity;                                                                                  \
+        return Name##_resize(list, capacity);                                                                        \
+    }                                                                                                                \
+                                                                                                                     \
+    static inline void Name##_reduce(Name *list) {                                                                   \
+        if (list->policy.neverShrink || list->length <= CLIB_ARRAY_LIST_EXPAND_THRESHOLD ||                          \
+            list->length * list->policy.shrinkFactor > list->capacity)                                               \
+            return;                                                                                                  \
+        size_t capacity = (size_t) (list->length * list->policy.shrinkFactor / 2);                                   \
+        Name##_resize(list, capacity > list->length ? capacity : list->length);                                      \
+    }                                                                                                                \
+                                                                                                                     \
+    static inline Name *Name##_allocWithPolicy(const ListGrowthPolicy *policy) {                                     \
+        Name *list = malloc(sizeof(Name));                                                                           \
+        if (list == NULL)                                                                                            \
+            return NULL;                                                                                             \
+        list->length = list->capacity = 0;                                                                           \
+        list->elems = NULL;                                                                                          \
+        list->policy = policy ? *policy : (ListGrowthPolicy) CLIB_ARRAY_LIST_DEFAULT_POLICY;                         \
+        return list;                                                                                                 \
+    }                                                                                                                \
+                                                                                                                     \
+    static inline Name *Name##_alloc(void) {                                                                         \
+        return Name##_allocWithPolicy(NULL);                                                                         \
+    }                                                                                                                \
+                                                                                                                     \
+    static inline void Name##_free(Name *list) {                                                                     \
+        free(list->elems);                                                                                           \
+        free(list);                                                                                                  \
+    }                                                                                                                \
+                                                                                                                     \
+    static inline size_t Name##_len(const Name *list) {                                                              \
+        return list->length;                                                                                         \
+    }                                                                                                                \
+                                                                                                                     \
+    static inline T *Name##_at(const Name *list, size_t index) {                                                     \
+        return index < list->length ? list->elems + index : NULL;                                                    \
+    }                                                                                                                \
+                                                                                                                     \
+    static inline int Name##_get(const Name *list, size_t index, T *elem) {                                          \
+        if (index >= list->length)                                                                                   \
+            return 1;                                                                                                \
+        *elem = list->elems[index];                                                                                  \
+        return 0;                                                                                                    \
+    }                                                                                                                \
+                                                                                                                     \
+    static inline int Name##_set(Name *list, size_t index, const T *elem) {                                          \
+        if (index >= list->length)                                                                                   \
+            return 1;                                                                                                \
+        list->elems[index] = *elem;                                                                                  \
+        return 0;                                                                                                    \
+    }                                                                                                                \
+                                                                                                                     \
+    static inline int Name##_getSet(Name *list, size_t index, T *elem) {                                             \
+        if (index >= list->length)                                                                                   \
+            return 1;                                                                                                \
+        T tmp = list->elems[index];                                                                                  \
+        list->elems[index] = *elem;                                                                                  \
+        *elem = tmp;                                                                                                 \
+        return 0;                                                                                                    \
+    }                                                                                                                \
+                                                                                                                     \
+    static inline int Name##_insertRange(Name *list, size_t index, const T *elems, size_t count) {                   \
+        if (index > list->length)                                                                                    \
+            return 1;                                                                                                \
+        if (!count)                                                                                                  \
+            return 0;                                                                                                \
+        if (list->length + count > list->capacity && Name##_expand(list, list->length + count))                      \
+            return 2;                                                                                                \
+        if (list->length - index)                                                                                    \
+            memmove(list->elems + index + count, list->elems + index, sizeof(T) * (list->length - index));           \
+        memcpy(list->elems + index, elems, sizeof(T) * count);                                                       \
+        list->length += count;                                                                                       \
+        return 0;                                                                                                    \
+    }                                                                                                                \
+                                                                                                                     \
+    static inline int Name##_insert(Name *list, size_t index, const T *elem) {                                       \
+        return Name##_insertRange(list, index, elem, 1);                                                             \
+    }                                                                                                                \
+                                                                                                                     \
+    static inline int Name##_rpush(Name *list, const T *elem) {                                                      \
+        if (list->length == list->capacity && Name##_expand(list, list->length + 1))                                 \
+            return 2;                                                                                                \
+        list->elems[list->length++] = *elem;                                                                         \
+        return 0;                                                                                                    \
+    }                                                                                                                \
+                                                                                                                     \
+    static inline int Name##_rpushN(Name *list, const T *elems, size_t count) {                                      \
+        return Name##_insertRange(list, list->length, elems, count);                                                 \
+    }                                                                                                                \
+                                                                                                                     \
+    static inline int Name##_lpush(Name *list, const T *elem) {                                                      \
+        return Name##_insertRange(list, 0, elem, 1);                                                                 \
+    }                                                                                                                \
+                                                                                                                     \
+    static inline int Name##_delRange(Name *list, size_t index, size_t count) {                                      \
+        if (index > list->length || count > list->length - index)                                                    \
+            return 1;                                                                                                \
+        if (!count)                                                                                                  \
+            return 0;                                                                                                \
+        if (list->length - index - count)                                                                            \
+            memmove(list->elems + index, list->elems + index + count,                                                \
+                    sizeof(T) * (list->length - index - count));                                                     \
+        list->length -= count;                                                                                       \
+        Name##_reduce(list);                                                                                         \
+        return 0;                                                                                                    \
+    }                                                                                                                \
+                                                                                                                     \
+    static inline int Name##_del(Name *list, size_t index) {                                                         \
+        return Name##_delRange(list, index, 1);                                                                      \
+    }                                                                                                                \
+                                                                                                                     \
+    static inline int Name##_getDel(Name *list, size_t index, T *elem) {                                             \
+        if (index >= list->length)                                                                                   \
+            return 1;                                                                                                \
+        *elem = list->elems[index];                                                                                  \
+        return Name##_delRange(list, index, 1);                                                                      \
+    }                                                                                                                \
+                                                                                                                     \
+    static inline int Name##_rpop(Name *list, T *elem) {                                                             \
+        if (!list->length)                                                                                           \
+            return 1;                                                                                                \
+        *elem = list->elems[--list->length];                                                                         \
+        Name##_reduce(list);                                                                                         \
+        return 0;                                                                                                    \
+    }                                                                                                                \
+                                                                                                                     \
+    static inline int Name##_lpop(Name *list, T *elem) {                                                             \
+        return Name##_getDel(list, 0, elem);                                                                         \
+    }                                                                                                                \
+                                                                                                                     \
+    static inline int Name##_getRange(const Name *list, size_t index, size_t count, T *elems) {                      \
+        if (index > list->length || count > list->length - index)                                                    \
+            return 1;                                                                                                \
+        if (count)                                                                                                   \
+            memcpy(elems, list->elems + index, sizeof(T) * count);                                                   \
+        return 0;                                                                                                    \
+    }                                                                                                                \
+                                                                                                                     \
+    static inline int Name##_locate(const Name *list, ListElemComparer cmp, const T *elem, size_t *index) {          \
+        for (size_t i = 0; i < list->length; i++) {                                                                  \
+            if (!cmp(list->elems + i, elem)) {                                                                       \
+                *index = i;                                                                                          \
+                return 0;                                                                                            \
+            }                                                                                                        \
+        }                                                                                                            \
+        return 1;                                                                                                    \
+    }                                                                                                                \
+                                                                                                                     \
+    static inline int Name##_travel(const Name *list, ListElemVisitor visit) {                                       \
+        for (size_t i = 0; i < list->length; i++)                                                                    \
+            visit(list->elems + i);                                                                                  \
+        return 0;                                                                                                    \
+    }                                                                                                                \
+                                                                                                                     \
+    static inline int Name##_clear(Name *list) {                                                                     \
+        free(list->elems);                                                                                           \
+        list->elems = NULL;                                                                                          \
+        list->length = list->capacity = 0;                                                                           \
+        return 0;                                                                                                    \
+    }                                                                                                                \
+                                                                                                                     \
+    static inline int Name##_reserve(Name *list, size_t capacity) {                                                  \
+        if (capacity <= list->capacity)                                                                              \
+            return 0;                                                                                                \
+        return Name##_resize(list, capacity);                                                                        \
+    }                                                                                                                \
+                                                                                                                     \
+    static inline int Name##_shrinkToFit(Name *list) {                                                               \
+        if (list->length < list->capacity)                                                                           \
+            return Name##_resize(list, list->length);                                                                \
+        return 0;                                                                                                    \
+    }                                                                                                                \
+                                                                                                                     \
+    typedef T Name##_Elem
+
 #endif // CLIB_ARRAY_LIST_H
@@ -19,12 +19,18 @@
 
 #define TEST_LENGTH 500000
 
+CLIB_ARRAY_LIST_DEFINE(IntList, int);
+
 static int intCmp(const void *o1, const void *o2);
 
 static void intVisitor(void *p);
 
+static int ctxIntCmp(const void *o1, const void *o2, void *ctx);
+
 // static size_t intToString(void *elem, char *s);
 
+static void testTyped(void);
+
 int main(void) {
     ArrayList *list = arrayList_alloc(sizeof(int));
     assert(list);
@@ -101,6 +107,250 @@ int main(void) {
 
     assert(!arrayList_clear(list));
 
+    int elems[] = {1, 2, 3, 4, 5};
+    int expect[] = {1, 2, 1, 2, 3, 3, 4, 5};
+    int range[8];
+    assert(!arrayList_rpushN(list, elems, 5));
+    assert(!arrayList_insertRange(list, 2, elems, 3));
+    assert(arrayList_len(list) == 8);
+    assert(!arrayList_getRange(list, 0, 8, range));
+    assert(!memcmp(range, expect, sizeof(expect)));
+    assert(arrayList_getRange(list, 4, 5, range) == 1);
+    assert(!arrayList_delRange(list, 1, 4));
+    assert(!arrayList_getRange(list, 0, 4, range));
+    assert(range[0] == 1 && range[1] == 3 && range[2] == 4 && range[3] == 5);
+    assert(arrayList_delRange(list, 2, 3) == 1);
+    assert(arrayList_insertRange(list, 5, elems, 1) == 1);
+
+    int *batch = malloc(sizeof(int) * TEST_LENGTH);
+    for (int i = 0; i < TEST_LENGTH; i++)
+        batch[i] = i;
+    assert(!arrayList_insertRange(list, 2, batch, TEST_LENGTH));
+    assert(arrayList_len(list) == TEST_LENGTH + 4);
+    assert(!arrayList_get(list, TEST_LENGTH + 1, &elem) && elem == TEST_LENGTH - 1);
+    assert(!arrayList_get(list, TEST_LENGTH + 2, &elem) && elem == 4);
+    assert(!arrayList_delRange(list, 0, TEST_LENGTH));
+    assert(!arrayList_getRange(list, 0, 4, range));
+    assert(range[0] == TEST_LENGTH - 2 && range[1] == TEST_LENGTH - 1 && range[2] == 4 && range[3] == 5);
+    free(batch);
+
+    assert(!arrayList_shrinkToFit(list));
+    assert(list->capacity == 4);
+    assert(!arrayList_reserve(list, TEST_LENGTH));
+    assert(list->capacity == TEST_LENGTH);
+    void *elemsBefore = list->elems;
+    for (int i = 4; i < TEST_LENGTH; i++)
+        assert(!arrayList_rpush(list, &i));
+    assert(list->elems == elemsBefore && list->capacity == TEST_LENGTH);
+    assert(!arrayList_delRange(list, 4, TEST_LENGTH / 2));
+    assert(list->capacity == TEST_LENGTH);
+    assert(!arrayList_delRange(list, 4, TEST_LENGTH / 4));
+    assert(list->capacity < TEST_LENGTH);
+    assert(!arrayList_delRange(list, 4, arrayList_len(list) - 8));
+    assert(!arrayList_shrinkToFit(list));
+    assert(list->capacity == 8 && arrayList_len(list) == 8);
+    assert(!arrayList_getRange(list, 4, 4, range));
+    assert(range[0] == TEST_LENGTH - 4 && range[3] == TEST_LENGTH - 1);
+
+    ListSpan span;
+    assert(!arrayList_span(list, 2, 3, &span));
+    assert(span.length == 3 && span.stride == sizeof(int));
+    assert(span.base == arrayList_at(list, 2));
+    *(int *) arrayList_at(list, 3) = -1;
+    assert(((int *) span.base)[1] == -1);
+    assert(arrayList_at(list, 8) == NULL);
+    assert(arrayList_span(list, 6, 3, &span) == 1);
+
+    arrayList_free(list);
+
+    char big[100], bigSwap[100];
+    memset(big, 'a', sizeof(big));
+    memset(bigSwap, 'b', sizeof(bigSwap));
+    list = arrayList_alloc(sizeof(big));
+    assert(!arrayList_rpush(list, big));
+    assert(!arrayList_getSet(list, 0, bigSwap));
+    assert(bigSwap[0] == 'a' && bigSwap[99] == 'a');
+    assert(((char *) arrayList_at(list, 0))[99] == 'b');
+    arrayList_free(list);
+
+    ListGrowthPolicy policy = {.initCapacity = 1000, .growFactor = 2, .shrinkFactor = 4, .neverShrink = 1};
+    list = arrayList_allocWithPolicy(sizeof(int), &policy);
+    assert(!arrayList_rpush(list, &elem));
+    assert(list->capacity == 1000);
+    for (int i = 0; i < 1000; i++)
+        assert(!arrayList_rpush(list, &i));
+    assert(list->capacity == 2000);
+    assert(!arrayList_delRange(list, 0, 1000));
+    assert(list->capacity == 2000);
+    arrayList_free(list);
+
+    // 排序：内省排序遇到逆序与大量重复元素，稳定排序按键分组后保持原有顺序。
+    int order = 1;
+    list = arrayList_alloc(sizeof(int));
+    for (int i = 100000; i > 0; i--)
+        assert(!arrayList_rpush(list, &i));
+    assert(!arrayList_sort(list, ctxIntCmp, &order));
+    for (int i = 0; i < 100000; i++)
+        assert(((int *) list->elems)[i] == i + 1);
+    for (int i = 0; i < 100000; i++)
+        ((int *) list->elems)[i] = rand() % 3;
+    assert(!arrayList_sort(list, ctxIntCmp, &order));
+    for (int i = 1; i < 100000; i++)
+        assert(((int *) list->elems)[i - 1] <= ((int *) list->elems)[i]);
+    arrayList_free(list);
+
+    list = arrayList_alloc(sizeof(int[2]));
+    for (int i = 0; i < 10000; i++)
+        assert(!arrayList_rpush(list, (int[2]) {rand() % 100, i}));
+    assert(!arrayList_sortStable(list, ctxIntCmp, &order));
+    for (int i = 1; i < 10000; i++) {
+        int *prev = arrayList_at(list, i - 1), *cur = arrayList_at(list, i);
+        assert(prev[0] < cur[0] || (prev[0] == cur[0] && prev[1] < cur[1]));
+    }
+    arrayList_free(list);
+
+    // 有序表二分查找上下界。
+    list = arrayList_alloc(sizeof(int));
+    for (int i = 0; i < 100; i++) {
+        elem = i / 3 * 2;
+        assert(!arrayList_rpush(list, &elem));
+    }
+    for (elem = -1; elem <= 68; elem++) {
+        assert(!arrayList_lowerBound(list, ctxIntCmp, &elem, &order, &index));
+        assert(index == (elem < 0 ? 0 : elem > 66 ? 100 : (elem + 1) / 2 * 3));
+        assert(!arrayList_upperBound(list, ctxIntCmp, &elem, &order, &index));
+        assert(index == (elem < 0 ? 0 : elem >= 66 ? 100 : elem / 2 * 3 + 3));
+    }
+    arrayList_free(list);
+
+    // 按字节定位：每个位置的键都能找到，含向量比较的尾部；重复键返回首个位置。
+    for (size_t keySize = 4; keySize <= 16; keySize *= 2) {
+        list = arrayList_alloc(keySize);
+        unsigned char key[16] = {0};
+        for (int i = 0; i < 101; i++) {
+            memcpy(key + keySize - sizeof(i), &i, sizeof(i));
+            assert(!arrayList_rpush(list, key));
+        }
+        assert(!arrayList_rpush(list, key));
+        for (int i = 0; i < 101; i++) {
+            memcpy(key + keySize - sizeof(i), &i, sizeof(i));
+            assert(!arrayList_locateKey(list, 0, key, keySize, &index) && index == i);
+            assert(!arrayList_locateKey(list, keySize - sizeof(i), &i, sizeof(i), &index) && index == i);
+        }
+        elem = 101;
+        memcpy(key + keySize - sizeof(elem), &elem, sizeof(elem));
+        assert(arrayList_locateKey(list, 0, key, keySize, &index) == 1);
+        assert(arrayList_locateKey(list, 1, key, keySize, &index) == 1);
+        arrayList_free(list);
+    }
+
+    // 多线程排序：稳定排序与单线程结果逐字节相同，线程数不整除长度时各段边界正确。
+    const size_t threads[] = {0, 1, 2, 3, 7, 64};
+    for (size_t length = 1000; length <= 300001; length += 149500) {
+        ArrayList *base = arrayList_alloc(sizeof(int[2]));
+        for (int i = 0; i < length; i++)
+            assert(!arrayList_rpush(base, (int[2]) {rand() % 1000, i}));
+        ArrayList *expect = arrayList_alloc(sizeof(int[2]));
+        assert(!arrayList_rpushN(expect, base->elems, length));
+        assert(!arrayList_sortStable(expect, ctxIntCmp, &order));
+        for (size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); t++) {
+            list = arrayList_alloc(sizeof(int[2]));
+            assert(!arrayList_rpushN(list, base->elems, length));
+            assert(!arrayList_parallelSortStable(list, ctxIntCmp, &order, threads[t]));
+            assert(!memcmp(list->elems, expect->elems, length * sizeof(int[2])));
+            arrayList_clear(list);
+            assert(!arrayList_rpushN(list, base->elems, length));
+            assert(!arrayList_parallelSort(list, ctxIntCmp, &order, threads[t]));
+            long long sum = 0;
+            for (size_t i = 0; i < length; i++) {
+                int *cur = arrayList_at(list, i);
+                assert(cur[0] == ((int *) expect->elems)[i * 2]);
+                sum += cur[1];
+            }
+            assert(sum == (long long) length * (length - 1) / 2);
+            arrayList_free(list);
+        }
+        arrayList_free(expect);
+        arrayList_free(base);
+    }
+
+    testTyped();
+}
+
+// 类型化顺序表与ArrayList执行相同的随机操作，元素、长度与容量始终一致。
+static void testTyped(void) {
+    ArrayList *list = arrayList_alloc(sizeof(int));
+    IntList *typed = IntList_alloc();
+    assert(typed && !IntList_len(typed) && IntList_at(typed, 0) == NULL);
+    int elem, got, range[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    for (int i = 0; i < 20000; i++) {
+        size_t len = arrayList_len(list), index = len ? rand() % len : 0;
+        elem = rand();
+        switch (rand() % (i < 10000 ? 8 : 12)) {
+            case 0:
+                assert(arrayList_rpush(list, &elem) == IntList_rpush(typed, &elem));
+                break;
+            case 1:
+                assert(arrayList_lpush(list, &elem) == IntList_lpush(typed, &elem));
+                break;
+            case 2:
+                assert(arrayList_insert(list, index, &elem) == IntList_insert(typed, index, &elem));
+                break;
+            case 3:
+                assert(arrayList_insertRange(list, index, range, 8) == IntList_insertRange(typed, index, range, 8));
+                break;
+            case 4:
+                assert(arrayList_set(list, index, &elem) == IntList_set(typed, index, &elem));
+                break;
+            case 5:
+                got = elem;
+                assert(arrayList_getSet(list, index, &elem) == IntList_getSet(typed, index, &got));
+                assert(got == elem);
+                break;
+            case 6:
+            case 7:
+                assert(arrayList_rpushN(list, range, 8) == IntList_rpushN(typed, range, 8));
+                break;
+            case 8:
+                assert(arrayList_rpop(list, &elem) == IntList_rpop(typed, &got));
+                assert(!len || got == elem);
+                break;
+            case 9:
+                assert(arrayList_lpop(list, &elem) == IntList_lpop(typed, &got));
+                assert(!len || got == elem);
+                break;
+            case 10:
+                assert(arrayList_getDel(list, index, &elem) == IntList_getDel(typed, index, &got));
+                assert(!len || got == elem);
+                break;
+            default:
+                assert(arrayList_delRange(list, index, len - index < 8 ? len - index : 8) ==
+                       IntList_delRange(typed, index, len - index < 8 ? len - index : 8));
+                break;
+        }
+        assert(list->length == typed->length && list->capacity == typed->capacity);
+    }
+    assert(!memcmp(list->elems, typed->elems, list->length * sizeof(int)));
+    for (size_t i = 0; i < typed->length; i++)
+        assert(!IntList_get(typed, i, &got) && got == *IntList_at(typed, i));
+    assert(IntList_get(typed, typed->length, &got) == 1);
+
+    size_t index;
+    elem = typed->elems[typed->length / 2];
+    assert(!IntList_locate(typed, intCmp, &elem, &index) && typed->elems[index] == elem);
+    int head[4];
+    assert(!IntList_getRange(typed, 0, 4, head) && !memcmp(head, typed->elems, sizeof(head)));
+    assert(!IntList_reserve(typed, typed->length + 100) && typed->capacity >= typed->length + 100);
+    assert(!IntList_shrinkToFit(typed) && !arrayList_shrinkToFit(list));
+
+    // 逐个弹出时与ArrayList同步缩容。
+    while (list->length) {
+        assert(!arrayList_rpop(list, &elem) && !IntList_rpop(typed, &got) && got == elem);
+        assert(list->length == typed->length && list->capacity == typed->capacity);
+    }
+    assert(IntList_rpop(typed, &got) == 1);
+    assert(!IntList_clear(typed) && !IntList_len(typed));
+    IntList_free(typed);
     arrayList_free(list);
 }
 
@@ -126,3 +376,8 @@ static void intVisitor(void *p) {
     strncpy(s, buf, len);
     return len;
 }*/
+
+static int ctxIntCmp(const void *o1, const void *o2, void *ctx) {
+    int n1 = *(const int *) o1, n2 = *(const int *) o2;
+    return ((n1 > n2) - (n1 < n2)) * *(int *) ctx;
+}
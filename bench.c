@@ -0,0 +1,550 @@
+/*
+ * Copyright (c) 2023 ivfzhou
+ * clib is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+
+// 基准测试，结果以CSV或JSON输出，用于跨版本对比性能。
+// 用法：bench [-f csv|json] [-n 最大长度] [-t 测试轮数]
+// 每个用例先预热并校准每轮操作次数，使一轮耗时不少于MinTrialSeconds，再重复测试多轮，
+// 输出每个操作耗时的中位数与P99（纳秒）。
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "circle_queue.h"
+#include "linked_queue.h"
+#include "list.h"
+#include "stack.h"
+#include "string.h"
+#include "thread_pool.h"
+
+// 一轮测试的最短耗时。
+const static double MinTrialSeconds = 1e-3;
+
+// 一轮测试的最多操作次数。
+const static size_t MaxOps = 1 << 16;
+
+// 元素与节点合计超过该字节数的用例将被跳过。
+const static size_t MaxFootprint = (size_t) 1 << 30;
+
+// 测试轮数上限。
+#define BENCH_MAX_TRIALS 101
+
+// 输出格式。
+typedef enum {
+    BenchFormat_Csv,
+    BenchFormat_Json
+} BenchFormat;
+
+// 测试负载，对state执行ops次操作并返回计时部分的耗时（秒）。
+typedef double BenchWorkload(void *state, size_t ops);
+
+// 线性表测试状态。
+typedef struct {
+    List *list;
+    size_t elemSize;
+    size_t length;
+    unsigned char *elem;
+    unsigned long long seed;
+} ListState;
+
+// 栈与队列测试状态。
+typedef struct {
+    void *container;
+    size_t elemSize;
+    unsigned char *elem;
+} QueueState;
+
+// 字符串测试状态。
+typedef struct {
+    String *text, *pattern;
+} StringState;
+
+// 线程池测试状态。
+typedef struct {
+    ThreadPool *pool;
+    size_t length;
+    atomic_size_t sink;
+} PoolState;
+
+static BenchFormat format = BenchFormat_Csv;
+
+static int trials = 11;
+
+static size_t maxLength = 10000000;
+
+static size_t resultCount;
+
+static const size_t lengths[] = {10, 1000, 100000, 10000000};
+
+static const size_t elemSizes[] = {4, 64, 256};
+
+static double now(void);
+
+static void run(const char *subject, const char *workload, size_t elemSize, size_t length, size_t unitsPerOp,
+                BenchWorkload *fn, void *state);
+
+static void report(const char *subject, const char *workload, size_t elemSize, size_t length, size_t ops,
+                   double median, double p99);
+
+static int doubleCmp(const void *o1, const void *o2);
+
+static int keyCmp(const void *o1, const void *o2);
+
+static void keyVisitor(void *elem);
+
+static size_t randomIndex(ListState *state, size_t bound);
+
+static void benchList(ListImplType type, const char *subject);
+
+static double listAppend(void *state, size_t ops);
+
+static double listPrepend(void *state, size_t ops);
+
+static double listInsertDelete(void *state, size_t ops);
+
+static double listGet(void *state, size_t ops);
+
+static double listLocate(void *state, size_t ops);
+
+static double listTravel(void *state, size_t ops);
+
+static void benchStack(void);
+
+static double stackPushPop(void *state, size_t ops);
+
+static void benchCircleQueue(void);
+
+static double circleQueueIntoExit(void *state, size_t ops);
+
+static void benchLinkedQueue(void);
+
+static double linkedQueueIntoExit(void *state, size_t ops);
+
+static void benchString(void);
+
+static double stringIndex(void *state, size_t ops);
+
+static void benchThreadPool(void);
+
+static double threadCreateJoin(void *state, size_t ops);
+
+static double poolAsyncJoin(void *state, size_t ops);
+
+static double poolSubmitWait(void *state, size_t ops);
+
+static double poolParallelFor(void *state, size_t ops);
+
+static void *emptyTask(void *arg);
+
+static void sumRange(size_t from, size_t to, void *ctx);
+
+int main(int argc, char *argv[]) {
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (!strcmp(argv[i], "-f"))
+            format = strcmp(argv[i + 1], "json") ? BenchFormat_Csv : BenchFormat_Json;
+        else if (!strcmp(argv[i], "-n"))
+            maxLength = strtoull(argv[i + 1], NULL, 10);
+        else if (!strcmp(argv[i], "-t"))
+            trials = atoi(argv[i + 1]);
+    }
+    if (trials < 1)
+        trials = 1;
+    if (trials > BENCH_MAX_TRIALS)
+        trials = BENCH_MAX_TRIALS;
+
+    if (format == BenchFormat_Csv)
+        printf("subject,workload,elem_size,length,ops,trials,median_ns,p99_ns\n");
+    else
+        printf("[");
+
+    benchList(ListImplType_Array, "list/array");
+    benchList(ListImplType_Linked, "list/linked");
+    benchList(ListImplType_DoubleLinked, "list/doubleLinked");
+    benchList(ListImplType_StaticLinked, "list/staticLinked");
+    benchList(ListImplType_CircleLinked, "list/circleLinked");
+    benchList(ListImplType_Deque, "list/deque");
+    benchList(ListImplType_SkipList, "list/skipList");
+    benchList(ListImplType_BTree, "list/btree");
+    benchList(ListImplType_Unrolled, "list/unrolled");
+    benchStack();
+    benchCircleQueue();
+    benchLinkedQueue();
+    benchString();
+    benchThreadPool();
+
+    if (format == BenchFormat_Json)
+        printf("\n]\n");
+    return 0;
+}
+
+// 每种元素大小与长度组合下的线性表负载。
+static void benchList(ListImplType type, const char *subject) {
+    for (size_t s = 0; s < sizeof(elemSizes) / sizeof(elemSizes[0]); s++) {
+        for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+            size_t elemSize = elemSizes[s], length = lengths[l];
+            if (length > maxLength || length * (elemSize + 48) > MaxFootprint)
+                continue;
+
+            ListState state = {
+                    .list = list_alloc(elemSize, type),
+                    .elemSize = elemSize,
+                    .length = length,
+                    .elem = calloc(1, elemSize),
+                    .seed = 88172645463325252ull,
+            };
+            // 经迭代器在尾部追加，单链表也无需每次从头查找尾节点。
+            ListIter iter;
+            list_reserve(state.list, length);
+            list_iterBegin(state.list, &iter);
+            for (unsigned key = 0; key < length; key++) {
+                memcpy(state.elem, &key, sizeof(key));
+                list_iterInsertBefore(&iter, state.elem);
+            }
+
+            run(subject, "append", elemSize, length, 1, listAppend, &state);
+            run(subject, "prepend", elemSize, length, 1, listPrepend, &state);
+            run(subject, "get", elemSize, length, 1, listGet, &state);
+            run(subject, "locate", elemSize, length, 1, listLocate, &state);
+            run(subject, "travel", elemSize, length, length, listTravel, &state);
+            run(subject, "insert_delete", elemSize, length, 1, listInsertDelete, &state);
+
+            list_free(state.list);
+            free(state.elem);
+        }
+    }
+}
+
+// 每次操作在尾部追加一个元素并弹出，保持长度不变。
+static double listAppend(void *state, size_t ops) {
+    ListState *s = state;
+    double begin = now();
+    for (size_t i = 0; i < ops; i++) {
+        list_rpush(s->list, s->elem);
+        list_rpop(s->list, s->elem);
+    }
+    return now() - begin;
+}
+
+// 每次操作在首部插入一个元素并弹出，保持长度不变。
+static double listPrepend(void *state, size_t ops) {
+    ListState *s = state;
+    double begin = now();
+    for (size_t i = 0; i < ops; i++) {
+        list_lpush(s->list, s->elem);
+        list_lpop(s->list, s->elem);
+    }
+    return now() - begin;
+}
+
+// 每次操作在随机位置插入一个元素并删除另一个随机位置的元素。
+static double listInsertDelete(void *state, size_t ops) {
+    ListState *s = state;
+    double begin = now();
+    for (size_t i = 0; i < ops; i++) {
+        list_insert(s->list, randomIndex(s, s->length + 1), s->elem);
+        list_del(s->list, randomIndex(s, s->length + 1));
+    }
+    return now() - begin;
+}
+
+// 随机位置读取元素。
+static double listGet(void *state, size_t ops) {
+    ListState *s = state;
+    double begin = now();
+    for (size_t i = 0; i < ops; i++)
+        list_get(s->list, randomIndex(s, s->length), s->elem);
+    return now() - begin;
+}
+
+// 按键查找随机位置上的元素。
+static double listLocate(void *state, size_t ops) {
+    ListState *s = state;
+    size_t index;
+    double begin = now();
+    for (size_t i = 0; i < ops; i++) {
+        unsigned key = (unsigned) randomIndex(s, s->length);
+        list_locate(s->list, keyCmp, &key, &index);
+    }
+    return now() - begin;
+}
+
+// 完整遍历ops次，结果按每个元素计。
+static double listTravel(void *state, size_t ops) {
+    ListState *s = state;
+    double begin = now();
+    for (size_t i = 0; i < ops; i++)
+        list_travel(s->list, keyVisitor);
+    return now() - begin;
+}
+
+// 栈中保持length个元素，每次操作压入一个元素并弹出。
+static void benchStack(void) {
+    for (size_t s = 0; s < sizeof(elemSizes) / sizeof(elemSizes[0]); s++) {
+        for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+            size_t elemSize = elemSizes[s], length = lengths[l];
+            if (length > maxLength || length * elemSize > MaxFootprint)
+                continue;
+            QueueState state = {
+                    .container = stack_alloc(elemSize, length + 1),
+                    .elemSize = elemSize,
+                    .elem = calloc(1, elemSize),
+            };
+            for (size_t i = 0; i < length; i++)
+                stack_push(state.container, state.elem);
+            run("stack", "push_pop", elemSize, length, 1, stackPushPop, &state);
+            stack_free(state.container);
+            free(state.elem);
+        }
+    }
+}
+
+static double stackPushPop(void *state, size_t ops) {
+    QueueState *s = state;
+    double begin = now();
+    for (size_t i = 0; i < ops; i++) {
+        stack_push(s->container, s->elem);
+        stack_pop(s->container, s->elem);
+    }
+    return now() - begin;
+}
+
+// 环形队列中保持length个元素，每次操作入队一个元素并出队。
+static void benchCircleQueue(void) {
+    for (size_t s = 0; s < sizeof(elemSizes) / sizeof(elemSizes[0]); s++) {
+        for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+            size_t elemSize = elemSizes[s], length = lengths[l];
+            if (length > maxLength || length * elemSize > MaxFootprint)
+                continue;
+            QueueState state = {
+                    .container = circleQueue_alloc(elemSize, length + 1),
+                    .elemSize = elemSize,
+                    .elem = calloc(1, elemSize),
+            };
+            for (size_t i = 0; i < length; i++)
+                circleQueue_into(state.container, state.elem);
+            run("circleQueue", "into_exit", elemSize, length, 1, circleQueueIntoExit, &state);
+            circleQueue_free(state.container);
+            free(state.elem);
+        }
+    }
+}
+
+static double circleQueueIntoExit(void *state, size_t ops) {
+    QueueState *s = state;
+    double begin = now();
+    for (size_t i = 0; i < ops; i++) {
+        circleQueue_into(s->container, s->elem);
+        circleQueue_exit(s->container, s->elem);
+    }
+    return now() - begin;
+}
+
+// 链式队列中保持length个元素，每次操作入队一个元素并出队。
+static void benchLinkedQueue(void) {
+    for (size_t s = 0; s < sizeof(elemSizes) / sizeof(elemSizes[0]); s++) {
+        for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+            size_t elemSize = elemSizes[s], length = lengths[l];
+            if (length > maxLength || length * (elemSize + 48) > MaxFootprint)
+                continue;
+            QueueState state = {
+                    .container = linkedQueue_alloc(elemSize),
+                    .elemSize = elemSize,
+                    .elem = calloc(1, elemSize),
+            };
+            for (size_t i = 0; i < length; i++)
+                linkedQueue_into(state.container, state.elem);
+            run("linkedQueue", "into_exit", elemSize, length, 1, linkedQueueIntoExit, &state);
+            linkedQueue_free(state.container);
+            free(state.elem);
+        }
+    }
+}
+
+static double linkedQueueIntoExit(void *state, size_t ops) {
+    QueueState *s = state;
+    double begin = now();
+    for (size_t i = 0; i < ops; i++) {
+        linkedQueue_into(s->container, s->elem);
+        linkedQueue_exit(s->container, s->elem);
+    }
+    return now() - begin;
+}
+
+// 在length个字符的文本中查找位于末尾的模式串，结果按每个文本字符计。
+static void benchString(void) {
+    const char *pattern = "abaabaabbabaabac"; // 末字符不在随机文本中出现，只匹配末尾
+    for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+        size_t length = lengths[l];
+        if (length > maxLength || length < strlen(pattern))
+            continue;
+        char *chars = malloc(length + 1);
+        unsigned long long seed = 88172645463325252ull;
+        for (size_t i = 0; i < length; i++) {
+            seed ^= seed << 13, seed ^= seed >> 7, seed ^= seed << 17;
+            chars[i] = (char) ('a' + seed % 2);
+        }
+        memcpy(chars + length - strlen(pattern), pattern, strlen(pattern));
+        chars[length] = '\0';
+
+        StringState state = {.text = string_alloc(chars), .pattern = string_alloc(pattern)};
+        run("string", "index", 1, length, length, stringIndex, &state);
+        string_free(state.text);
+        string_free(state.pattern);
+        free(chars);
+    }
+}
+
+static double stringIndex(void *state, size_t ops) {
+    StringState *s = state;
+    volatile long long index = 0;
+    double begin = now();
+    for (size_t i = 0; i < ops; i++)
+        index += string_index(s->text, s->pattern);
+    return now() - begin;
+}
+
+// 任务派发开销：以每次新建并等待线程为基线，对比线程池提交并等待一个空任务，
+// 以及提交length个任务后统一等待、parallelFor按默认段长处理length个下标，后两者按每个任务或下标计。
+static void benchThreadPool(void) {
+    PoolState state = {.pool = threadPool_alloc(0), .length = 1};
+    if (state.pool == NULL)
+        return;
+    run("pthread", "create_join", 0, 1, 1, threadCreateJoin, &state);
+    run("threadPool", "async_join", 0, 1, 1, poolAsyncJoin, &state);
+    for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+        state.length = lengths[l];
+        if (state.length > maxLength)
+            continue;
+        if (state.length <= 100000)
+            run("threadPool", "submit_wait", 0, state.length, state.length, poolSubmitWait, &state);
+        run("threadPool", "parallel_for", 0, state.length, state.length, poolParallelFor, &state);
+    }
+    threadPool_free(state.pool);
+}
+
+static double threadCreateJoin(void *state, size_t ops) {
+    (void) state;
+    double begin = now();
+    for (size_t i = 0; i < ops; i++) {
+        pthread_t thread;
+        if (!pthread_create(&thread, NULL, emptyTask, NULL))
+            pthread_join(thread, NULL);
+    }
+    return now() - begin;
+}
+
+static double poolAsyncJoin(void *state, size_t ops) {
+    PoolState *s = state;
+    double begin = now();
+    for (size_t i = 0; i < ops; i++) {
+        ThreadPoolFuture *future = threadPool_async(s->pool, emptyTask, NULL);
+        if (future)
+            threadPool_join(s->pool, future);
+    }
+    return now() - begin;
+}
+
+static double poolSubmitWait(void *state, size_t ops) {
+    PoolState *s = state;
+    double begin = now();
+    for (size_t i = 0; i < ops; i++) {
+        for (size_t j = 0; j < s->length; j++)
+            threadPool_submit(s->pool, emptyTask, NULL);
+        threadPool_wait(s->pool);
+    }
+    return now() - begin;
+}
+
+static double poolParallelFor(void *state, size_t ops) {
+    PoolState *s = state;
+    double begin = now();
+    for (size_t i = 0; i < ops; i++)
+        threadPool_parallelFor(s->pool, 0, s->length, 0, 0, sumRange, state);
+    return now() - begin;
+}
+
+static void *emptyTask(void *arg) {
+    return arg;
+}
+
+// 每段只在结束时累加一次共享变量。
+static void sumRange(size_t from, size_t to, void *ctx) {
+    size_t sum = 0;
+    for (size_t i = from; i < to; i++)
+        sum += i;
+    atomic_fetch_add_explicit(&((PoolState *) ctx)->sink, sum, memory_order_relaxed);
+}
+
+// 预热并校准每轮操作次数，然后重复测试，unitsPerOp为每次操作折算的计量单位数。
+static void run(const char *subject, const char *workload, size_t elemSize, size_t length, size_t unitsPerOp,
+                BenchWorkload *fn, void *state) {
+    size_t ops = 1;
+    for (;;) {
+        double cost = fn(state, ops);
+        if (cost >= MinTrialSeconds || ops >= MaxOps)
+            break;
+        ops = cost > 0 && MinTrialSeconds / cost < 2 ? ops * 2 : ops * 8;
+        if (ops > MaxOps)
+            ops = MaxOps;
+    }
+
+    double samples[BENCH_MAX_TRIALS];
+    for (int i = 0; i < trials; i++)
+        samples[i] = fn(state, ops) * 1e9 / (double) (ops * unitsPerOp);
+    qsort(samples, trials, sizeof(double), doubleCmp);
+    size_t p99 = (size_t) (trials * 0.99 + 0.999999);
+    report(subject, workload, elemSize, length, ops, samples[trials / 2], samples[p99 ? p99 - 1 : 0]);
+}
+
+static void report(const char *subject, const char *workload, size_t elemSize, size_t length, size_t ops,
+                   double median, double p99) {
+    if (format == BenchFormat_Csv)
+        printf("%s,%s,%zu,%zu,%zu,%d,%.3f,%.3f\n", subject, workload, elemSize, length, ops, trials, median, p99);
+    else
+        printf("%s\n  {\"subject\": \"%s\", \"workload\": \"%s\", \"elem_size\": %zu, \"length\": %zu, \"ops\": %zu, "
+               "\"trials\": %d, \"median_ns\": %.3f, \"p99_ns\": %.3f}",
+               resultCount ? "," : "", subject, workload, elemSize, length, ops, trials, median, p99);
+    fflush(stdout);
+    resultCount++;
+}
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + (double) ts.tv_nsec / 1e9;
+}
+
+static int doubleCmp(const void *o1, const void *o2) {
+    double d1 = *(const double *) o1, d2 = *(const double *) o2;
+    return d1 < d2 ? -1 : d1 > d2;
+}
+
+// 元素首部4个字节为键。
+static int keyCmp(const void *o1, const void *o2) {
+    return memcmp(o1, o2, sizeof(unsigned));
+}
+
+static void keyVisitor(void *elem) {
+    static volatile unsigned char sink;
+    sink += *(unsigned char *) elem;
+}
+
+// xorshift随机数，避免rand的开销与全局状态。
+static size_t randomIndex(ListState *state, size_t bound) {
+    state->seed ^= state->seed << 13;
+    state->seed ^= state->seed >> 7;
+    state->seed ^= state->seed << 17;
+    return (size_t) (state->seed % bound);
+}
@@ -0,0 +1,640 @@
+/*
+ * Copyright (c) 2023 ivfzhou
+ * clib is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+
+#include <string.h>
+
+#include "btree_list.h"
+
+extern void *pointerAdd(void *p1, size_t delta);
+
+extern void memorySwap(void *p0, void *p1, size_t size);
+
+extern size_t memoryFind(const void *base, size_t count, size_t stride, size_t offset, const void *key,
+                         size_t keySize);
+
+// 从根到叶子经过的内部节点及所走的孩子下标。
+typedef struct {
+    BTreeListInner *inner;
+    size_t slot;
+} PathStep;
+
+static BTreeListLeaf *newLeaf(const BTreeList *list);
+
+static BTreeListInner *newInner(void);
+
+static void freeTree(BTreeListNode *node, const BTreeListLeaf *keep);
+
+static size_t maxCount(const BTreeList *list, const BTreeListNode *node);
+
+static size_t minCount(const BTreeList *list, const BTreeListNode *node);
+
+static size_t nodeSize(const BTreeListNode *node);
+
+static void *leafElem(const BTreeList *list, const BTreeListLeaf *leaf, size_t offset);
+
+static size_t descend(const BTreeList *list, size_t index, PathStep *path, BTreeListLeaf **leaf, size_t *offset);
+
+static BTreeListLeaf *findLeaf(const BTreeList *list, size_t index, size_t *offset);
+
+static void moveEntries(const BTreeList *list, BTreeListNode *dst, size_t dstPos, const BTreeListNode *src,
+                        size_t srcPos, size_t count);
+
+static void shiftEntries(const BTreeList *list, BTreeListNode *node, size_t from, size_t to);
+
+static size_t entriesSize(const BTreeListNode *node, size_t from, size_t count);
+
+static void splitInto(const BTreeList *list, BTreeListNode *node, BTreeListNode *right);
+
+static void insertChild(BTreeListInner *inner, size_t slot, BTreeListNode *child);
+
+static void rebalance(BTreeList *list, BTreeListInner *parent, size_t slot);
+
+static void removeAt(BTreeList *list, size_t index, void *elem);
+
+static void seek(const BTreeList *list, ListCursor *cursor);
+
+BTreeList *btreeList_alloc(size_t elemSize) {
+    BTreeList *list = malloc(sizeof(BTreeList));
+    list->elemSize = elemSize;
+    list->length = 0;
+    list->leafCapacity = elemSize && BTREE_LIST_LEAF_BYTES / elemSize > 8 ? BTREE_LIST_LEAF_BYTES / elemSize : 8;
+    list->first = list->last = newLeaf(list);
+    if (list->first == NULL) {
+        free(list);
+        return NULL;
+    }
+    list->root = &list->first->node;
+    return list;
+}
+
+void btreeList_free(BTreeList *list) {
+    freeTree(list->root, NULL);
+    list->root = NULL;
+    list->first = list->last = NULL;
+    list->length = list->elemSize = 0;
+    free(list);
+}
+
+size_t btreeList_len(const BTreeList *list) {
+    return list->length;
+}
+
+int btreeList_get(const BTreeList *list, size_t index, void *elem) {
+    if (index >= list->length)
+        return 1;
+    size_t offset;
+    BTreeListLeaf *leaf = findLeaf(list, index, &offset);
+    memcpy(elem, leafElem(list, leaf, offset), list->elemSize);
+    return 0;
+}
+
+// 满的叶子分裂后，新节点逐层插入父节点，父节点满了也分裂，直到某层有空位或生成新的根。
+int btreeList_insert(BTreeList *list, size_t index, const void *elem) {
+    if (index > list->length)
+        return 1;
+    PathStep path[BTREE_LIST_MAX_DEPTH];
+    BTreeListLeaf *leaf;
+    size_t offset;
+    size_t depth = descend(list, index, path, &leaf, &offset);
+
+    // 预先分配分裂所需的节点，分配失败时树保持不变。
+    BTreeListNode *spares[BTREE_LIST_MAX_DEPTH + 2];
+    size_t spareCount = 0, level = depth;
+    if (leaf->node.count == list->leafCapacity) {
+        spares[spareCount++] = (BTreeListNode *) newLeaf(list);
+        while (level > 0 && path[level - 1].inner->node.count == BTREE_LIST_FANOUT) {
+            spares[spareCount++] = (BTreeListNode *) newInner();
+            level--;
+        }
+        if (!level)
+            spares[spareCount++] = (BTreeListNode *) newInner();
+        for (size_t i = 0; i < spareCount; i++) {
+            if (spares[i] == NULL) {
+                for (size_t j = 0; j < spareCount; j++)
+                    free(spares[j]);
+                return 2;
+            }
+        }
+    }
+
+    size_t taken = 0;
+    BTreeListNode *split = NULL;
+    if (leaf->node.count == list->leafCapacity) {
+        BTreeListLeaf *right = (BTreeListLeaf *) spares[taken++];
+        splitInto(list, &leaf->node, &right->node);
+        right->next = leaf->next;
+        right->prev = leaf;
+        if (leaf->next)
+            leaf->next->prev = right;
+        else
+            list->last = right;
+        leaf->next = right;
+        if (offset > leaf->node.count) {
+            offset -= leaf->node.count;
+            leaf = right;
+        }
+        split = &right->node;
+    }
+    shiftEntries(list, &leaf->node, offset, offset + 1);
+    memcpy(leafElem(list, leaf, offset), elem, list->elemSize);
+    leaf->node.count++;
+
+    level = depth;
+    while (split) {
+        if (!level) {
+            BTreeListInner *root = (BTreeListInner *) spares[taken++];
+            root->node.count = 2;
+            root->children[0] = list->root;
+            root->children[1] = split;
+            root->sizes[0] = nodeSize(list->root);
+            root->sizes[1] = nodeSize(split);
+            list->root = &root->node;
+            break;
+        }
+        PathStep step = path[--level];
+        BTreeListInner *inner = step.inner;
+        inner->sizes[step.slot] = nodeSize(inner->children[step.slot]);
+        BTreeListNode *child = split;
+        split = NULL;
+        size_t slot = step.slot + 1;
+        if (inner->node.count == BTREE_LIST_FANOUT) {
+            BTreeListInner *right = (BTreeListInner *) spares[taken++];
+            splitInto(list, &inner->node, &right->node);
+            if (slot > inner->node.count) {
+                slot -= inner->node.count;
+                inner = right;
+            }
+            split = &right->node;
+        }
+        insertChild(inner, slot, child);
+    }
+    while (level > 0) {
+        level--;
+        path[level].inner->sizes[path[level].slot]++;
+    }
+
+    list->length++;
+    return 0;
+}
+
+int btreeList_del(BTreeList *list, size_t index) {
+    if (index >= list->length)
+        return 1;
+    removeAt(list, index, NULL);
+    return 0;
+}
+
+int btreeList_locate(const BTreeList *list, ListElemComparer cmp, const void *elem, size_t *index) {
+    size_t base = 0;
+    for (BTreeListLeaf *leaf = list->first; leaf; leaf = leaf->next) {
+        for (size_t i = 0; i < leaf->node.count; i++) {
+            if (!cmp(leafElem(list, leaf, i), elem)) {
+                *index = base + i;
+                return 0;
+            }
+        }
+        base += leaf->node.count;
+    }
+    return 1;
+}
+
+int btreeList_locateKey(const BTreeList *list, size_t offset, const void *key, size_t keySize, size_t *index) {
+    if (offset > list->elemSize || keySize > list->elemSize - offset)
+        return 1;
+    size_t base = 0;
+    for (BTreeListLeaf *leaf = list->first; leaf; leaf = leaf->next) {
+        if (!leaf->node.count)
+            continue;
+        size_t i = memoryFind(leaf->elems, leaf->node.count, list->elemSize, offset, key, keySize);
+        if (i < leaf->node.count) {
+            *index = base + i;
+            return 0;
+        }
+        base += leaf->node.count;
+    }
+    return 1;
+}
+
+int btreeList_travel(const BTreeList *list, ListElemVisitor visit) {
+    for (BTreeListLeaf *leaf = list->first; leaf; leaf = leaf->next)
+        for (size_t i = 0; i < leaf->node.count; i++)
+            visit(leafElem(list, leaf, i));
+    return 0;
+}
+
+int btreeList_locateCtx(const BTreeList *list, ListElemCtxComparer cmp, const void *elem, void *ctx, size_t *index) {
+    size_t base = 0;
+    for (BTreeListLeaf *leaf = list->first; leaf; leaf = leaf->next) {
+        for (size_t i = 0; i < leaf->node.count; i++) {
+            if (!cmp(leafElem(list, leaf, i), elem, ctx)) {
+                *index = base + i;
+                return 0;
+            }
+        }
+        base += leaf->node.count;
+    }
+    return 1;
+}
+
+int btreeList_travelCtx(const BTreeList *list, ListElemCtxVisitor visit, void *ctx) {
+    return btreeList_travelRange(list, 0, list->length, visit, ctx);
+}
+
+int btreeList_travelRange(const BTreeList *list, size_t index, size_t count, ListElemCtxVisitor visit, void *ctx) {
+    if (index > list->length || count > list->length - index)
+        return 1;
+    if (!count)
+        return 0;
+    size_t offset;
+    BTreeListLeaf *leaf = findLeaf(list, index, &offset);
+    while (count) {
+        for (; offset < leaf->node.count && count; offset++, count--) {
+            int res = visit(leafElem(list, leaf, offset), ctx);
+            if (res)
+                return res;
+        }
+        leaf = leaf->next;
+        offset = 0;
+    }
+    return 0;
+}
+
+// 保留首个叶子作为空表的根，无需重新分配。
+int btreeList_clear(BTreeList *list) {
+    BTreeListLeaf *first = list->first;
+    freeTree(list->root, first);
+    first->node.count = 0;
+    first->prev = first->next = NULL;
+    list->root = &first->node;
+    list->last = first;
+    list->length = 0;
+    return 0;
+}
+
+int btreeList_rpop(BTreeList *list, void *elem) {
+    return btreeList_getDel(list, list->length - 1, elem);
+}
+
+int btreeList_lpush(BTreeList *list, const void *elem) {
+    return btreeList_insert(list, 0, elem);
+}
+
+int btreeList_rpush(BTreeList *list, const void *elem) {
+    return btreeList_insert(list, list->length, elem);
+}
+
+int btreeList_lpop(BTreeList *list, void *elem) {
+    return btreeList_getDel(list, 0, elem);
+}
+
+int btreeList_set(BTreeList *list, size_t index, const void *elem) {
+    if (index >= list->length)
+        return 1;
+    size_t offset;
+    BTreeListLeaf *leaf = findLeaf(list, index, &offset);
+    memcpy(leafElem(list, leaf, offset), elem, list->elemSize);
+    return 0;
+}
+
+int btreeList_getDel(BTreeList *list, size_t index, void *elem) {
+    if (index >= list->length)
+        return 1;
+    removeAt(list, index, elem);
+    return 0;
+}
+
+int btreeList_getSet(BTreeList *list, size_t index, void *elem) {
+    if (index >= list->length)
+        return 1;
+    size_t offset;
+    BTreeListLeaf *leaf = findLeaf(list, index, &offset);
+    memorySwap(leafElem(list, leaf, offset), elem, list->elemSize);
+    return 0;
+}
+
+void *btreeList_at(const BTreeList *list, size_t index) {
+    if (index >= list->length)
+        return NULL;
+    size_t offset;
+    BTreeListLeaf *leaf = findLeaf(list, index, &offset);
+    return leafElem(list, leaf, offset);
+}
+
+int btreeList_getRange(const BTreeList *list, size_t index, size_t count, void *elems) {
+    if (index > list->length || count > list->length - index)
+        return 1;
+    if (!count)
+        return 0;
+    size_t offset;
+    BTreeListLeaf *leaf = findLeaf(list, index, &offset);
+    while (count) {
+        size_t n = leaf->node.count - offset < count ? leaf->node.count - offset : count;
+        memcpy(elems, leafElem(list, leaf, offset), n * list->elemSize);
+        elems = pointerAdd(elems, n * list->elemSize);
+        count -= n;
+        leaf = leaf->next;
+        offset = 0;
+    }
+    return 0;
+}
+
+int btreeList_span(const BTreeList *list, size_t index, size_t count, ListSpan *span) {
+    if (index > list->length || count > list->length - index)
+        return 1;
+    span->length = count;
+    span->stride = list->elemSize;
+    if (!count) {
+        span->base = NULL;
+        return 0;
+    }
+    size_t offset;
+    BTreeListLeaf *leaf = findLeaf(list, index, &offset);
+    if (offset + count > leaf->node.count)
+        return 2;
+    span->base = leafElem(list, leaf, offset);
+    return 0;
+}
+
+void btreeList_iterBegin(const BTreeList *list, ListCursor *cursor) {
+    cursor->index = cursor->offset = 0;
+    cursor->node = list->first;
+    cursor->prev = NULL;
+}
+
+int btreeList_iterNext(const BTreeList *list, ListCursor *cursor) {
+    if (cursor->index >= list->length)
+        return 1;
+    BTreeListLeaf *leaf = cursor->node;
+    cursor->index++;
+    if (++cursor->offset >= leaf->node.count && leaf->next) {
+        cursor->node = leaf->next;
+        cursor->offset = 0;
+    }
+    return 0;
+}
+
+void *btreeList_iterAt(const BTreeList *list, const ListCursor *cursor) {
+    if (cursor->index >= list->length)
+        return NULL;
+    return leafElem(list, cursor->node, cursor->offset);
+}
+
+// 插入可能分裂叶子，之后按位置重新定位。
+int btreeList_iterInsertBefore(BTreeList *list, ListCursor *cursor, const void *elem) {
+    int res = btreeList_insert(list, cursor->index < list->length ? cursor->index : list->length, elem);
+    if (res)
+        return res;
+    cursor->index++;
+    seek(list, cursor);
+    return 0;
+}
+
+int btreeList_iterErase(BTreeList *list, ListCursor *cursor, void *elem) {
+    if (cursor->index >= list->length)
+        return 1;
+    removeAt(list, cursor->index, elem);
+    seek(list, cursor);
+    return 0;
+}
+
+int btreeList_fprint(const BTreeList *list, FILE *f, ListElemToString str, size_t sizeOfElem) {
+    fprintf(f, "[");
+    char s[sizeOfElem + 1];
+    size_t index = 0;
+    for (BTreeListLeaf *leaf = list->first; leaf; leaf = leaf->next) {
+        for (size_t i = 0; i < leaf->node.count; i++) {
+            size_t len = str(leafElem(list, leaf, i), s);
+            s[len] = '\0';
+            fprintf(f, index++ ? ", %s" : "%s", s);
+        }
+    }
+    fprintf(f, "]");
+    fflush(f);
+    return 0;
+}
+
+static BTreeListLeaf *newLeaf(const BTreeList *list) {
+    BTreeListLeaf *leaf = malloc(sizeof(BTreeListLeaf) + list->leafCapacity * list->elemSize);
+    if (leaf == NULL)
+        return NULL;
+    leaf->node.count = 0;
+    leaf->node.leaf = 1;
+    leaf->prev = leaf->next = NULL;
+    return leaf;
+}
+
+static BTreeListInner *newInner(void) {
+    BTreeListInner *inner = malloc(sizeof(BTreeListInner));
+    if (inner == NULL)
+        return NULL;
+    inner->node.count = 0;
+    inner->node.leaf = 0;
+    return inner;
+}
+
+// 释放子树中除keep以外的全部节点。
+static void freeTree(BTreeListNode *node, const BTreeListLeaf *keep) {
+    if (!node->leaf) {
+        BTreeListInner *inner = (BTreeListInner *) node;
+        for (size_t i = 0; i < node->count; i++)
+            freeTree(inner->children[i], keep);
+    }
+    if (keep == NULL || node != &keep->node)
+        free(node);
+}
+
+static size_t maxCount(const BTreeList *list, const BTreeListNode *node) {
+    return node->leaf ? list->leafCapacity : BTREE_LIST_FANOUT;
+}
+
+static size_t minCount(const BTreeList *list, const BTreeListNode *node) {
+    return maxCount(list, node) / 4;
+}
+
+static size_t nodeSize(const BTreeListNode *node) {
+    return entriesSize(node, 0, node->count);
+}
+
+static void *leafElem(const BTreeList *list, const BTreeListLeaf *leaf, size_t offset) {
+    return pointerAdd((void *) leaf->elems, offset * list->elemSize);
+}
+
+// 每层跳过元素个数不超过index的孩子；index等于长度时落在最后一个叶子的末尾。
+static size_t descend(const BTreeList *list, size_t index, PathStep *path, BTreeListLeaf **leaf, size_t *offset) {
+    BTreeListNode *node = list->root;
+    size_t depth = 0;
+    while (!node->leaf) {
+        BTreeListInner *inner = (BTreeListInner *) node;
+        size_t i = 0;
+        while (i + 1 < node->count && index >= inner->sizes[i])
+            index -= inner->sizes[i++];
+        path[depth].inner = inner;
+        path[depth].slot = i;
+        depth++;
+        node = inner->children[i];
+    }
+    *leaf = (BTreeListLeaf *) node;
+    *offset = index;
+    return depth;
+}
+
+static BTreeListLeaf *findLeaf(const BTreeList *list, size_t index, size_t *offset) {
+    BTreeListNode *node = list->root;
+    while (!node->leaf) {
+        BTreeListInner *inner = (BTreeListInner *) node;
+        size_t i = 0;
+        while (i + 1 < node->count && index >= inner->sizes[i])
+            index -= inner->sizes[i++];
+        node = inner->children[i];
+    }
+    *offset = index;
+    return (BTreeListLeaf *) node;
+}
+
+// 把src中从srcPos开始的count项复制到dst的dstPos处，叶子的项为元素，内部节点的项为孩子及其元素个数。
+static void moveEntries(const BTreeList *list, BTreeListNode *dst, size_t dstPos, const BTreeListNode *src,
+                        size_t srcPos, size_t count) {
+    if (dst->leaf) {
+        memcpy(leafElem(list, (BTreeListLeaf *) dst, dstPos), leafElem(list, (const BTreeListLeaf *) src, srcPos),
+               count * list->elemSize);
+        return;
+    }
+    BTreeListInner *to = (BTreeListInner *) dst;
+    const BTreeListInner *from = (const BTreeListInner *) src;
+    memcpy(to->sizes + dstPos, from->sizes + srcPos, count * sizeof(size_t));
+    memcpy(to->children + dstPos, from->children + srcPos, count * sizeof(BTreeListNode *));
+}
+
+// 把node中从from开始到末尾的项整体移到to处。
+static void shiftEntries(const BTreeList *list, BTreeListNode *node, size_t from, size_t to) {
+    size_t count = node->count - from;
+    if (!count || from == to)
+        return;
+    if (node->leaf) {
+        BTreeListLeaf *leaf = (BTreeListLeaf *) node;
+        memmove(leafElem(list, leaf, to), leafElem(list, leaf, from), count * list->elemSize);
+        return;
+    }
+    BTreeListInner *inner = (BTreeListInner *) node;
+    memmove(inner->sizes + to, inner->sizes + from, count * sizeof(size_t));
+    memmove(inner->children + to, inner->children + from, count * sizeof(BTreeListNode *));
+}
+
+static size_t entriesSize(const BTreeListNode *node, size_t from, size_t count) {
+    if (node->leaf)
+        return count;
+    const BTreeListInner *inner = (const BTreeListInner *) node;
+    size_t size = 0;
+    for (size_t i = from; i < from + count; i++)
+        size += inner->sizes[i];
+    return size;
+}
+
+// 后一半的项移到空节点right中。
+static void splitInto(const BTreeList *list, BTreeListNode *node, BTreeListNode *right) {
+    size_t half = node->count / 2;
+    moveEntries(list, right, 0, node, half, node->count - half);
+    right->count = node->count - half;
+    node->count = half;
+}
+
+static void insertChild(BTreeListInner *inner, size_t slot, BTreeListNode *child) {
+    size_t count = inner->node.count - slot;
+    memmove(inner->sizes + slot + 1, inner->sizes + slot, count * sizeof(size_t));
+    memmove(inner->children + slot + 1, inner->children + slot, count * sizeof(BTreeListNode *));
+    inner->sizes[slot] = nodeSize(child);
+    inner->children[slot] = child;
+    inner->node.count++;
+}
+
+// 第slot个孩子不足时与相邻兄弟合并，合并后放不下则两者均分。
+static void rebalance(BTreeList *list, BTreeListInner *parent, size_t slot) {
+    size_t left = slot ? slot - 1 : slot, right = left + 1;
+    if (right >= parent->node.count)
+        return;
+    BTreeListNode *a = parent->children[left], *b = parent->children[right];
+
+    if (a->count + b->count <= maxCount(list, a)) {
+        moveEntries(list, a, a->count, b, 0, b->count);
+        a->count += b->count;
+        parent->sizes[left] += parent->sizes[right];
+        if (a->leaf) {
+            BTreeListLeaf *leftLeaf = (BTreeListLeaf *) a, *rightLeaf = (BTreeListLeaf *) b;
+            leftLeaf->next = rightLeaf->next;
+            if (rightLeaf->next)
+                rightLeaf->next->prev = leftLeaf;
+            else
+                list->last = leftLeaf;
+        }
+        free(b);
+        size_t count = parent->node.count - right - 1;
+        memmove(parent->sizes + right, parent->sizes + right + 1, count * sizeof(size_t));
+        memmove(parent->children + right, parent->children + right + 1, count * sizeof(BTreeListNode *));
+        parent->node.count--;
+        return;
+    }
+
+    size_t target = (a->count + b->count) / 2;
+    if (a->count < target) {
+        size_t n = target - a->count, moved = entriesSize(b, 0, n);
+        moveEntries(list, a, a->count, b, 0, n);
+        a->count += n;
+        shiftEntries(list, b, n, 0);
+        b->count -= n;
+        parent->sizes[left] += moved;
+        parent->sizes[right] -= moved;
+    } else {
+        size_t n = a->count - target, moved = entriesSize(a, target, n);
+        shiftEntries(list, b, 0, n);
+        moveEntries(list, b, 0, a, target, n);
+        b->count += n;
+        a->count -= n;
+        parent->sizes[left] -= moved;
+        parent->sizes[right] += moved;
+    }
+}
+
+// 删除后自叶子向上修复不足四分之一满的节点，根只剩一个孩子时降低高度。
+static void removeAt(BTreeList *list, size_t index, void *elem) {
+    PathStep path[BTREE_LIST_MAX_DEPTH];
+    BTreeListLeaf *leaf;
+    size_t offset;
+    size_t depth = descend(list, index, path, &leaf, &offset);
+
+    if (elem != NULL)
+        memcpy(elem, leafElem(list, leaf, offset), list->elemSize);
+    shiftEntries(list, &leaf->node, offset + 1, offset);
+    leaf->node.count--;
+    for (size_t i = 0; i < depth; i++)
+        path[i].inner->sizes[path[i].slot]--;
+
+    BTreeListNode *node = &leaf->node;
+    for (size_t level = depth; level > 0 && node->count < minCount(list, node); level--) {
+        rebalance(list, path[level - 1].inner, path[level - 1].slot);
+        node = &path[level - 1].inner->node;
+    }
+    while (!list->root->leaf && list->root->count == 1) {
+        BTreeListNode *root = list->root;
+        list->root = ((BTreeListInner *) root)->children[0];
+        free(root);
+    }
+    list->length--;
+}
+
+static void seek(const BTreeList *list, ListCursor *cursor) {
+    if (cursor->index < list->length) {
+        cursor->node = findLeaf(list, cursor->index, &cursor->offset);
+    } else {
+        cursor->node = list->last;
+        cursor->offset = list->last->node.count;
+    }
+}
@@ -0,0 +1,310 @@
+/*
+ * Copyright (c) 2023 ivfzhou
+ * clib is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+
+#ifndef CLIB_BTREE_LIST_H
+#define CLIB_BTREE_LIST_H
+
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "list.h"
+
+// 内部节点最多的孩子个数。
+#define BTREE_LIST_FANOUT 32
+
+// 叶子节点存放元素的目标字节数，即若干缓存行。
+#define BTREE_LIST_LEAF_BYTES 512
+
+// 树的最大高度，非根节点至少四分之一满，足以容纳任意长度。
+#define BTREE_LIST_MAX_DEPTH 40
+
+// B+树节点的公共部分。
+typedef struct {
+    size_t count; // 叶子节点为元素个数，内部节点为孩子个数
+    _Bool leaf;
+} BTreeListNode;
+
+// 叶子节点，元素连续存放，叶子之间按顺序双向链接。
+typedef struct BTreeListLeaf {
+    BTreeListNode node;
+    struct BTreeListLeaf *prev, *next;
+    _Alignas(max_align_t) unsigned char elems[];
+} BTreeListLeaf;
+
+// 内部节点，记录每个孩子子树中的元素个数。
+typedef struct {
+    BTreeListNode node;
+    size_t sizes[BTREE_LIST_FANOUT];
+    BTreeListNode *children[BTREE_LIST_FANOUT];
+} BTreeListInner;
+
+// 按子树元素个数定位的B+树线性表，按位置访问、插入、删除为O(log n)，顺序访问沿叶子连续内存前进。
+typedef struct {
+    size_t length, elemSize;
+    size_t leafCapacity;         // 每个叶子最多存放的元素个数
+    BTreeListNode *root;         // 根节点，空表时为一个空叶子
+    BTreeListLeaf *first, *last; // 首尾叶子
+} BTreeList;
+
+// 新建B+树线性表。
+// elemSize：每个元素占用的字节大小。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+// 返回NULL: 内存不足。
+BTreeList *btreeList_alloc(size_t elemSize);
+
+// 销毁B+树线性表。
+// list：B+树线性表。
+// 时间复杂度：O(n)
+// 空间复杂度：O(log n)
+void btreeList_free(BTreeList *list);
+
+// 获取B+树线性表中元素个数。
+// list：B+树线性表。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+size_t btreeList_len(const BTreeList *list);
+
+// 获取B+树线性表中某个位置的元素。
+// list：B+树线性表。
+// index：元素所在位置。
+// elem：元素值塞入elem中。
+// 时间复杂度：O(log n)
+// 空间复杂度：O(1)
+// 返回1: 越界。
+int btreeList_get(const BTreeList *list, size_t index, void *elem);
+
+// 向B+树线性表中插入元素，叶子满时分裂。
+// list：B+树线性表。
+// index：元素插入位置。
+// elem：被插入的元素。
+// 时间复杂度：O(log n)
+// 空间复杂度：O(log n)
+// 返回1: 越界。
+// 返回2: 内存不足。
+int btreeList_insert(BTreeList *list, size_t index, const void *elem);
+
+// 删除B+树线性表中某个位置的元素，节点不足四分之一满时与兄弟合并或均分。
+// list：B+树线性表。
+// index：元素所在位置。
+// 时间复杂度：O(log n)
+// 空间复杂度：O(log n)
+// 返回1: 越界。
+int btreeList_del(BTreeList *list, size_t index);
+
+// 寻找元素在B+树线性表中的位置。
+// list：B+树线性表。
+// cmp：元素比较函数。
+// elem：要寻找的元素。
+// index：元素位置塞入index中。
+// 时间复杂度：O(n)
+// 空间复杂度：O(1)
+// 返回1: 未找到。
+int btreeList_locate(const BTreeList *list, ListElemComparer cmp, const void *elem, size_t *index);
+
+// 按字节查找元素在B+树线性表中的位置，比较每个元素offset处的keySize个字节，不调用比较函数。
+// 沿叶子链逐个叶子比较其连续存放的元素。
+// list：B+树线性表。
+// offset：键在元素中的字节偏移。
+// key：要寻找的键。
+// keySize：键的字节大小。
+// index：元素位置塞入index中。
+// 时间复杂度：O(n)
+// 空间复杂度：O(1)
+// 返回1: 未找到，或键超出了元素范围。
+int btreeList_locateKey(const BTreeList *list, size_t offset, const void *key, size_t keySize, size_t *index);
+
+// 遍历B+树线性表。
+// list：B+树线性表。
+// visit：遍历函数。
+// 时间复杂度：O(n)
+// 空间复杂度：O(1)
+int btreeList_travel(const BTreeList *list, ListElemVisitor visit);
+
+// 带上下文查找元素在B+树线性表中的位置。
+// list：B+树线性表。
+// cmp：元素比较函数。
+// elem：要寻找的元素。
+// ctx：传给比较函数的上下文。
+// index：元素位置塞入index中。
+// 时间复杂度：O(n)
+// 空间复杂度：O(1)
+// 返回1: 未找到。
+int btreeList_locateCtx(const BTreeList *list, ListElemCtxComparer cmp, const void *elem, void *ctx, size_t *index);
+
+// 带上下文遍历B+树线性表，遍历函数返回非0时停止。
+// list：B+树线性表。
+// visit：遍历函数。
+// ctx：传给遍历函数的上下文。
+// 时间复杂度：O(n)
+// 空间复杂度：O(1)
+// 返回visit的非0返回值: 遍历提前结束。
+int btreeList_travelCtx(const BTreeList *list, ListElemCtxVisitor visit, void *ctx);
+
+// 带上下文遍历B+树线性表中从index开始的count个元素，遍历函数返回非0时停止。
+// list：B+树线性表。
+// index：第一个元素的位置。
+// count：元素个数。
+// visit：遍历函数。
+// ctx：传给遍历函数的上下文。
+// 时间复杂度：O(log n + count)
+// 空间复杂度：O(1)
+// 返回1: 越界。
+// 返回visit的非0返回值: 遍历提前结束。
+int btreeList_travelRange(const BTreeList *list, size_t index, size_t count, ListElemCtxVisitor visit, void *ctx);
+
+// 清空B+树线性表。
+// list：B+树线性表。
+// 时间复杂度：O(n)
+// 空间复杂度：O(log n)
+// 返回2: 内存不足。
+int btreeList_clear(BTreeList *list);
+
+// 取出B+树线性表最右边的元素。
+// list：B+树线性表。
+// elem：元素值塞入elem中。
+// 时间复杂度：O(log n)
+// 空间复杂度：O(log n)
+// 返回1: 越界。
+int btreeList_rpop(BTreeList *list, void *elem);
+
+// 向B+树线性表最左边添加元素。
+// list：B+树线性表。
+// elem：被添加的元素。
+// 时间复杂度：O(log n)
+// 空间复杂度：O(log n)
+// 返回2: 内存不足。
+int btreeList_lpush(BTreeList *list, const void *elem);
+
+// 向B+树线性表最右边添加元素。
+// list：B+树线性表。
+// elem：被添加的元素。
+// 时间复杂度：O(log n)
+// 空间复杂度：O(log n)
+// 返回2: 内存不足。
+int btreeList_rpush(BTreeList *list, const void *elem);
+
+// 取出B+树线性表最左边的元素。
+// list：B+树线性表。
+// elem：元素值塞入elem中。
+// 时间复杂度：O(log n)
+// 空间复杂度：O(log n)
+// 返回1: 越界。
+int btreeList_lpop(BTreeList *list, void *elem);
+
+// 设置B+树线性表中某个位置的元素。
+// list：B+树线性表。
+// index：元素所在位置。
+// elem：被设置的元素。
+// 时间复杂度：O(log n)
+// 空间复杂度：O(1)
+// 返回1: 越界。
+int btreeList_set(BTreeList *list, size_t index, const void *elem);
+
+// 获取B+树线性表中某个位置的元素然后删除之。
+// list：B+树线性表。
+// index：元素所在位置。
+// elem：元素值塞入elem中。
+// 时间复杂度：O(log n)
+// 空间复杂度：O(log n)
+// 返回1: 越界。
+int btreeList_getDel(BTreeList *list, size_t index, void *elem);
+
+// 获取B+树线性表中某个位置的元素然后设置新值。
+// list：B+树线性表。
+// index：元素所在位置。
+// elem：元素值设置进表中，然后旧值塞入elem中。
+// 时间复杂度：O(log n)
+// 空间复杂度：O(1)
+// 返回1: 越界。
+int btreeList_getSet(BTreeList *list, size_t index, void *elem);
+
+// 获取B+树线性表中元素的存储地址，可原地读写元素，插入或删除元素后地址失效。
+// list：B+树线性表。
+// index：元素所在位置。
+// 时间复杂度：O(log n)
+// 空间复杂度：O(1)
+// 返回NULL: 越界。
+void *btreeList_at(const BTreeList *list, size_t index);
+
+// 获取B+树线性表中连续多个元素，逐个叶子整段复制。
+// list：B+树线性表。
+// index：第一个元素的位置。
+// count：元素个数。
+// elems：将被设置为元素值。
+// 时间复杂度：O(log n + count)
+// 空间复杂度：O(1)
+// 返回1: 越界。
+int btreeList_getRange(const BTreeList *list, size_t index, size_t count, void *elems);
+
+// 获取同一个叶子中连续多个元素的视图，插入或删除元素后视图失效。
+// list：B+树线性表。
+// index：第一个元素的位置。
+// count：元素个数。
+// span：将被设置为元素视图。
+// 时间复杂度：O(log n)
+// 空间复杂度：O(1)
+// 返回1: 越界。
+// 返回2: 这些元素不在同一个叶子中。
+int btreeList_span(const BTreeList *list, size_t index, size_t count, ListSpan *span);
+
+// 迭代位置置于B+树线性表首个元素。
+// list：B+树线性表。
+// cursor：将被设置为迭代位置。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+void btreeList_iterBegin(const BTreeList *list, ListCursor *cursor);
+
+// 迭代位置前进到下一个元素。
+// list：B+树线性表。
+// cursor：迭代位置。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+// 返回1: 迭代已结束。
+int btreeList_iterNext(const BTreeList *list, ListCursor *cursor);
+
+// 获取迭代位置上元素的存储地址。
+// list：B+树线性表。
+// cursor：迭代位置。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+// 返回NULL: 迭代已结束。
+void *btreeList_iterAt(const BTreeList *list, const ListCursor *cursor);
+
+// 在迭代位置上的元素前插入元素，迭代位置仍指向原元素；迭代已结束时追加到尾部。
+// list：B+树线性表。
+// cursor：迭代位置。
+// elem：被插入的元素。
+// 时间复杂度：O(log n)
+// 空间复杂度：O(log n)
+// 返回2: 内存不足。
+int btreeList_iterInsertBefore(BTreeList *list, ListCursor *cursor, const void *elem);
+
+// 删除迭代位置上的元素，迭代位置指向下一个元素。
+// list：B+树线性表。
+// cursor：迭代位置。
+// elem：非NULL时将被设置为删除的元素值。
+// 时间复杂度：O(log n)
+// 空间复杂度：O(log n)
+// 返回1: 迭代已结束。
+int btreeList_iterErase(BTreeList *list, ListCursor *cursor, void *elem);
+
+// 打印B+树线性表中的元素。
+// list：B+树线性表。
+// f：打印输出对象。
+// str：元素转字符串函数。
+// sizeOfElem：每个元素转字符串表示占用的最大字节数。
+// 时间复杂度：O(n)
+// 空间复杂度：O(1)
+int btreeList_fprint(const BTreeList *list, FILE *f, ListElemToString str, size_t sizeOfElem);
+
+#endif // CLIB_BTREE_LIST_H
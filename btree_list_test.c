@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2023 ivfzhou
+ * clib is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "btree_list.c"
+
+#define TEST_LENGTH 100000
+
+static int intCmp(const void *o1, const void *o2);
+
+static void intVisitor(void *p);
+
+static int sumVisitor(void *p, void *ctx);
+
+static void checkTree(const BTreeList *list);
+
+static size_t checkNode(const BTreeList *list, const BTreeListNode *node, _Bool root, size_t depth, size_t *leafDepth,
+                        const BTreeListLeaf **leaf);
+
+int main(void) {
+    BTreeList *list = btreeList_alloc(sizeof(int));
+    assert(list);
+
+    int elem = 2;
+    size_t index = 0;
+    assert(!btreeList_insert(list, index, &elem));
+
+    elem = 1;
+    assert(!btreeList_lpush(list, &elem));
+
+    elem = 3;
+    assert(!btreeList_rpush(list, &elem));
+
+    assert(!btreeList_travel(list, intVisitor));
+
+    size_t length = btreeList_len(list);
+    assert(length == 3);
+
+    elem = 4;
+    assert(!btreeList_set(list, index, &elem));
+
+    assert(!btreeList_get(list, index, &elem));
+    assert(elem == 4);
+
+    elem = 3;
+    assert(!btreeList_locate(list, intCmp, &elem, &index));
+    assert(index == 2);
+
+    elem = 4;
+    assert(!btreeList_getSet(list, index, &elem));
+    assert(elem == 3);
+
+    assert(!btreeList_getDel(list, index, &elem));
+    assert(elem == 4);
+
+    assert(!btreeList_lpop(list, &elem));
+    assert(elem == 4);
+
+    assert(!btreeList_rpop(list, &elem));
+    assert(elem == 2);
+
+    assert(btreeList_lpop(list, &elem) == 1);
+    assert(btreeList_rpop(list, &elem) == 1);
+    assert(btreeList_insert(list, 1, &elem) == 1);
+
+    // 与数组对照随机插入删除，并检查各节点计数、填充率与叶子链。
+    srand(time(NULL) + 100);
+    int *expect = malloc(sizeof(int) * TEST_LENGTH);
+    int res = 0;
+    for (int i = 0; i < TEST_LENGTH; i++) {
+        elem = i + 1;
+        length = btreeList_len(list);
+        index = rand() % (length + 1u);
+        assert(!btreeList_insert(list, index, &elem));
+        memmove(expect + index + 1, expect + index, (length - index) * sizeof(int));
+        expect[index] = elem;
+        assert(!btreeList_get(list, index, &res));
+        assert(res == elem);
+    }
+    assert(!list->root->leaf);
+    checkTree(list);
+    for (size_t i = 0; i < TEST_LENGTH; i++)
+        assert(*(int *) btreeList_at(list, i) == expect[i]);
+    ListCursor cursor;
+    btreeList_iterBegin(list, &cursor);
+    for (size_t i = 0; i < TEST_LENGTH; i++, btreeList_iterNext(list, &cursor))
+        assert(*(int *) btreeList_iterAt(list, &cursor) == expect[i]);
+    assert(!btreeList_iterAt(list, &cursor));
+    assert(btreeList_iterNext(list, &cursor) == 1);
+
+    // 区间读取与遍历。
+    int *range = malloc(sizeof(int) * 1000);
+    for (int i = 0; i < 100; i++) {
+        size_t count = rand() % 1000u;
+        index = rand() % (TEST_LENGTH - count + 1u);
+        assert(!btreeList_getRange(list, index, count, range));
+        assert(!memcmp(range, expect + index, count * sizeof(int)));
+        long long sum = 0, want = 0;
+        for (size_t j = 0; j < count; j++)
+            want += expect[index + j];
+        assert(!btreeList_travelRange(list, index, count, sumVisitor, &sum));
+        assert(sum == want);
+    }
+    free(range);
+    assert(btreeList_getRange(list, TEST_LENGTH, 1, &res) == 1);
+    assert(btreeList_travelRange(list, 1, TEST_LENGTH, sumVisitor, &res) == 1);
+
+    // 视图只在同一叶子内有效。
+    ListSpan span;
+    size_t offset;
+    BTreeListLeaf *leaf = findLeaf(list, TEST_LENGTH / 2, &offset);
+    assert(!btreeList_span(list, TEST_LENGTH / 2 - offset, leaf->node.count, &span));
+    assert(span.length == leaf->node.count && span.stride == sizeof(int));
+    assert(!memcmp(span.base, expect + TEST_LENGTH / 2 - offset, leaf->node.count * sizeof(int)));
+    assert(btreeList_span(list, TEST_LENGTH / 2 - offset, leaf->node.count + 1, &span) == 2);
+    assert(btreeList_span(list, TEST_LENGTH, 1, &span) == 1);
+
+    for (int i = 0; i < TEST_LENGTH - 100; i++) {
+        length = btreeList_len(list);
+        index = rand() % length;
+        assert(!btreeList_getDel(list, index, &res));
+        assert(res == expect[index]);
+        memmove(expect + index, expect + index + 1, (length - index - 1) * sizeof(int));
+        if (i % 10000 == 0)
+            checkTree(list);
+    }
+    checkTree(list);
+
+    // 迭代中删除与插入。
+    btreeList_iterBegin(list, &cursor);
+    for (size_t i = 0; i < 100; i++) {
+        if (i % 2) {
+            assert(!btreeList_iterErase(list, &cursor, &res));
+            assert(res == expect[i]);
+        } else {
+            elem = -expect[i];
+            assert(!btreeList_iterInsertBefore(list, &cursor, &elem));
+            assert(!btreeList_iterNext(list, &cursor));
+        }
+    }
+    assert(!btreeList_iterAt(list, &cursor));
+    assert(btreeList_iterErase(list, &cursor, NULL) == 1);
+    assert(btreeList_len(list) == 100);
+    for (size_t i = 0; i < 100; i++)
+        assert(*(int *) btreeList_at(list, i) == (i % 2 ? expect[i - 1] : -expect[i]));
+    checkTree(list);
+    free(expect);
+
+    assert(!btreeList_clear(list));
+    assert(!btreeList_len(list) && list->root->leaf);
+    for (int i = 0; i < TEST_LENGTH; i++)
+        assert(!btreeList_rpush(list, &i));
+    checkTree(list);
+    for (int i = 0; i < TEST_LENGTH; i++)
+        assert(!btreeList_lpop(list, &res) && res == i);
+    assert(list->root->leaf && list->first == list->last);
+
+    btreeList_free(list);
+}
+
+// 内部节点记录的个数等于子树元素数，非根节点不低于四分之一满，叶子同深且按序链接。
+static void checkTree(const BTreeList *list) {
+    size_t leafDepth = 0;
+    const BTreeListLeaf *leaf = NULL;
+    assert(checkNode(list, list->root, 1, 0, &leafDepth, &leaf) == list->length);
+    assert(leaf == list->last && !leaf->next);
+}
+
+static size_t checkNode(const BTreeList *list, const BTreeListNode *node, _Bool root, size_t depth, size_t *leafDepth,
+                        const BTreeListLeaf **leaf) {
+    assert(node->count <= maxCount(list, node));
+    if (!root)
+        assert(node->count >= minCount(list, node));
+    if (node->leaf) {
+        const BTreeListLeaf *cur = (const BTreeListLeaf *) node;
+        if (*leaf) {
+            assert(depth == *leafDepth);
+            assert((*leaf)->next == cur);
+        } else {
+            *leafDepth = depth;
+            assert(cur == list->first && !cur->prev);
+        }
+        assert(cur->prev == *leaf);
+        *leaf = cur;
+        return node->count;
+    }
+    if (root)
+        assert(node->count >= 2);
+    const BTreeListInner *inner = (const BTreeListInner *) node;
+    size_t size = 0;
+    for (size_t i = 0; i < node->count; i++) {
+        assert(checkNode(list, inner->children[i], 0, depth + 1, leafDepth, leaf) == inner->sizes[i]);
+        size += inner->sizes[i];
+    }
+    return size;
+}
+
+static int intCmp(const void *o1, const void *o2) {
+    int *n1 = (int *) o1;
+    int *n2 = (int *) o2;
+    if (*n1 == *n2)
+        return 0;
+    return o1 > o2 ? 1 : -1;
+}
+
+static void intVisitor(void *p) {
+    static int prev = 1;
+    int i = *(int *) p;
+    assert(i == prev);
+    prev = i + 1;
+}
+
+static int sumVisitor(void *p, void *ctx) {
+    *(long long *) ctx += *(int *) p;
+    return 0;
+}
@@ -14,8 +14,16 @@
 
 #include "circle_linked_list.h"
 
+extern void memorySwap(void *p0, void *p1, size_t size);
+
+extern void *chainSort(void *head, size_t elemOffset, ListElemCtxComparer cmp, void *ctx);
+
 // 新建节点。
-static CircleLinkNode *newNode(size_t size, const void *elem);
+static CircleLinkNode *newNode(const CircleLinkedList *list, const void *elem);
+
+static void freeNode(const CircleLinkedList *list, CircleLinkNode *node);
+
+static void freeNodes(CircleLinkedList *list);
 
 // 获取节点。
 static CircleLinkNode *getNode(const CircleLinkedList *list, size_t index);
@@ -23,24 +31,55 @@ static CircleLinkNode *getNode(const CircleLinkedList *list, size_t index);
 // 取出一个节点。
 static CircleLinkNode *popNode(CircleLinkedList *list, size_t index);
 
+// 摘下一段节点。
+static void takeChain(CircleLinkedList *list, size_t from, size_t count, CircleLinkNode **first,
+                      CircleLinkNode **last);
+
+// 链接一段节点。
+static void putChain(CircleLinkedList *list, size_t index, CircleLinkNode *first, CircleLinkNode *last, size_t count);
+
+// 节点能否移动。
+static _Bool compatible(const CircleLinkedList *list, const CircleLinkedList *other);
+
+// 缓存最近定位的节点。
+static void setFinger(const CircleLinkedList *list, size_t index, CircleLinkNode *node);
+
+// 插入节点后调整定位缓存。
+static void fingerInsert(CircleLinkedList *list, size_t index, size_t count);
+
+// 删除节点后调整定位缓存。
+static void fingerRemove(CircleLinkedList *list, size_t index, size_t count, CircleLinkNode *next);
+
 CircleLinkedList *circleLinkedList_alloc(size_t elemSize) {
     CircleLinkedList *list = malloc(sizeof(CircleLinkedList));
     list->elemSize = elemSize;
     list->length = 0;
-    list->firstNode = NULL;
+    list->firstNode = list->finger = NULL;
+    list->fingerIndex = 0;
+    list->pool = NULL;
+    list->ownPool = 0;
     return list;
 }
 
-void circleLinkedList_free(CircleLinkedList *list) {
-    CircleLinkNode *node = list->firstNode;
-    for (size_t i = 0; i < list->length; i++) {
-        CircleLinkNode *next = node->next;
-        free(node->elem);
-        free(node);
-        node = next;
+CircleLinkedList *circleLinkedList_allocWithPool(size_t elemSize, NodePool *pool) {
+    NodePool *nodePool = pool ? pool : nodePool_alloc(0);
+    if (nodePool_bind(nodePool, sizeof(CircleLinkNode) + elemSize)) {
+        if (!pool)
+            nodePool_free(nodePool);
+        return NULL;
     }
+    CircleLinkedList *list = circleLinkedList_alloc(elemSize);
+    list->pool = nodePool;
+    list->ownPool = !pool;
+    return list;
+}
+
+void circleLinkedList_free(CircleLinkedList *list) {
+    freeNodes(list);
+    if (list->ownPool)
+        nodePool_free(list->pool);
     list->length = list->elemSize = 0;
-    list->firstNode = NULL;
+    list->firstNode = list->finger = NULL;
     free(list);
 }
 
@@ -59,7 +98,9 @@ int circleLinkedList_get(const CircleLinkedList *list, size_t index, void *elem)
 int circleLinkedList_insert(CircleLinkedList *list, size_t index, const void *elem) {
     if (index > list->length)
         return 1;
-    CircleLinkNode *node = newNode(list->elemSize, elem);
+    CircleLinkNode *node = newNode(list, elem);
+    if (node == NULL)
+        return 2;
 
     // 在首部插入
     if (!index) {
@@ -83,6 +124,7 @@ int circleLinkedList_insert(CircleLinkedList *list, size_t index, const void *el
             indexNode->prev->next = node;
         indexNode->prev = node;
     }
+    fingerInsert(list, index, 1);
 
     list->length++;
     return 0;
@@ -92,8 +134,7 @@ int circleLinkedList_del(CircleLinkedList *list, size_t index) {
     if (index >= list->length)
         return 1;
     CircleLinkNode *node = popNode(list, index);
-    free(node->elem);
-    free(node);
+    freeNode(list, node);
     return 0;
 }
 
@@ -118,16 +159,33 @@ int circleLinkedList_travel(const CircleLinkedList *list, ListElemVisitor visit)
     return 0;
 }
 
-int circleLinkedList_clear(CircleLinkedList *list) {
+int circleLinkedList_locateCtx(const CircleLinkedList *list, ListElemCtxComparer cmp, const void *elem, void *ctx, size_t *index) {
     CircleLinkNode *node = list->firstNode;
     for (size_t i = 0; i < list->length; i++) {
-        CircleLinkNode *next = node->next;
-        free(node->elem);
-        free(node);
-        node = next;
+        if (!cmp(node->elem, elem, ctx)) {
+            *index = i;
+            return 0;
+        }
+        node = node->next;
     }
+    return 1;
+}
+
+int circleLinkedList_travelCtx(const CircleLinkedList *list, ListElemCtxVisitor visit, void *ctx) {
+    CircleLinkNode *node = list->firstNode;
+    for (size_t i = 0; i < list->length; i++) {
+        int res = visit(node->elem, ctx);
+        if (res)
+            return res;
+        node = node->next;
+    }
+    return 0;
+}
+
+int circleLinkedList_clear(CircleLinkedList *list) {
+    freeNodes(list);
     list->length = 0;
-    list->firstNode = NULL;
+    list->firstNode = list->finger = NULL;
     return 0;
 }
 
@@ -160,8 +218,7 @@ int circleLinkedList_getDel(CircleLinkedList *list, size_t index, void *elem) {
         return 1;
     CircleLinkNode *node = popNode(list, index);
     memcpy(elem, node->elem, list->elemSize);
-    free(node->elem);
-    free(node);
+    freeNode(list, node);
     return 0;
 }
 
@@ -169,11 +226,114 @@ int circleLinkedList_getSet(CircleLinkedList *list, size_t index, void *elem) {
     if (index >= list->length)
         return 1;
     CircleLinkNode *node = getNode(list, index);
-    void *tmp = malloc(list->elemSize);
-    memcpy(tmp, node->elem, list->elemSize);
-    memcpy(node->elem, elem, list->elemSize);
-    memcpy(elem, tmp, list->elemSize);
-    free(tmp);
+    memorySwap(node->elem, elem, list->elemSize);
+    return 0;
+}
+
+void *circleLinkedList_at(const CircleLinkedList *list, size_t index) {
+    if (index >= list->length)
+        return NULL;
+    return getNode(list, index)->elem;
+}
+
+void circleLinkedList_iterBegin(const CircleLinkedList *list, ListCursor *cursor) {
+    cursor->index = 0;
+    cursor->node = list->length ? list->firstNode : NULL;
+    cursor->prev = NULL;
+}
+
+int circleLinkedList_iterNext(const CircleLinkedList *list, ListCursor *cursor) {
+    if (cursor->index >= list->length)
+        return 1;
+    CircleLinkNode *node = cursor->node;
+    cursor->node = ++cursor->index < list->length ? node->next : NULL;
+    return 0;
+}
+
+void *circleLinkedList_iterAt(const CircleLinkedList *list, const ListCursor *cursor) {
+    if (cursor->index >= list->length)
+        return NULL;
+    return ((CircleLinkNode *) cursor->node)->elem;
+}
+
+int circleLinkedList_iterInsertBefore(CircleLinkedList *list, ListCursor *cursor, const void *elem) {
+    if (!cursor->index) {
+        int res = circleLinkedList_insert(list, 0, elem);
+        if (res)
+            return res;
+    } else {
+        // 迭代已结束时插入到首个节点之前，即尾部。
+        CircleLinkNode *indexNode = cursor->index < list->length ? cursor->node : list->firstNode;
+        CircleLinkNode *node = newNode(list, elem);
+        if (node == NULL)
+            return 2;
+        node->next = indexNode;
+        node->prev = indexNode->prev;
+        indexNode->prev->next = node;
+        indexNode->prev = node;
+        fingerInsert(list, cursor->index, 1);
+        list->length++;
+    }
+    cursor->index++;
+    return 0;
+}
+
+int circleLinkedList_iterErase(CircleLinkedList *list, ListCursor *cursor, void *elem) {
+    if (cursor->index >= list->length)
+        return 1;
+    CircleLinkNode *node = cursor->node;
+    CircleLinkNode *next = cursor->index + 1 < list->length ? node->next : NULL;
+    if (!cursor->index) {
+        popNode(list, 0);
+    } else {
+        node->prev->next = node->next;
+        node->next->prev = node->prev;
+        fingerRemove(list, cursor->index, 1, next);
+        list->length--;
+    }
+    cursor->node = next;
+
+    if (elem != NULL)
+        memcpy(elem, node->elem, list->elemSize);
+    freeNode(list, node);
+    return 0;
+}
+
+int circleLinkedList_splice(CircleLinkedList *list, size_t index, CircleLinkedList *other, size_t from, size_t to) {
+    if (index > list->length || from > to || to > other->length)
+        return 1;
+    if (!compatible(list, other))
+        return 3;
+    if (from == to)
+        return 0;
+    CircleLinkNode *first, *last;
+    takeChain(other, from, to - from, &first, &last);
+    putChain(list, index, first, last, to - from);
+    return 0;
+}
+
+int circleLinkedList_split(CircleLinkedList *list, size_t index, CircleLinkedList *other) {
+    return circleLinkedList_splice(other, other->length, list, index, list->length);
+}
+
+int circleLinkedList_concat(CircleLinkedList *list, CircleLinkedList *other) {
+    return circleLinkedList_splice(list, list->length, other, 0, other->length);
+}
+
+// 断开环按next排序，之后补上prev并重新接成环。
+int circleLinkedList_sort(CircleLinkedList *list, ListElemCtxComparer cmp, void *ctx) {
+    if (list->length < 2)
+        return 0;
+    list->firstNode->prev->next = NULL;
+    CircleLinkNode *first = chainSort(list->firstNode, offsetof(CircleLinkNode, elem), cmp, ctx), *last = first;
+    for (CircleLinkNode *node = first->next; node; node = node->next) {
+        node->prev = last;
+        last = node;
+    }
+    first->prev = last;
+    last->next = first;
+    list->firstNode = first;
+    setFinger(list, 0, NULL);
     return 0;
 }
 
@@ -197,23 +357,34 @@ int circleLinkedList_fprint(const CircleLinkedList *list, FILE *f, ListElemToStr
     return 0;
 }
 
-static CircleLinkNode *newNode(size_t size, const void *elem) {
-    CircleLinkNode *newNode = malloc(sizeof(CircleLinkNode));
-    newNode->elem = malloc(size);
-    memcpy(newNode->elem, elem, size);
+static CircleLinkNode *newNode(const CircleLinkedList *list, const void *elem) {
+    CircleLinkNode *newNode = list->pool ? nodePool_get(list->pool) : malloc(sizeof(CircleLinkNode) + list->elemSize);
+    if (newNode == NULL)
+        return NULL;
+    memcpy(newNode->elem, elem, list->elemSize);
     newNode->next = newNode->prev = NULL;
     return newNode;
 }
 
+// 从首节点向后、从首节点向前绕到尾部或从最近定位的节点出发，取离index最近者。index等于长度时为首节点。
 static CircleLinkNode *getNode(const CircleLinkedList *list, size_t index) {
     CircleLinkNode *node = list->firstNode;
-    if (index <= list->length / 2)
-        for (size_t i = 0; i < index; i++)
-            node = node->next;
-    else
-        for (size_t i = list->length - 1; i >= index; i--)
-            node = node->prev;
-
+    if (index >= list->length)
+        return node;
+    size_t i = index <= list->length / 2 ? 0 : list->length;
+    if (list->finger) {
+        size_t distance = i > index ? i - index : index - i;
+        size_t fingerDistance = list->fingerIndex > index ? list->fingerIndex - index : index - list->fingerIndex;
+        if (fingerDistance < distance) {
+            node = list->finger;
+            i = list->fingerIndex;
+        }
+    }
+    for (; i < index; i++)
+        node = node->next;
+    for (; i > index; i--)
+        node = node->prev;
+    setFinger(list, index, node);
     return node;
 }
 
@@ -231,7 +402,95 @@ static CircleLinkNode *popNode(CircleLinkedList *list, size_t index) {
         node->prev->next = node->next;
         node->next->prev = node->prev;
     }
+    fingerRemove(list, index, 1, index + 1 < list->length ? node->next : NULL);
     node->prev = node->next = NULL;
     list->length--;
     return node;
 }
+
+// 摘下全部节点时环保持原样，只清零长度。
+static void takeChain(CircleLinkedList *list, size_t from, size_t count, CircleLinkNode **first,
+                      CircleLinkNode **last) {
+    *first = getNode(list, from);
+    *last = getNode(list, from + count - 1);
+    fingerRemove(list, from, count, from + count < list->length ? (*last)->next : NULL);
+    list->length -= count;
+    if (!list->length)
+        return;
+    CircleLinkNode *prev = (*first)->prev, *next = (*last)->next;
+    prev->next = next;
+    next->prev = prev;
+    if (!from)
+        list->firstNode = next;
+}
+
+// 在index位置节点之前链接，index等于长度时链接到首节点之前即环的尾部。
+static void putChain(CircleLinkedList *list, size_t index, CircleLinkNode *first, CircleLinkNode *last, size_t count) {
+    if (!list->length) {
+        first->prev = last;
+        last->next = first;
+        list->firstNode = first;
+    } else {
+        CircleLinkNode *next = index < list->length ? getNode(list, index) : list->firstNode;
+        CircleLinkNode *prev = next->prev;
+        prev->next = first;
+        first->prev = prev;
+        last->next = next;
+        next->prev = last;
+        if (!index)
+            list->firstNode = first;
+    }
+    fingerInsert(list, index, count);
+    list->length += count;
+}
+
+// 元素大小相同，且节点来自同一个共享节点池或都由malloc分配，独占的节点池不会相同。
+static _Bool compatible(const CircleLinkedList *list, const CircleLinkedList *other) {
+    return list != other && list->elemSize == other->elemSize && list->pool == other->pool;
+}
+
+// 定位缓存不属于环链表的内容，只读操作也可更新。
+static void setFinger(const CircleLinkedList *list, size_t index, CircleLinkNode *node) {
+    CircleLinkedList *mutable = (CircleLinkedList *) list;
+    mutable->finger = node;
+    mutable->fingerIndex = index;
+}
+
+// 在index位置插入count个节点后，其后的定位缓存位置后移。
+static void fingerInsert(CircleLinkedList *list, size_t index, size_t count) {
+    if (list->finger && list->fingerIndex >= index)
+        list->fingerIndex += count;
+}
+
+// 删除index开始的count个节点后，定位缓存若在其中则改为接替它们的next节点，next为NULL时失效。
+static void fingerRemove(CircleLinkedList *list, size_t index, size_t count, CircleLinkNode *next) {
+    if (!list->finger || list->fingerIndex < index)
+        return;
+    if (list->fingerIndex >= index + count)
+        list->fingerIndex -= count;
+    else {
+        list->finger = next;
+        list->fingerIndex = index;
+    }
+}
+
+static void freeNode(const CircleLinkedList *list, CircleLinkNode *node) {
+    if (list->pool)
+        nodePool_put(list->pool, node);
+    else
+        free(node);
+}
+
+// 独占的节点池直接释放全部内存块，无需逐个归还节点。
+static void freeNodes(CircleLinkedList *list) {
+    if (list->ownPool) {
+        nodePool_reset(list->pool);
+        return;
+    }
+    CircleLinkNode *node = list->firstNode;
+    for (size_t i = 0; i < list->length; i++) {
+        CircleLinkNode *next = node->next;
+        freeNode(list, node);
+        node = next;
+    }
+}
@@ -13,20 +13,27 @@
 #ifndef CLIB_CIRCLE_LINKED_LIST_H
 #define CLIB_CIRCLE_LINKED_LIST_H
 
+#include <stddef.h>
 #include <stdlib.h>
 
 #include "list.h"
+#include "node_pool.h"
 
-// 环链节点。
+// 环链节点，元素值与节点在同一块内存中。
 typedef struct CircleLinkNode {
-    void *elem;
     struct CircleLinkNode *next, *prev;
+    _Alignas(max_align_t) unsigned char elem[];
 } CircleLinkNode;
 
 // 环链线性表。
+// 按位置访问时缓存最近定位的节点，邻近位置的访问从缓存节点出发，因此只读访问也会修改缓存，多线程同时读需自行加锁。
 typedef struct {
     size_t length, elemSize;
     CircleLinkNode *firstNode;
+    CircleLinkNode *finger; // 最近定位的节点，NULL表示无缓存
+    size_t fingerIndex;     // finger所在位置
+    NodePool *pool; // 节点池，NULL表示节点由malloc分配
+    _Bool ownPool;  // 节点池是否由线性表独占
 } CircleLinkedList;
 
 // 新建环链表。
@@ -35,6 +42,14 @@ typedef struct {
 // 空间复杂度：O(1)
 CircleLinkedList *circleLinkedList_alloc(size_t elemSize);
 
+// 新建从节点池分配节点的环链表。
+// elemSize：每个元素占用的字节大小。
+// pool：节点池，可在节点大小相同的线性表间共享，由调用方销毁；NULL表示环链表独占一个节点池，清空或销毁时整块释放。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+// 返回NULL: 节点池已绑定其它节点大小。
+CircleLinkedList *circleLinkedList_allocWithPool(size_t elemSize, NodePool *pool);
+
 // 销毁环链表。
 // 时间复杂度：O(n)
 // 空间复杂度：O(1)
@@ -62,6 +77,7 @@ int circleLinkedList_get(const CircleLinkedList *list, size_t index, void *elem)
 // 时间复杂度：O(n)
 // 空间复杂度：O(1)
 // 返回1: 越界。
+// 返回2: 内存不足。
 int circleLinkedList_insert(CircleLinkedList *list, size_t index, const void *elem);
 
 // 删除环链表中元素。
@@ -89,6 +105,26 @@ int circleLinkedList_locate(const CircleLinkedList *list, ListElemComparer cmp,
 // 空间复杂度：O(1)
 int circleLinkedList_travel(const CircleLinkedList *list, ListElemVisitor visit);
 
+// 带上下文查找元素在环链表中的位置。
+// list：环链表。
+// cmp：元素比较函数。
+// elem：要寻找的元素。
+// ctx：传给比较函数的上下文。
+// index：元素位置塞入index中。
+// 时间复杂度：O(n)
+// 空间复杂度：O(1)
+// 返回1: 未找到。
+int circleLinkedList_locateCtx(const CircleLinkedList *list, ListElemCtxComparer cmp, const void *elem, void *ctx, size_t *index);
+
+// 带上下文遍历环链表，遍历函数返回非0时停止。
+// list：环链表。
+// visit：遍历函数。
+// ctx：传给遍历函数的上下文。
+// 时间复杂度：O(n)
+// 空间复杂度：O(1)
+// 返回visit的非0返回值: 遍历提前结束。
+int circleLinkedList_travelCtx(const CircleLinkedList *list, ListElemCtxVisitor visit, void *ctx);
+
 // 清除环链表中所有元素。
 // list：环链表。
 // 时间复杂度：O(n)
@@ -108,6 +144,7 @@ int circleLinkedList_rpop(CircleLinkedList *list, void *elem);
 // elem：被添加的元素。
 // 时间复杂度：O(n)
 // 空间复杂度：O(1)
+// 返回2: 内存不足。
 int circleLinkedList_lpush(CircleLinkedList *list, const void *elem);
 
 // 向环链表最右边添加元素。
@@ -115,6 +152,7 @@ int circleLinkedList_lpush(CircleLinkedList *list, const void *elem);
 // elem：被添加的元素。
 // 时间复杂度：O(n)
 // 空间复杂度：O(1)
+// 返回2: 内存不足。
 int circleLinkedList_rpush(CircleLinkedList *list, const void *elem);
 
 // 取出环链表中最左边的元素。
@@ -150,6 +188,93 @@ int circleLinkedList_getDel(CircleLinkedList *list, size_t index, void *elem);
 // 返回1: 越界。
 int circleLinkedList_getSet(CircleLinkedList *list, size_t index, void *elem);
 
+// 获取环链表中元素的存储地址，可原地读写元素，删除该元素后地址失效。
+// list：环链表。
+// index：元素所在位置。
+// 时间复杂度：O(n)
+// 空间复杂度：O(1)
+// 返回NULL: 越界。
+void *circleLinkedList_at(const CircleLinkedList *list, size_t index);
+
+// 迭代位置置于环链表首个元素。
+// list：环链表。
+// cursor：将被设置为迭代位置。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+void circleLinkedList_iterBegin(const CircleLinkedList *list, ListCursor *cursor);
+
+// 迭代位置前进到下一个元素。
+// list：环链表。
+// cursor：迭代位置。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+// 返回1: 迭代已结束。
+int circleLinkedList_iterNext(const CircleLinkedList *list, ListCursor *cursor);
+
+// 获取迭代位置上元素的存储地址。
+// list：环链表。
+// cursor：迭代位置。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+// 返回NULL: 迭代已结束。
+void *circleLinkedList_iterAt(const CircleLinkedList *list, const ListCursor *cursor);
+
+// 在迭代位置上的元素前插入元素，迭代位置仍指向原元素；迭代已结束时追加到尾部。
+// list：环链表。
+// cursor：迭代位置。
+// elem：被插入的元素。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+// 返回2: 内存不足。
+int circleLinkedList_iterInsertBefore(CircleLinkedList *list, ListCursor *cursor, const void *elem);
+
+// 删除迭代位置上的元素，迭代位置指向下一个元素。
+// list：环链表。
+// cursor：迭代位置。
+// elem：非NULL时将被设置为删除的元素值。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+// 返回1: 迭代已结束。
+int circleLinkedList_iterErase(CircleLinkedList *list, ListCursor *cursor, void *elem);
+
+// 将other中[from, to)位置上的节点移到list的index位置上，不复制元素也不分配节点。
+// list：环链表。
+// index：移入的首个元素在list中的位置。
+// other：移出节点的环链表，须与list元素大小相同，且共享同一个节点池或都不使用节点池。
+// from：移出的首个元素在other中的位置。
+// to：移出的最后一个元素在other中的下一个位置。
+// 时间复杂度：O(m)，m为index、from、to离各自链表两端的最近距离，在两端移动为O(1)
+// 空间复杂度：O(1)
+// 返回1: 越界。
+// 返回3: 两个环链表的节点不能互相移动。
+int circleLinkedList_splice(CircleLinkedList *list, size_t index, CircleLinkedList *other, size_t from, size_t to);
+
+// 将list中index及之后的节点移到other尾部。
+// list：环链表。
+// index：移出的首个元素位置。
+// other：接收节点的环链表，须与list元素大小相同，且共享同一个节点池或都不使用节点池。
+// 时间复杂度：O(m)，m为index离两端的最近距离
+// 空间复杂度：O(1)
+// 返回1: 越界。
+// 返回3: 两个环链表的节点不能互相移动。
+int circleLinkedList_split(CircleLinkedList *list, size_t index, CircleLinkedList *other);
+
+// 将other的全部节点移到list尾部，other被清空。
+// list：环链表。
+// other：被链接的环链表，须与list元素大小相同，且共享同一个节点池或都不使用节点池。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+// 返回3: 两个环链表的节点不能互相移动。
+int circleLinkedList_concat(CircleLinkedList *list, CircleLinkedList *other);
+
+// 按比较函数升序排列环链表，自底向上归并重新链接节点，元素不移动，相等元素保持原有顺序。
+// list：环链表。
+// cmp：元素比较函数。
+// ctx：传给比较函数的上下文。
+// 时间复杂度：O(n*log(n))
+// 空间复杂度：O(1)
+int circleLinkedList_sort(CircleLinkedList *list, ListElemCtxComparer cmp, void *ctx);
+
 // 打印环链表元素。
 // list：环链表。
 // f：打印输出对象。
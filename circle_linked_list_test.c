@@ -16,6 +16,7 @@
 #include <time.h>
 
 #include "circle_linked_list.c"
+#include "node_pool.c"
 
 #define TEST_LENGTH 20000
 
@@ -23,6 +24,16 @@ static int intCmp(const void *o1, const void *o2);
 
 static void intVisitor(void *p);
 
+static void testPool(void);
+
+static void testSplice(void);
+
+static void testFinger(void);
+
+static void testSort(void);
+
+static int ctxIntCmp(const void *o1, const void *o2, void *ctx);
+
 // static size_t intToString(void *elem, char *s);
 
 int main(void) {
@@ -99,6 +110,226 @@ int main(void) {
     assert(!circleLinkedList_clear(list));
 
     circleLinkedList_free(list);
+
+    testPool();
+    testSplice();
+    testFinger();
+    testSort();
+}
+
+// 重新链接节点降序排序，与计数排序结果一致，排序后首尾与前后链接正确。
+static void testSort(void) {
+    enum {Length = 5000};
+    CircleLinkedList *list = circleLinkedList_alloc(sizeof(int));
+    int expect[Length], order = -1, elem;
+    for (int i = 0; i < Length; i++) {
+        expect[i] = rand() % 1000;
+        assert(!circleLinkedList_rpush(list, expect + i));
+    }
+    assert(circleLinkedList_at(list, Length / 2));
+    assert(!circleLinkedList_sort(list, ctxIntCmp, &order));
+    int counts[1000] = {0};
+    for (int i = 0; i < Length; i++)
+        counts[expect[i]]++;
+    for (int v = 0, i = 0; v < 1000; v++)
+        while (counts[v]--)
+            expect[i++] = v;
+    for (int i = 0; i < Length; i++)
+        assert(*(int *) circleLinkedList_at(list, i) == expect[Length - 1 - i]);
+    CircleLinkNode *node = list->firstNode;
+    for (int i = 0; i < Length; i++) {
+        assert(node->next->prev == node);
+        node = node->next;
+    }
+    assert(node == list->firstNode);
+    elem = -1;
+    assert(!circleLinkedList_rpush(list, &elem));
+    assert(!circleLinkedList_rpop(list, &elem) && elem == -1);
+    assert(!circleLinkedList_lpop(list, &elem) && elem == expect[Length - 1]);
+    assert(!circleLinkedList_clear(list));
+    assert(!circleLinkedList_sort(list, ctxIntCmp, &order));
+    elem = 1;
+    assert(!circleLinkedList_rpush(list, &elem));
+    assert(!circleLinkedList_sort(list, ctxIntCmp, &order));
+    assert(!circleLinkedList_get(list, 0, &elem) && elem == 1);
+    circleLinkedList_free(list);
+}
+
+// 局部访问与增删交替进行，定位缓存始终与数组模型一致。
+static void testFinger(void) {
+    enum {Capacity = 2000};
+    CircleLinkedList *list = circleLinkedList_alloc(sizeof(int));
+    int model[Capacity], length = 0, elem;
+    srand(2);
+    for (int r = 0; r < 20000; r++) {
+        size_t index = length ? rand() % length : 0;
+        switch (rand() % 6) {
+            case 0: // 在附近位置插入
+            case 1:
+                if (length == Capacity)
+                    break;
+                index = length && list->finger ? list->fingerIndex + rand() % 3 : index;
+                if (index > length)
+                    index = length;
+                memmove(model + index + 1, model + index, (length - index) * sizeof(int));
+                model[index] = r;
+                length++;
+                assert(!circleLinkedList_insert(list, index, &r));
+                break;
+            case 2: // 删除附近位置的元素
+                if (!length)
+                    break;
+                index = list->finger && list->fingerIndex < length ? list->fingerIndex : index;
+                assert(!circleLinkedList_getDel(list, index, &elem));
+                assert(elem == model[index]);
+                memmove(model + index, model + index + 1, (length - index - 1) * sizeof(int));
+                length--;
+                break;
+            case 3: // 两端弹出
+                if (!length)
+                    break;
+                if (r % 2) {
+                    assert(!circleLinkedList_lpop(list, &elem) && elem == model[0]);
+                    memmove(model, model + 1, --length * sizeof(int));
+                } else
+                    assert(!circleLinkedList_rpop(list, &elem) && elem == model[--length]);
+                break;
+            default: // 顺序读取一段
+                for (size_t i = index; i < length && i < index + 5; i++)
+                    assert(*(int *) circleLinkedList_at(list, i) == model[i]);
+        }
+        assert(circleLinkedList_len(list) == length);
+        if (list->finger) {
+            assert(list->fingerIndex < length);
+            assert(*(int *) list->finger->elem == model[list->fingerIndex]);
+        }
+    }
+    for (int i = 0; i < length; i++)
+        assert(!circleLinkedList_get(list, i, &elem) && elem == model[i]);
+    assert(!circleLinkedList_clear(list));
+    assert(!list->finger);
+    circleLinkedList_free(list);
+}
+
+// 随机在两个环链表间移动区间，与数组模型比较，移动后仍可正常增删。
+static void testSplice(void) {
+    enum {Capacity = 400};
+    CircleLinkedList *lists[2] = {circleLinkedList_alloc(sizeof(int)), circleLinkedList_alloc(sizeof(int))};
+    int models[2][Capacity], lengths[2] = {0, 0}, elem, res;
+    for (int i = 0; i < 100; i++) {
+        models[i % 2][lengths[i % 2]++] = i;
+        assert(!circleLinkedList_rpush(lists[i % 2], &i));
+    }
+    srand(1);
+    for (int r = 0; r < 2000; r++) {
+        int d = rand() % 2, s = !d;
+        size_t from = rand() % (lengths[s] + 1);
+        size_t to = from + rand() % (lengths[s] - from + 1);
+        size_t index = rand() % (lengths[d] + 1);
+        void *moved = from < to ? circleLinkedList_at(lists[s], from) : NULL;
+        assert(!circleLinkedList_splice(lists[d], index, lists[s], from, to));
+        if (moved)
+            assert(circleLinkedList_at(lists[d], index) == moved);
+        size_t count = to - from;
+        memmove(models[d] + index + count, models[d] + index, (lengths[d] - index) * sizeof(int));
+        memcpy(models[d] + index, models[s] + from, count * sizeof(int));
+        memmove(models[s] + from, models[s] + to, (lengths[s] - to) * sizeof(int));
+        lengths[d] += count;
+        lengths[s] -= count;
+
+        // 首尾增删检验端点是否正确。
+        if (lengths[d] < Capacity) {
+            elem = r + 1000;
+            models[d][lengths[d]++] = elem;
+            assert(!circleLinkedList_rpush(lists[d], &elem));
+        }
+        if (lengths[s]) {
+            assert(!circleLinkedList_lpop(lists[s], &res));
+            assert(res == models[s][0]);
+            memmove(models[s], models[s] + 1, --lengths[s] * sizeof(int));
+        }
+        for (int l = 0; l < 2; l++) {
+            assert(circleLinkedList_len(lists[l]) == lengths[l]);
+            ListCursor cursor;
+            circleLinkedList_iterBegin(lists[l], &cursor);
+            for (int i = 0; i < lengths[l]; i++, circleLinkedList_iterNext(lists[l], &cursor))
+                assert(*(int *) circleLinkedList_iterAt(lists[l], &cursor) == models[l][i]);
+            for (int i = lengths[l] - 1; i >= 0 && i >= lengths[l] - 3; i--)
+                assert(*(int *) circleLinkedList_at(lists[l], i) == models[l][i]);
+        }
+    }
+
+    assert(circleLinkedList_splice(lists[0], lengths[0] + 1, lists[1], 0, 0) == 1);
+    assert(circleLinkedList_splice(lists[0], 0, lists[1], 1, 0) == 1);
+    assert(circleLinkedList_splice(lists[0], 0, lists[1], 0, lengths[1] + 1) == 1);
+    assert(circleLinkedList_splice(lists[0], 0, lists[0], 0, 1) == 3);
+    assert(!circleLinkedList_split(lists[0], lengths[0] / 2, lists[1]));
+    assert(circleLinkedList_len(lists[0]) == lengths[0] / 2);
+    assert(circleLinkedList_len(lists[1]) == lengths[1] + lengths[0] - lengths[0] / 2);
+    assert(!circleLinkedList_concat(lists[0], lists[1]));
+    assert(circleLinkedList_len(lists[0]) == lengths[0] + lengths[1] && !circleLinkedList_len(lists[1]));
+    for (int i = 0; i < lengths[1]; i++)
+        assert(*(int *) circleLinkedList_at(lists[0], lengths[0] / 2 + i) == models[1][i]);
+    for (int i = lengths[0] / 2; i < lengths[0]; i++)
+        assert(*(int *) circleLinkedList_at(lists[0], lengths[1] + i) == models[0][i]);
+    assert(!circleLinkedList_rpush(lists[1], &elem));
+    assert(!circleLinkedList_get(lists[1], 0, &res) && res == elem);
+
+    // 元素大小不同或节点来源不同时不能移动。
+    CircleLinkedList *other = circleLinkedList_alloc(sizeof(long long));
+    assert(circleLinkedList_concat(lists[0], other) == 3);
+    circleLinkedList_free(other);
+    other = circleLinkedList_allocWithPool(sizeof(int), NULL);
+    assert(circleLinkedList_concat(other, lists[0]) == 3);
+    circleLinkedList_free(other);
+    circleLinkedList_free(lists[0]);
+    circleLinkedList_free(lists[1]);
+}
+
+// 从节点池分配节点：独占节点池与共享节点池。
+static void testPool(void) {
+    CircleLinkedList *list = circleLinkedList_allocWithPool(sizeof(int), NULL);
+    assert(list);
+    int elem, res;
+    for (int r = 0; r < 2; r++) {
+        for (int i = 0; i < TEST_LENGTH; i++) {
+            elem = i;
+            size_t index = rand() % (circleLinkedList_len(list) + 1u);
+            assert(!circleLinkedList_insert(list, index, &elem));
+            assert(!circleLinkedList_get(list, index, &res));
+            assert(res == elem);
+        }
+        for (int i = 0; i < TEST_LENGTH / 2; i++)
+            assert(!circleLinkedList_del(list, rand() % circleLinkedList_len(list)));
+        assert(circleLinkedList_len(list) == TEST_LENGTH / 2);
+        assert(!circleLinkedList_clear(list));
+        assert(!list->pool->slabs);
+    }
+    circleLinkedList_free(list);
+
+    NodePool *pool = nodePool_alloc(16);
+    CircleLinkedList *list0 = circleLinkedList_allocWithPool(sizeof(int), pool);
+    CircleLinkedList *list1 = circleLinkedList_allocWithPool(sizeof(int), pool);
+    assert(list0 && list1);
+    assert(!circleLinkedList_allocWithPool(sizeof(double[4]), pool));
+    for (int i = 0; i < 100; i++) {
+        assert(!circleLinkedList_rpush(list0, &i));
+        assert(!circleLinkedList_lpush(list1, &i));
+    }
+    for (int i = 0; i < 100; i++) {
+        assert(!circleLinkedList_lpop(list0, &res));
+        assert(res == i);
+        assert(!circleLinkedList_rpop(list1, &res));
+        assert(res == i);
+    }
+    void *freeNodes = pool->freeNodes;
+    assert(!circleLinkedList_rpush(list0, &elem));
+    assert(!circleLinkedList_lpop(list0, &res));
+    assert(pool->freeNodes == freeNodes); // 节点被复用
+    assert(!circleLinkedList_rpush(list1, &elem));
+    circleLinkedList_free(list0);
+    circleLinkedList_free(list1);
+    nodePool_free(pool);
 }
 
 static int intCmp(const void *o1, const void *o2) {
@@ -123,3 +354,8 @@ static void intVisitor(void *p) {
     strncpy(s, buf, len);
     return len;
 }*/
+
+static int ctxIntCmp(const void *o1, const void *o2, void *ctx) {
+    int n1 = *(const int *) o1, n2 = *(const int *) o2;
+    return ((n1 > n2) - (n1 < n2)) * *(int *) ctx;
+}
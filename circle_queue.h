@@ -13,6 +13,10 @@
 #ifndef CLIB_CIRCLE_QUEUE_H
 #define CLIB_CIRCLE_QUEUE_H
 
+#include <limits.h>
+#include <signal.h>
+#include <stdlib.h>
+
 // 环形队列（FILO）
 typedef struct {
     void *array;
@@ -55,4 +59,50 @@ void circleQueue_free(CircleQueue *queue);
 // 空间复杂度：O(1)
 size_t circleQueue_len(const CircleQueue *queue);
 
+// 生成元素类型为T的环形队列类型Name及其static inline操作函数，元素大小是编译期常量，投递和取出直接赋值而不调用memcpy。
+// 函数名为Name_加上同名circleQueue_*函数的名字，参数与返回值相同，只是元素指针为T *，alloc无需元素大小。
+// 同时定义元素类型Name_Elem，使用时以分号结尾，例如：CLIB_CIRCLE_QUEUE_DEFINE(IntQueue, int);
+#define CLIB_CIRCLE_QUEUE_DEFINE(Name, T)                                                                            \
+    typedef struct {                                                                                                 \
+        T *array;                                                                                                    \
+        unsigned long long length, head, tail;                                                                       \
+    } Name;                                                                                                          \
+                                                                                                                     \
+    static inline Name *Name##_alloc(size_t queueLength) {                                                           \
+        if (queueLength >= ULLONG_MAX) raise(SIGABRT);                                                               \
+        Name *queue = malloc(sizeof(Name));                                                                          \
+        queue->length = queueLength;                                                                                 \
+        queue->array = malloc(sizeof(T) * queueLength);                                                              \
+        queue->head = queue->tail = 0;                                                                               \
+        return queue;                                                                                                \
+    }                                                                                                                \
+                                                                                                                     \
+    static inline int Name##_into(Name *queue, const T *elem) {                                                      \
+        if (queue == NULL) return 2;                                                                                 \
+        if ((queue->head - queue->tail) >= queue->length) return 1;                                                  \
+        queue->array[queue->head % queue->length] = *elem;                                                           \
+        queue->head++;                                                                                               \
+        return 0;                                                                                                    \
+    }                                                                                                                \
+                                                                                                                     \
+    static inline int Name##_exit(Name *queue, T *elem) {                                                            \
+        if (queue == NULL) return 2;                                                                                 \
+        if (queue->tail == queue->head) return 1;                                                                    \
+        *elem = queue->array[queue->tail % queue->length];                                                           \
+        queue->tail++;                                                                                               \
+        return 0;                                                                                                    \
+    }                                                                                                                \
+                                                                                                                     \
+    static inline void Name##_free(Name *queue) {                                                                    \
+        free(queue->array);                                                                                          \
+        free(queue);                                                                                                 \
+    }                                                                                                                \
+                                                                                                                     \
+    static inline size_t Name##_len(const Name *queue) {                                                             \
+        if (queue == NULL) return 0;                                                                                 \
+        return queue->head - queue->tail;                                                                            \
+    }                                                                                                                \
+                                                                                                                     \
+    typedef T Name##_Elem
+
 #endif //CLIB_CIRCLE_QUEUE_H
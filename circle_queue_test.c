@@ -15,6 +15,8 @@
 
 #include "circle_queue.c"
 
+CLIB_CIRCLE_QUEUE_DEFINE(IntQueue, int);
+
 int main(void) {
     CircleQueue *queue = circleQueue_alloc(sizeof(int), 10);
     int elem;
@@ -32,4 +34,25 @@ int main(void) {
     }
     assert(circleQueue_exit(queue, &elem) == 1);
     circleQueue_free(queue);
+
+    // 类型化环形队列，多次绕过数组末尾。
+    IntQueue *typed = IntQueue_alloc(10);
+    for (int round = 0; round < 3; round++) {
+        for (int i = 0; i < 7; i++) {
+            elem = round * 7 + i;
+            assert(!IntQueue_into(typed, &elem));
+        }
+        assert(IntQueue_len(typed) == 7);
+        for (int i = 0; i < 7; i++) {
+            assert(!IntQueue_exit(typed, &elem));
+            assert(elem == round * 7 + i);
+        }
+    }
+    for (int i = 0; i < 10; i++)
+        assert(!IntQueue_into(typed, &i));
+    assert(IntQueue_into(typed, &elem) == 1);
+    assert(IntQueue_len(NULL) == 0 && IntQueue_into(NULL, &elem) == 2);
+    while (!IntQueue_exit(typed, &elem));
+    assert(IntQueue_len(typed) == 0);
+    IntQueue_free(typed);
 }
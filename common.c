@@ -11,6 +11,7 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 
 void *pointerAdd(void *p1, size_t delta) {
     unsigned long long ptr = (unsigned long long) p1;
@@ -29,3 +30,344 @@ unsigned long long pointerDiff(void *p0, void *p1) {
     unsigned long long ptr1 = (unsigned long long) p1;
     return ptr0 - ptr1;
 }
+
+void memorySwap(void *p0, void *p1, size_t size) {
+    unsigned char tmp[64];
+    unsigned char *b0 = p0, *b1 = p1;
+    while (size) {
+        size_t n = size < sizeof(tmp) ? size : sizeof(tmp);
+        memcpy(tmp, b0, n);
+        memcpy(b0, b1, n);
+        memcpy(b1, tmp, n);
+        b0 += n, b1 += n, size -= n;
+    }
+}
+
+// 快速排序分段不超过该长度时改用插入排序，归并排序以该长度为初始段。
+#define SORT_SMALL 16
+
+typedef int SortComparer(const void *e1, const void *e2, void *ctx);
+
+static void sortSwap(unsigned char *p0, unsigned char *p1, size_t size) {
+    if (size == sizeof(unsigned int)) {
+        unsigned int tmp;
+        memcpy(&tmp, p0, sizeof(tmp));
+        memcpy(p0, p1, sizeof(tmp));
+        memcpy(p1, &tmp, sizeof(tmp));
+    } else if (size == sizeof(unsigned long long)) {
+        unsigned long long tmp;
+        memcpy(&tmp, p0, sizeof(tmp));
+        memcpy(p0, p1, sizeof(tmp));
+        memcpy(p1, &tmp, sizeof(tmp));
+    } else {
+        memorySwap(p0, p1, size);
+    }
+}
+
+// 稳定，相等元素不交换。
+static void insertionSort(unsigned char *base, size_t count, size_t size, SortComparer *cmp, void *ctx) {
+    for (size_t i = 1; i < count; i++)
+        for (size_t j = i; j > 0 && cmp(base + (j - 1) * size, base + j * size, ctx) > 0; j--)
+            sortSwap(base + (j - 1) * size, base + j * size, size);
+}
+
+static void siftDown(unsigned char *base, size_t root, size_t count, size_t size, SortComparer *cmp, void *ctx) {
+    for (size_t child; (child = root * 2 + 1) < count; root = child) {
+        if (child + 1 < count && cmp(base + child * size, base + (child + 1) * size, ctx) < 0)
+            child++;
+        if (cmp(base + root * size, base + child * size, ctx) >= 0)
+            return;
+        sortSwap(base + root * size, base + child * size, size);
+    }
+}
+
+static void heapSort(unsigned char *base, size_t count, size_t size, SortComparer *cmp, void *ctx) {
+    for (size_t i = count / 2; i > 0; i--)
+        siftDown(base, i - 1, count, size, cmp, ctx);
+    for (size_t i = count - 1; i > 0; i--) {
+        sortSwap(base, base + i * size, size);
+        siftDown(base, 0, i, size, cmp, ctx);
+    }
+}
+
+// 三数取中作为枢轴，与枢轴相等的元素两侧都停下交换，大量重复元素时仍均分；递归较短的一侧，深度耗尽时改用堆排序。
+static void introSort(unsigned char *base, size_t count, size_t size, SortComparer *cmp, void *ctx, size_t depth) {
+    while (count > SORT_SMALL) {
+        if (!depth--) {
+            heapSort(base, count, size, cmp, ctx);
+            return;
+        }
+        unsigned char *a = base + size, *b = base + count / 2 * size, *c = base + (count - 1) * size;
+        if (cmp(a, b, ctx) > 0)
+            sortSwap(a, b, size);
+        if (cmp(b, c, ctx) > 0) {
+            sortSwap(b, c, size);
+            if (cmp(a, b, ctx) > 0)
+                sortSwap(a, b, size);
+        }
+        sortSwap(base, b, size);
+
+        size_t i = 0, j = count;
+        for (;;) {
+            do i++; while (i < count && cmp(base + i * size, base, ctx) < 0);
+            do j--; while (cmp(base + j * size, base, ctx) > 0);
+            if (i >= j)
+                break;
+            sortSwap(base + i * size, base + j * size, size);
+        }
+        sortSwap(base, base + j * size, size);
+
+        if (j < count - j - 1) {
+            introSort(base, j, size, cmp, ctx, depth);
+            base += (j + 1) * size;
+            count -= j + 1;
+        } else {
+            introSort(base + (j + 1) * size, count - j - 1, size, cmp, ctx, depth);
+            count = j;
+        }
+    }
+    insertionSort(base, count, size, cmp, ctx);
+}
+
+// 不稳定排序，内省排序，最坏O(n*log(n))，不分配内存。
+void memorySort(void *base, size_t count, size_t size, SortComparer *cmp, void *ctx) {
+    size_t depth = 0;
+    for (size_t n = count; n > 1; n >>= 1)
+        depth += 2;
+    introSort(base, count, size, cmp, ctx, depth);
+}
+
+// 稳定合并有序的a与b到dst，相等元素a在前；a末尾不大于b开头时整段复制。
+void memoryMerge(const void *a, size_t na, const void *b, size_t nb, void *dst, size_t size, SortComparer *cmp,
+                 void *ctx) {
+    const unsigned char *pa = a, *pb = b;
+    unsigned char *out = dst;
+    if (!na || !nb || cmp(pa + (na - 1) * size, pb, ctx) <= 0) {
+        memcpy(out, pa, na * size);
+        memcpy(out + na * size, pb, nb * size);
+        return;
+    }
+    const unsigned char *ea = pa + na * size, *eb = pb + nb * size;
+    while (pa < ea && pb < eb) {
+        if (cmp(pb, pa, ctx) < 0) {
+            memcpy(out, pb, size);
+            pb += size;
+        } else {
+            memcpy(out, pa, size);
+            pa += size;
+        }
+        out += size;
+    }
+    memcpy(out, pa, ea - pa);
+    memcpy(out + (ea - pa), pb, eb - pb);
+}
+
+// 稳定合并a与b时，前k个输出中来自a的元素个数，二分查找，用于把一次合并切分成互不相交的几段。
+size_t memoryMergeSplit(const void *a, size_t na, const void *b, size_t nb, size_t k, size_t size, SortComparer *cmp,
+                        void *ctx) {
+    const unsigned char *pa = a, *pb = b;
+    size_t lo = k > nb ? k - nb : 0, hi = k < na ? k : na;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (cmp(pa + mid * size, pb + (k - mid - 1) * size, ctx) <= 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+// 稳定排序，自底向上归并排序，buf为与数据等长的缓冲区。
+void memorySortStableWithBuffer(void *base, size_t count, size_t size, SortComparer *cmp, void *ctx, void *buf) {
+    unsigned char *src = base, *dst = buf;
+    for (size_t lo = 0; lo < count; lo += SORT_SMALL)
+        insertionSort(src + lo * size, count - lo < SORT_SMALL ? count - lo : SORT_SMALL, size, cmp, ctx);
+    for (size_t width = SORT_SMALL; width < count; width *= 2) {
+        for (size_t lo = 0; lo < count; lo += 2 * width) {
+            size_t mid = count - lo < width ? count : lo + width;
+            size_t hi = count - mid < width ? count : mid + width;
+            memoryMerge(src + lo * size, mid - lo, src + mid * size, hi - mid, dst + lo * size, size, cmp, ctx);
+        }
+        unsigned char *tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+    if (src != base)
+        memcpy(base, src, count * size);
+}
+
+// 稳定排序，自底向上归并排序，需要与数据等长的缓冲区。
+// 返回2: 内存不足。
+int memorySortStable(void *base, size_t count, size_t size, SortComparer *cmp, void *ctx) {
+    if (count <= SORT_SMALL) {
+        insertionSort(base, count, size, cmp, ctx);
+        return 0;
+    }
+    void *buf = malloc(count * size);
+    if (buf == NULL)
+        return 2;
+    memorySortStableWithBuffer(base, count, size, cmp, ctx, buf);
+    free(buf);
+    return 0;
+}
+
+// 链式节点，next须为节点首个成员。
+typedef struct SortNode {
+    struct SortNode *next;
+} SortNode;
+
+static SortNode *mergeChains(SortNode *a, SortNode *b, size_t elemOffset, SortComparer *cmp, void *ctx) {
+    SortNode *head = NULL, **tail = &head;
+    while (a && b) {
+        if (cmp(pointerAdd(b, elemOffset), pointerAdd(a, elemOffset), ctx) < 0) {
+            *tail = b;
+            b = b->next;
+        } else {
+            *tail = a;
+            a = a->next;
+        }
+        tail = &(*tail)->next;
+    }
+    *tail = a ? a : b;
+    return head;
+}
+
+// 稳定排序以NULL结尾的链，只修改next，返回新的首节点。
+// 第i个待合并链长为2^i，每来一个节点像二进制加一那样逐级合并，只需O(log(n))个链头。
+// elemOffset：元素值相对节点首地址的偏移，节点首个成员须为next指针。
+void *chainSort(void *head, size_t elemOffset, SortComparer *cmp, void *ctx) {
+    SortNode *pending[sizeof(size_t) * 8] = {0};
+    SortNode *node = head;
+    while (node) {
+        SortNode *carry = node;
+        node = node->next;
+        carry->next = NULL;
+        size_t i = 0;
+        for (; pending[i]; i++) {
+            carry = mergeChains(pending[i], carry, elemOffset, cmp, ctx);
+            pending[i] = NULL;
+        }
+        pending[i] = carry;
+    }
+    SortNode *result = NULL;
+    for (size_t i = 0; i < sizeof(pending) / sizeof(pending[0]); i++)
+        if (pending[i])
+            result = mergeChains(pending[i], result, elemOffset, cmp, ctx);
+    return result;
+}
+
+// 逐个元素比较键，定宽键读成整数比较，避免每个元素调用memcmp。
+static size_t findScalar(const unsigned char *p, size_t count, size_t stride, const void *key, size_t keySize) {
+    if (keySize == sizeof(unsigned int)) {
+        unsigned int k, v;
+        memcpy(&k, key, sizeof(k));
+        for (size_t i = 0; i < count; i++, p += stride) {
+            memcpy(&v, p, sizeof(v));
+            if (v == k)
+                return i;
+        }
+    } else if (keySize == sizeof(unsigned long long)) {
+        unsigned long long k, v;
+        memcpy(&k, key, sizeof(k));
+        for (size_t i = 0; i < count; i++, p += stride) {
+            memcpy(&v, p, sizeof(v));
+            if (v == k)
+                return i;
+        }
+    } else {
+        for (size_t i = 0; i < count; i++, p += stride)
+            if (!memcmp(p, key, keySize))
+                return i;
+    }
+    return count;
+}
+
+#if defined(__x86_64__) && defined(__GNUC__)
+
+#include <immintrin.h>
+
+// 紧密排列的4、8、16字节键，一次比较一个向量寄存器中的多个键，按字节位置前进以免每轮做除法。
+// 先按32位或64位比较，16字节键再把两半的结果相与，掩码中某键对应的位全为1才算命中。
+
+static size_t findSse2(const unsigned char *p, size_t count, const void *key, size_t keySize) {
+    __m128i k;
+    if (keySize == 4) {
+        int v;
+        memcpy(&v, key, sizeof(v));
+        k = _mm_set1_epi32(v);
+    } else if (keySize == 8) {
+        long long v;
+        memcpy(&v, key, sizeof(v));
+        k = _mm_set1_epi64x(v);
+    } else {
+        k = _mm_loadu_si128(key);
+    }
+    size_t bytes = count * keySize, i = 0;
+    for (; i + sizeof(k) <= bytes; i += sizeof(k)) {
+        __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *) (p + i)), k);
+        if (keySize >= 8)
+            eq = _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+        if (keySize == 16)
+            eq = _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(1, 0, 3, 2)));
+        unsigned int mask = _mm_movemask_epi8(eq);
+        if (mask)
+            return (i + __builtin_ctz(mask)) / keySize;
+    }
+    return i / keySize + findScalar(p + i, count - i / keySize, keySize, key, keySize);
+}
+
+__attribute__((target("avx2"))) static size_t findAvx2(const unsigned char *p, size_t count, const void *key,
+                                                        size_t keySize) {
+    __m256i k;
+    if (keySize == 4) {
+        int v;
+        memcpy(&v, key, sizeof(v));
+        k = _mm256_set1_epi32(v);
+    } else if (keySize == 8) {
+        long long v;
+        memcpy(&v, key, sizeof(v));
+        k = _mm256_set1_epi64x(v);
+    } else {
+        k = _mm256_broadcastsi128_si256(_mm_loadu_si128(key));
+    }
+    // 每轮比较两个向量，未命中时只判断一次。
+    size_t bytes = count * keySize, i = 0;
+    for (; i + 2 * sizeof(k) <= bytes; i += 2 * sizeof(k)) {
+        __m256i v0 = _mm256_loadu_si256((const __m256i *) (p + i));
+        __m256i v1 = _mm256_loadu_si256((const __m256i *) (p + i + sizeof(k)));
+        __m256i eq0, eq1;
+        if (keySize == 4) {
+            eq0 = _mm256_cmpeq_epi32(v0, k);
+            eq1 = _mm256_cmpeq_epi32(v1, k);
+        } else {
+            eq0 = _mm256_cmpeq_epi64(v0, k);
+            eq1 = _mm256_cmpeq_epi64(v1, k);
+        }
+        if (keySize == 16) {
+            eq0 = _mm256_and_si256(eq0, _mm256_shuffle_epi32(eq0, _MM_SHUFFLE(1, 0, 3, 2)));
+            eq1 = _mm256_and_si256(eq1, _mm256_shuffle_epi32(eq1, _MM_SHUFFLE(1, 0, 3, 2)));
+        }
+        __m256i any = _mm256_or_si256(eq0, eq1);
+        if (_mm256_testz_si256(any, any))
+            continue;
+        unsigned long long mask = (unsigned int) _mm256_movemask_epi8(eq0) |
+                                  (unsigned long long) (unsigned int) _mm256_movemask_epi8(eq1) << 32;
+        return (i + __builtin_ctzll(mask)) / keySize;
+    }
+    return i / keySize + findSse2(p + i, count - i / keySize, key, keySize);
+}
+
+#endif
+
+// 在count个相隔stride字节的元素中，查找offset处keySize字节与key逐字节相等的首个元素。
+// 紧密排列的4、8、16字节键在x86-64上按运行时检测到的指令集使用AVX2或SSE2比较，其余情况逐个比较。
+// 返回首个相等元素的序号，未找到返回count。
+size_t memoryFind(const void *base, size_t count, size_t stride, size_t offset, const void *key, size_t keySize) {
+    const unsigned char *p = base;
+    p += offset;
+#if defined(__x86_64__) && defined(__GNUC__)
+    if (stride == keySize && (keySize == 4 || keySize == 8 || keySize == 16))
+        return __builtin_cpu_supports("avx2") ? findAvx2(p, count, key, keySize) : findSse2(p, count, key, keySize);
+#endif
+    return findScalar(p, count, stride, key, keySize);
+}
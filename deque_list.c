@@ -0,0 +1,373 @@
+/*
+ * Copyright (c) 2023 ivfzhou
+ * clib is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+
+#include <string.h>
+
+#include "deque_list.h"
+
+// 首次分配的容量。
+const static size_t InitCapacity = 8;
+
+// 元素个数不超过该值时不缩容。
+const static size_t ShrinkThreshold = 256;
+
+// 默认容量策略，容量须为2的幂，growFactor不起作用，总是成倍扩容。
+const static ListGrowthPolicy DefaultPolicy = {
+        .initCapacity = 0,
+        .growFactor = 2,
+        .shrinkFactor = 4,
+        .neverShrink = 0,
+};
+
+extern void *pointerAdd(void *p1, size_t delta);
+
+extern void memorySwap(void *p0, void *p1, size_t size);
+
+extern size_t memoryFind(const void *base, size_t count, size_t stride, size_t offset, const void *key,
+                         size_t keySize);
+
+// 获取第index个元素的地址。
+static void *slot(const DequeList *list, size_t index);
+
+// 容量翻倍。
+static int expand(DequeList *list);
+
+// 判断是否需要缩容。
+static _Bool needReduce(const DequeList *list);
+
+// 缩容，与顺序表相同保留一半空闲区间。
+static void reduce(DequeList *list);
+
+// 重新分配容量，capacity须为2的幂且不小于元素个数，缩容时元素重排到缓冲区首部。
+static int resize(DequeList *list, size_t capacity);
+
+// 不小于count的最小的2的幂，至少为InitCapacity。
+static size_t roundCapacity(size_t count);
+
+// 把缓冲区位置src起的count个元素移到位置dst起，dst与src在环上相邻，按连续段调用memmove。
+static void moveElems(DequeList *list, size_t dst, size_t src, size_t count);
+
+DequeList *dequeList_alloc(size_t elemSize) {
+    return dequeList_allocWithPolicy(elemSize, NULL);
+}
+
+DequeList *dequeList_allocWithPolicy(size_t elemSize, const ListGrowthPolicy *policy) {
+    DequeList *list = malloc(sizeof(DequeList));
+    list->elemSize = elemSize;
+    list->length = list->capacity = list->head = 0;
+    list->elems = NULL;
+    list->policy = policy ? *policy : DefaultPolicy;
+    return list;
+}
+
+void dequeList_free(DequeList *list) {
+    free(list->elems);
+    list->elems = NULL;
+    list->length = list->capacity = list->head = 0;
+    free(list);
+}
+
+size_t dequeList_len(const DequeList *list) {
+    return list->length;
+}
+
+int dequeList_get(const DequeList *list, size_t index, void *elem) {
+    if (index >= list->length)
+        return 1;
+    memcpy(elem, slot(list, index), list->elemSize);
+    return 0;
+}
+
+int dequeList_insert(DequeList *list, size_t index, const void *elem) {
+    if (index > list->length)
+        return 1;
+    if (list->length == list->capacity && expand(list))
+        return 2;
+
+    size_t mask = list->capacity - 1;
+    if (index < list->length - index) { // 前段左移一位
+        list->head = (list->head - 1) & mask;
+        moveElems(list, list->head, (list->head + 1) & mask, index);
+    } else { // 后段右移一位
+        size_t from = (list->head + index) & mask;
+        moveElems(list, (from + 1) & mask, from, list->length - index);
+    }
+    memcpy(slot(list, index), elem, list->elemSize);
+
+    list->length++;
+    return 0;
+}
+
+int dequeList_del(DequeList *list, size_t index) {
+    if (index >= list->length)
+        return 1;
+
+    size_t mask = list->capacity - 1;
+    if (index < list->length - index - 1) { // 前段右移一位
+        moveElems(list, (list->head + 1) & mask, list->head, index);
+        list->head = (list->head + 1) & mask;
+    } else { // 后段左移一位
+        size_t to = (list->head + index) & mask;
+        moveElems(list, to, (to + 1) & mask, list->length - index - 1);
+    }
+
+    list->length--;
+    if (needReduce(list))
+        reduce(list);
+    return 0;
+}
+
+int dequeList_locate(const DequeList *list, ListElemComparer cmp, const void *elem, size_t *index) {
+    for (size_t i = 0; i < list->length; i++) {
+        if (!cmp(slot(list, i), elem)) {
+            *index = i;
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int dequeList_locateKey(const DequeList *list, size_t offset, const void *key, size_t keySize, size_t *index) {
+    if (!list->length || offset > list->elemSize || keySize > list->elemSize - offset)
+        return 1;
+    size_t first = list->capacity - list->head;
+    if (first > list->length)
+        first = list->length;
+    size_t i = memoryFind(slot(list, 0), first, list->elemSize, offset, key, keySize);
+    if (i == first && first < list->length)
+        i += memoryFind(list->elems, list->length - first, list->elemSize, offset, key, keySize);
+    if (i == list->length)
+        return 1;
+    *index = i;
+    return 0;
+}
+
+int dequeList_travel(const DequeList *list, ListElemVisitor visit) {
+    for (size_t i = 0; i < list->length; i++)
+        visit(slot(list, i));
+    return 0;
+}
+
+int dequeList_locateCtx(const DequeList *list, ListElemCtxComparer cmp, const void *elem, void *ctx, size_t *index) {
+    for (size_t i = 0; i < list->length; i++) {
+        if (!cmp(slot(list, i), elem, ctx)) {
+            *index = i;
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int dequeList_travelCtx(const DequeList *list, ListElemCtxVisitor visit, void *ctx) {
+    for (size_t i = 0; i < list->length; i++) {
+        int res = visit(slot(list, i), ctx);
+        if (res)
+            return res;
+    }
+    return 0;
+}
+
+int dequeList_clear(DequeList *list) {
+    free(list->elems);
+    list->elems = NULL;
+    list->length = list->capacity = list->head = 0;
+    return 0;
+}
+
+int dequeList_rpop(DequeList *list, void *elem) {
+    if (!list->length)
+        return 1;
+    list->length--;
+    memcpy(elem, slot(list, list->length), list->elemSize);
+    if (needReduce(list))
+        reduce(list);
+    return 0;
+}
+
+int dequeList_lpush(DequeList *list, const void *elem) {
+    if (list->length == list->capacity && expand(list))
+        return 2;
+    list->head = (list->head - 1) & (list->capacity - 1);
+    memcpy(slot(list, 0), elem, list->elemSize);
+    list->length++;
+    return 0;
+}
+
+int dequeList_rpush(DequeList *list, const void *elem) {
+    if (list->length == list->capacity && expand(list))
+        return 2;
+    memcpy(slot(list, list->length), elem, list->elemSize);
+    list->length++;
+    return 0;
+}
+
+int dequeList_lpop(DequeList *list, void *elem) {
+    if (!list->length)
+        return 1;
+    memcpy(elem, slot(list, 0), list->elemSize);
+    list->head = (list->head + 1) & (list->capacity - 1);
+    list->length--;
+    if (needReduce(list))
+        reduce(list);
+    return 0;
+}
+
+int dequeList_set(DequeList *list, size_t index, const void *elem) {
+    if (index >= list->length)
+        return 1;
+    memcpy(slot(list, index), elem, list->elemSize);
+    return 0;
+}
+
+int dequeList_getDel(DequeList *list, size_t index, void *elem) {
+    if (index >= list->length)
+        return 1;
+    memcpy(elem, slot(list, index), list->elemSize);
+    return dequeList_del(list, index);
+}
+
+int dequeList_getSet(DequeList *list, size_t index, void *elem) {
+    if (index >= list->length)
+        return 1;
+    memorySwap(slot(list, index), elem, list->elemSize);
+    return 0;
+}
+
+int dequeList_reserve(DequeList *list, size_t capacity) {
+    if (capacity <= list->capacity)
+        return 0;
+    return resize(list, roundCapacity(capacity));
+}
+
+int dequeList_shrinkToFit(DequeList *list) {
+    if (!list->length)
+        return resize(list, 0);
+    size_t capacity = roundCapacity(list->length);
+    if (capacity < list->capacity)
+        return resize(list, capacity);
+    return 0;
+}
+
+void *dequeList_at(const DequeList *list, size_t index) {
+    if (index >= list->length)
+        return NULL;
+    return slot(list, index);
+}
+
+int dequeList_fprint(const DequeList *list, FILE *f, ListElemToString str, size_t sizeOfElem) {
+    fprintf(f, "[");
+    char s[sizeOfElem + 1];
+    for (size_t i = 0; i < list->length; i++) {
+        size_t len = str(slot(list, i), s);
+        s[len] = '\0';
+        fprintf(f, i ? ", %s" : "%s", s);
+    }
+    fprintf(f, "]");
+    fflush(f);
+    return 0;
+}
+
+static void *slot(const DequeList *list, size_t index) {
+    return pointerAdd(list->elems, ((list->head + index) & (list->capacity - 1)) * list->elemSize);
+}
+
+static int expand(DequeList *list) {
+    if (!list->capacity && list->policy.initCapacity)
+        return resize(list, roundCapacity(list->policy.initCapacity));
+    return resize(list, list->capacity ? list->capacity * 2 : InitCapacity);
+}
+
+static _Bool needReduce(const DequeList *list) {
+    return !list->policy.neverShrink && list->length > ShrinkThreshold &&
+           list->length * list->policy.shrinkFactor <= list->capacity;
+}
+
+static void reduce(DequeList *list) {
+    size_t capacity = roundCapacity((size_t) (list->length * list->policy.shrinkFactor / 2));
+    if (capacity < list->capacity)
+        resize(list, capacity);
+}
+
+// 扩容时realloc后把绕回缓冲区首部的那段元素接到原缓冲区末尾之后，保持元素连续；
+// 缩容时元素分至多两段复制到新缓冲区首部。
+static int resize(DequeList *list, size_t capacity) {
+    if (!capacity) {
+        free(list->elems);
+        list->elems = NULL;
+        list->capacity = list->head = 0;
+        return 0;
+    }
+    if (capacity > list->capacity) {
+        void *elems = realloc(list->elems, capacity * list->elemSize);
+        if (elems == NULL)
+            return 2;
+        list->elems = elems;
+        if (list->head + list->length > list->capacity) {
+            size_t wrapped = list->head + list->length - list->capacity;
+            memcpy(pointerAdd(list->elems, list->capacity * list->elemSize), list->elems,
+                   wrapped * list->elemSize);
+        }
+        list->capacity = capacity;
+        return 0;
+    }
+    void *elems = malloc(capacity * list->elemSize);
+    if (elems == NULL)
+        return 2;
+    size_t first = list->capacity - list->head;
+    if (first > list->length)
+        first = list->length;
+    memcpy(elems, slot(list, 0), first * list->elemSize);
+    memcpy(pointerAdd(elems, first * list->elemSize), list->elems, (list->length - first) * list->elemSize);
+    free(list->elems);
+    list->elems = elems;
+    list->capacity = capacity;
+    list->head = 0;
+    return 0;
+}
+
+static size_t roundCapacity(size_t count) {
+    size_t capacity = InitCapacity;
+    while (capacity < count)
+        capacity *= 2;
+    return capacity;
+}
+
+// 右移时从末尾往前、左移时从首部往后逐段移动，每段内src与dst都不绕回，至多三段。
+static void moveElems(DequeList *list, size_t dst, size_t src, size_t count) {
+    size_t capacity = list->capacity, size = list->elemSize;
+    if (dst == ((src + 1) & (capacity - 1))) {
+        size_t srcEnd = (src + count) & (capacity - 1), dstEnd = (dst + count) & (capacity - 1);
+        while (count) {
+            size_t n = srcEnd ? srcEnd : capacity;
+            if (dstEnd && dstEnd < n)
+                n = dstEnd;
+            if (count < n)
+                n = count;
+            srcEnd = (srcEnd ? srcEnd : capacity) - n;
+            dstEnd = (dstEnd ? dstEnd : capacity) - n;
+            memmove(pointerAdd(list->elems, dstEnd * size), pointerAdd(list->elems, srcEnd * size), n * size);
+            count -= n;
+        }
+    } else {
+        while (count) {
+            size_t n = capacity - src;
+            if (capacity - dst < n)
+                n = capacity - dst;
+            if (count < n)
+                n = count;
+            memmove(pointerAdd(list->elems, dst * size), pointerAdd(list->elems, src * size), n * size);
+            src = (src + n) & (capacity - 1);
+            dst = (dst + n) & (capacity - 1);
+            count -= n;
+        }
+    }
+}
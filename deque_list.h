@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2023 ivfzhou
+ * clib is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+
+#ifndef CLIB_DEQUE_LIST_H
+#define CLIB_DEQUE_LIST_H
+
+#include <stdlib.h>
+
+#include "list.h"
+
+// 双端队列线性表，元素存放在容量为2的幂的环形缓冲区中。
+typedef struct {
+    size_t length, capacity, elemSize;
+    size_t head; // 首元素在缓冲区中的位置
+    void *elems;
+    ListGrowthPolicy policy;
+} DequeList;
+
+// 新建双端队列。
+// elemSize：每个元素占用的字节大小。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+DequeList *dequeList_alloc(size_t elemSize);
+
+// 按容量策略新建双端队列。容量总为2的幂：initCapacity向上取整，growFactor不起作用，总是成倍扩容；
+// 删除元素后按shrinkFactor与neverShrink缩容。
+// elemSize：每个元素占用的字节大小。
+// policy：容量策略，NULL表示默认策略。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+DequeList *dequeList_allocWithPolicy(size_t elemSize, const ListGrowthPolicy *policy);
+
+// 销毁双端队列。
+// list：双端队列。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+void dequeList_free(DequeList *list);
+
+// 获取双端队列中元素个数。
+// list：双端队列。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+size_t dequeList_len(const DequeList *list);
+
+// 获取双端队列中某个位置的元素。
+// list：双端队列。
+// index：元素所在位置。
+// elem：元素值塞入elem中。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+// 返回1: 越界。
+int dequeList_get(const DequeList *list, size_t index, void *elem);
+
+// 向双端队列中插入元素，移动元素较少的一侧。
+// list：双端队列。
+// index：元素插入位置。
+// elem：被插入的元素。
+// 时间复杂度：O(min(index, n-index))
+// 空间复杂度：O(1)
+// 返回1: 越界。
+// 返回2: 内存不足。
+int dequeList_insert(DequeList *list, size_t index, const void *elem);
+
+// 删除双端队列中某个位置的元素，移动元素较少的一侧。
+// list：双端队列。
+// index：元素所在位置。
+// 时间复杂度：O(min(index, n-index))
+// 空间复杂度：O(1)
+// 返回1: 越界。
+int dequeList_del(DequeList *list, size_t index);
+
+// 寻找元素在双端队列中的位置。
+// list：双端队列。
+// cmp：元素比较函数。
+// elem：要寻找的元素。
+// index：元素位置塞入index中。
+// 时间复杂度：O(n)
+// 空间复杂度：O(1)
+// 返回1: 未找到。
+int dequeList_locate(const DequeList *list, ListElemComparer cmp, const void *elem, size_t *index);
+
+// 按字节查找元素在双端队列中的位置，比较每个元素offset处的keySize个字节，不调用比较函数。
+// 缓冲区环绕时分两段连续内存比较。
+// list：双端队列。
+// offset：键在元素中的字节偏移。
+// key：要寻找的键。
+// keySize：键的字节大小。
+// index：元素位置塞入index中。
+// 时间复杂度：O(n)
+// 空间复杂度：O(1)
+// 返回1: 未找到，或键超出了元素范围。
+int dequeList_locateKey(const DequeList *list, size_t offset, const void *key, size_t keySize, size_t *index);
+
+// 遍历双端队列。
+// list：双端队列。
+// visit：遍历函数。
+// 时间复杂度：O(n)
+// 空间复杂度：O(1)
+int dequeList_travel(const DequeList *list, ListElemVisitor visit);
+
+// 带上下文查找元素在双端队列中的位置。
+// list：双端队列。
+// cmp：元素比较函数。
+// elem：要寻找的元素。
+// ctx：传给比较函数的上下文。
+// index：元素位置塞入index中。
+// 时间复杂度：O(n)
+// 空间复杂度：O(1)
+// 返回1: 未找到。
+int dequeList_locateCtx(const DequeList *list, ListElemCtxComparer cmp, const void *elem, void *ctx, size_t *index);
+
+// 带上下文遍历双端队列，遍历函数返回非0时停止。
+// list：双端队列。
+// visit：遍历函数。
+// ctx：传给遍历函数的上下文。
+// 时间复杂度：O(n)
+// 空间复杂度：O(1)
+// 返回visit的非0返回值: 遍历提前结束。
+int dequeList_travelCtx(const DequeList *list, ListElemCtxVisitor visit, void *ctx);
+
+// 清空双端队列。
+// list：双端队列。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+int dequeList_clear(DequeList *list);
+
+// 取出双端队列最右边的元素。
+// list：双端队列。
+// elem：元素值塞入elem中。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+// 返回1: 越界。
+int dequeList_rpop(DequeList *list, void *elem);
+
+// 向双端队列最左边添加元素。
+// list：双端队列。
+// elem：被添加的元素。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+int dequeList_lpush(DequeList *list, const void *elem);
+
+// 向双端队列最右边添加元素。
+// list：双端队列。
+// elem：被添加的元素。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+int dequeList_rpush(DequeList *list, const void *elem);
+
+// 取出双端队列最左边的元素。
+// list：双端队列。
+// elem：元素值塞入elem中。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+// 返回1: 越界。
+int dequeList_lpop(DequeList *list, void *elem);
+
+// 设置双端队列中某个位置的元素。
+// list：双端队列。
+// index：元素所在位置。
+// elem：被设置的元素。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+// 返回1: 越界。
+int dequeList_set(DequeList *list, size_t index, const void *elem);
+
+// 获取双端队列中某个位置的元素然后删除之。
+// list：双端队列。
+// index：元素所在位置。
+// elem：元素值塞入elem中。
+// 时间复杂度：O(min(index, n-index))
+// 空间复杂度：O(1)
+// 返回1: 越界。
+int dequeList_getDel(DequeList *list, size_t index, void *elem);
+
+// 获取双端队列中某个位置的元素然后设置新值。
+// list：双端队列。
+// index：元素所在位置。
+// elem：元素值设置进表中，然后旧值塞入elem中。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+// 返回1: 越界。
+int dequeList_getSet(DequeList *list, size_t index, void *elem);
+
+// 预留双端队列容量，之后插入元素直到容量用尽都不再重新分配内存，容量向上取整为2的幂。
+// list：双端队列。
+// capacity：至少能容纳的元素个数。
+// 时间复杂度：O(n)
+// 空间复杂度：O(n)
+// 返回2: 内存不足。
+int dequeList_reserve(DequeList *list, size_t capacity);
+
+// 将双端队列容量缩减到不小于元素个数的最小的2的幂，元素重排到缓冲区首部。
+// list：双端队列。
+// 时间复杂度：O(n)
+// 空间复杂度：O(n)
+// 返回2: 内存不足，容量与元素位置不变。
+int dequeList_shrinkToFit(DequeList *list);
+
+// 获取双端队列中元素的存储地址，可原地读写元素，插入或删除元素后地址失效。
+// list：双端队列。
+// index：元素所在位置。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+// 返回NULL: 越界。
+void *dequeList_at(const DequeList *list, size_t index);
+
+// 打印双端队列中的元素。
+// list：双端队列。
+// f：打印输出对象。
+// str：元素转字符串函数。
+// sizeOfElem：每个元素转字符串表示占用的最大字节数。
+// 时间复杂度：O(n)
+// 空间复杂度：O(1)
+int dequeList_fprint(const DequeList *list, FILE *f, ListElemToString str, size_t sizeOfElem);
+
+#endif // CLIB_DEQUE_LIST_H
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2023 ivfzhou
+ * clib is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "deque_list.c"
+
+#define TEST_LENGTH 50000
+
+static int intCmp(const void *o1, const void *o2);
+
+static void intVisitor(void *p);
+
+int main(void) {
+    DequeList *list = dequeList_alloc(sizeof(int));
+    assert(list);
+
+    int elem = 2;
+    size_t index = 0;
+    assert(!dequeList_insert(list, index, &elem));
+
+    elem = 1;
+    assert(!dequeList_lpush(list, &elem));
+
+    elem = 3;
+    assert(!dequeList_rpush(list, &elem));
+
+    assert(!dequeList_travel(list, intVisitor));
+
+    size_t length = dequeList_len(list);
+    assert(length == 3);
+
+    elem = 4;
+    assert(!dequeList_set(list, index, &elem));
+
+    assert(!dequeList_get(list, index, &elem));
+    assert(elem == 4);
+
+    elem = 3;
+    assert(!dequeList_locate(list, intCmp, &elem, &index));
+    assert(index == 2);
+
+    elem = 4;
+    assert(!dequeList_getSet(list, index, &elem));
+    assert(elem == 3);
+
+    assert(!dequeList_getDel(list, index, &elem));
+    assert(elem == 4);
+
+    assert(!dequeList_lpop(list, &elem));
+    assert(elem == 4);
+
+    assert(!dequeList_rpop(list, &elem));
+    assert(elem == 2);
+
+    assert(dequeList_lpop(list, &elem) == 1);
+    assert(dequeList_rpop(list, &elem) == 1);
+
+    // 与数组对照随机插入删除，覆盖环形缓冲区绕回的情况。
+    srand(time(NULL) + 100);
+    int *expect = malloc(sizeof(int) * TEST_LENGTH);
+    int res = 0;
+    for (int i = 0; i < TEST_LENGTH; i++) {
+        elem = i + 1;
+        length = dequeList_len(list);
+        index = rand() % (length + 1u);
+        assert(!dequeList_insert(list, index, &elem));
+        memmove(expect + index + 1, expect + index, (length - index) * sizeof(int));
+        expect[index] = elem;
+        assert(!dequeList_get(list, index, &res));
+        assert(res == elem);
+    }
+    for (size_t i = 0; i < TEST_LENGTH; i++)
+        assert(*(int *) dequeList_at(list, i) == expect[i]);
+    for (int i = 0; i < TEST_LENGTH; i++) {
+        length = dequeList_len(list);
+        index = rand() % length;
+        assert(!dequeList_getDel(list, index, &res));
+        assert(res == expect[index]);
+        memmove(expect + index, expect + index + 1, (length - index - 1) * sizeof(int));
+    }
+    free(expect);
+
+    // 作为队列使用时头尾不断绕回。
+    int next = 0;
+    for (int i = 0; i < TEST_LENGTH; i++) {
+        assert(!dequeList_lpush(list, &i));
+        if (i % 3 == 2) {
+            assert(!dequeList_rpop(list, &res) && res == next++);
+            assert(!dequeList_rpop(list, &res) && res == next++);
+        }
+    }
+    while (dequeList_len(list)) {
+        assert(!dequeList_rpop(list, &res));
+        assert(res == next++);
+    }
+    assert(next == TEST_LENGTH);
+
+    // 元素减少后缩容，容量保持为2的幂。
+    assert(list->capacity <= 1024 && !(list->capacity & (list->capacity - 1)));
+
+    // 预留与缩减容量，缓冲区绕回时元素顺序不变。
+    assert(!dequeList_reserve(list, 3000));
+    assert(list->capacity == 4096);
+    for (int i = 0; i < 1000; i++)
+        assert(!dequeList_lpush(list, &i));
+    assert(!dequeList_shrinkToFit(list));
+    assert(list->capacity == 1024);
+    for (int i = 999; i >= 0; i--)
+        assert(!dequeList_lpop(list, &res) && res == i);
+    assert(!dequeList_shrinkToFit(list));
+    assert(list->capacity == 0 && list->elems == NULL);
+
+    assert(!dequeList_clear(list));
+
+    dequeList_free(list);
+
+    // 不缩容的策略。
+    ListGrowthPolicy policy = {.initCapacity = 100, .growFactor = 2, .shrinkFactor = 4, .neverShrink = 1};
+    list = dequeList_allocWithPolicy(sizeof(int), &policy);
+    assert(!dequeList_rpush(list, &elem));
+    assert(list->capacity == 128);
+    for (int i = 0; i < TEST_LENGTH; i++)
+        assert(!dequeList_rpush(list, &i));
+    size_t capacity = list->capacity;
+    while (dequeList_len(list))
+        assert(!dequeList_lpop(list, &res));
+    assert(list->capacity == capacity);
+    dequeList_free(list);
+}
+
+static int intCmp(const void *o1, const void *o2) {
+    int *n1 = (int *) o1;
+    int *n2 = (int *) o2;
+    if (*n1 == *n2)
+        return 0;
+    return o1 > o2 ? 1 : -1;
+}
+
+static void intVisitor(void *p) {
+    static int prev = 1;
+    int i = *(int *) p;
+    assert(i == prev);
+    prev = i + 1;
+}
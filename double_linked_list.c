@@ -14,31 +14,68 @@
 
 #include "double_linked_list.h"
 
-static DoubleLinkNode *newNode(size_t size, const void *elem);
+extern void memorySwap(void *p0, void *p1, size_t size);
+
+extern void *chainSort(void *head, size_t elemOffset, ListElemCtxComparer cmp, void *ctx);
+
+static DoubleLinkNode *newNode(const DoubleLinkedList *list, const void *elem);
+
+static void freeNode(const DoubleLinkedList *list, DoubleLinkNode *node);
+
+static void freeNodes(DoubleLinkedList *list);
 
 static DoubleLinkNode *getNode(const DoubleLinkedList *list, size_t index);
 
 static DoubleLinkNode *popNode(DoubleLinkedList *list, size_t index);
 
+static DoubleLinkNode *lastNode(const DoubleLinkedList *list);
+
+static void setEnds(DoubleLinkedList *list, DoubleLinkNode *head, DoubleLinkNode *last, size_t length);
+
+static void takeChain(DoubleLinkedList *list, size_t from, size_t count, DoubleLinkNode **first,
+                      DoubleLinkNode **last);
+
+static void putChain(DoubleLinkedList *list, size_t index, DoubleLinkNode *first, DoubleLinkNode *last, size_t count);
+
+static _Bool compatible(const DoubleLinkedList *list, const DoubleLinkedList *other);
+
+static void setFinger(const DoubleLinkedList *list, size_t index, DoubleLinkNode *node);
+
+static void fingerInsert(DoubleLinkedList *list, size_t index, size_t count);
+
+static void fingerRemove(DoubleLinkedList *list, size_t index, size_t count, DoubleLinkNode *next);
+
 DoubleLinkedList *doubleLinkedList_alloc(size_t elemSize) {
     DoubleLinkedList *list = malloc(sizeof(DoubleLinkedList));
     list->elemSize = elemSize;
     list->length = 0;
-    list->head = list->tail = NULL;
+    list->head = list->tail = list->finger = NULL;
+    list->fingerIndex = 0;
+    list->pool = NULL;
+    list->ownPool = 0;
     return list;
 }
 
-void doubleLinkedList_free(DoubleLinkedList *list) {
-    DoubleLinkNode *node = list->head;
-    for (size_t i = 0; i < list->length; i++) {
-        DoubleLinkNode *tmp = node->next;
-        free(node->elem);
-        free(node);
-        node = tmp;
+DoubleLinkedList *doubleLinkedList_allocWithPool(size_t elemSize, NodePool *pool) {
+    NodePool *nodePool = pool ? pool : nodePool_alloc(0);
+    if (nodePool_bind(nodePool, sizeof(DoubleLinkNode) + elemSize)) {
+        if (!pool)
+            nodePool_free(nodePool);
+        return NULL;
     }
+    DoubleLinkedList *list = doubleLinkedList_alloc(elemSize);
+    list->pool = nodePool;
+    list->ownPool = !pool;
+    return list;
+}
+
+void doubleLinkedList_free(DoubleLinkedList *list) {
+    freeNodes(list);
+    if (list->ownPool)
+        nodePool_free(list->pool);
     list->length = 0;
     list->elemSize = 0;
-    list->head = list->tail = NULL;
+    list->head = list->tail = list->finger = NULL;
     free(list);
 }
 
@@ -57,7 +94,9 @@ int doubleLinkedList_get(const DoubleLinkedList *list, size_t index, void *elem)
 int doubleLinkedList_insert(DoubleLinkedList *list, size_t index, const void *elem) {
     if (index > list->length)
         return 1;
-    DoubleLinkNode *node = newNode(list->elemSize, elem);
+    DoubleLinkNode *node = newNode(list, elem);
+    if (node == NULL)
+        return 2;
 
     if (!list->length) { // 第一次插入
         list->head = node;
@@ -87,17 +126,17 @@ int doubleLinkedList_insert(DoubleLinkedList *list, size_t index, const void *el
         indexNode->prev->next = node;
         indexNode->prev = node;
     }
+    fingerInsert(list, index, 1);
 
     list->length++;
     return 0;
 }
 
 int doubleLinkedList_del(DoubleLinkedList *list, size_t index) {
-    if (index > list->length)
+    if (index >= list->length)
         return 1;
     DoubleLinkNode *node = popNode(list, index);
-    free(node->elem);
-    free(node);
+    freeNode(list, node);
     return 0;
 }
 
@@ -122,16 +161,33 @@ int doubleLinkedList_travel(const DoubleLinkedList *list, ListElemVisitor visit)
     return 0;
 }
 
-int doubleLinkedList_clear(DoubleLinkedList *list) {
+int doubleLinkedList_locateCtx(const DoubleLinkedList *list, ListElemCtxComparer cmp, const void *elem, void *ctx, size_t *index) {
     DoubleLinkNode *node = list->head;
     for (size_t i = 0; i < list->length; i++) {
-        DoubleLinkNode *tmp = node->next;
-        free(node->elem);
-        free(node);
-        node = tmp;
+        if (!cmp(node->elem, elem, ctx)) {
+            *index = i;
+            return 0;
+        }
+        node = node->next;
+    }
+    return 1;
+}
+
+int doubleLinkedList_travelCtx(const DoubleLinkedList *list, ListElemCtxVisitor visit, void *ctx) {
+    DoubleLinkNode *node = list->head;
+    for (size_t i = 0; i < list->length; i++) {
+        int res = visit(node->elem, ctx);
+        if (res)
+            return res;
+        node = node->next;
     }
+    return 0;
+}
+
+int doubleLinkedList_clear(DoubleLinkedList *list) {
+    freeNodes(list);
     list->length = 0;
-    list->head = list->tail = NULL;
+    list->head = list->tail = list->finger = NULL;
     return 0;
 }
 
@@ -164,8 +220,7 @@ int doubleLinkedList_getDel(DoubleLinkedList *list, size_t index, void *elem) {
         return 1;
     DoubleLinkNode *node = popNode(list, index);
     memcpy(elem, node->elem, list->elemSize);
-    free(node->elem);
-    free(node);
+    freeNode(list, node);
     return 0;
 }
 
@@ -173,11 +228,109 @@ int doubleLinkedList_getSet(DoubleLinkedList *list, size_t index, void *elem) {
     if (index >= list->length)
         return 1;
     DoubleLinkNode *node = getNode(list, index);
-    void *tmp = malloc(list->elemSize);
-    memcpy(tmp, node->elem, list->elemSize);
-    memcpy(node->elem, elem, list->elemSize);
-    memcpy(elem, tmp, list->elemSize);
-    free(tmp);
+    memorySwap(node->elem, elem, list->elemSize);
+    return 0;
+}
+
+void *doubleLinkedList_at(const DoubleLinkedList *list, size_t index) {
+    if (index >= list->length)
+        return NULL;
+    return getNode(list, index)->elem;
+}
+
+void doubleLinkedList_iterBegin(const DoubleLinkedList *list, ListCursor *cursor) {
+    cursor->index = 0;
+    cursor->node = list->length ? list->head : NULL;
+    cursor->prev = NULL;
+}
+
+int doubleLinkedList_iterNext(const DoubleLinkedList *list, ListCursor *cursor) {
+    if (cursor->index >= list->length)
+        return 1;
+    DoubleLinkNode *node = cursor->node;
+    cursor->node = ++cursor->index < list->length ? node->next : NULL;
+    return 0;
+}
+
+void *doubleLinkedList_iterAt(const DoubleLinkedList *list, const ListCursor *cursor) {
+    if (cursor->index >= list->length)
+        return NULL;
+    return ((DoubleLinkNode *) cursor->node)->elem;
+}
+
+int doubleLinkedList_iterInsertBefore(DoubleLinkedList *list, ListCursor *cursor, const void *elem) {
+    // 首尾插入不需查找节点。
+    if (!cursor->index || cursor->index >= list->length) {
+        int res = doubleLinkedList_insert(list, cursor->index, elem);
+        if (res)
+            return res;
+    } else {
+        DoubleLinkNode *indexNode = cursor->node;
+        DoubleLinkNode *node = newNode(list, elem);
+        if (node == NULL)
+            return 2;
+        node->next = indexNode;
+        node->prev = indexNode->prev;
+        indexNode->prev->next = node;
+        indexNode->prev = node;
+        fingerInsert(list, cursor->index, 1);
+        list->length++;
+    }
+    cursor->index++;
+    return 0;
+}
+
+int doubleLinkedList_iterErase(DoubleLinkedList *list, ListCursor *cursor, void *elem) {
+    if (cursor->index >= list->length)
+        return 1;
+    DoubleLinkNode *node = cursor->node;
+    DoubleLinkNode *next = cursor->index + 1 < list->length ? node->next : NULL;
+    if (!cursor->index || !next) { // 首尾删除不需查找节点
+        popNode(list, cursor->index);
+    } else {
+        node->prev->next = node->next;
+        node->next->prev = node->prev;
+        fingerRemove(list, cursor->index, 1, next);
+        list->length--;
+    }
+    cursor->node = next;
+
+    if (elem != NULL)
+        memcpy(elem, node->elem, list->elemSize);
+    freeNode(list, node);
+    return 0;
+}
+
+int doubleLinkedList_splice(DoubleLinkedList *list, size_t index, DoubleLinkedList *other, size_t from, size_t to) {
+    if (index > list->length || from > to || to > other->length)
+        return 1;
+    if (!compatible(list, other))
+        return 3;
+    if (from == to)
+        return 0;
+    DoubleLinkNode *first, *last;
+    takeChain(other, from, to - from, &first, &last);
+    putChain(list, index, first, last, to - from);
+    return 0;
+}
+
+int doubleLinkedList_split(DoubleLinkedList *list, size_t index, DoubleLinkedList *other) {
+    return doubleLinkedList_splice(other, other->length, list, index, list->length);
+}
+
+int doubleLinkedList_concat(DoubleLinkedList *list, DoubleLinkedList *other) {
+    return doubleLinkedList_splice(list, list->length, other, 0, other->length);
+}
+
+// 按next排好序后再补上prev。
+int doubleLinkedList_sort(DoubleLinkedList *list, ListElemCtxComparer cmp, void *ctx) {
+    DoubleLinkNode *head = chainSort(list->head, offsetof(DoubleLinkNode, elem), cmp, ctx), *last = NULL;
+    for (DoubleLinkNode *node = head; node; node = node->next) {
+        node->prev = last;
+        last = node;
+    }
+    setEnds(list, head, last, list->length);
+    setFinger(list, 0, NULL);
     return 0;
 }
 
@@ -201,33 +354,47 @@ int doubleLinkedList_fprint(const DoubleLinkedList *list, FILE *f, ListElemToStr
     return 0;
 }
 
-static DoubleLinkNode *newNode(size_t size, const void *elem) {
-    DoubleLinkNode *newNode = malloc(sizeof(DoubleLinkNode));
-    newNode->elem = malloc(size);
-    memcpy(newNode->elem, elem, size);
+static DoubleLinkNode *newNode(const DoubleLinkedList *list, const void *elem) {
+    DoubleLinkNode *newNode = list->pool ? nodePool_get(list->pool) : malloc(sizeof(DoubleLinkNode) + list->elemSize);
+    if (newNode == NULL)
+        return NULL;
+    memcpy(newNode->elem, elem, list->elemSize);
     newNode->next = newNode->prev = NULL;
     return newNode;
 }
 
+// 从首节点、尾节点与最近定位的节点中离index最近的出发。
 static DoubleLinkNode *getNode(const DoubleLinkedList *list, size_t index) {
-    DoubleLinkNode *node;
-    if (index <= (list->length - 1) / 2) {
-        node = list->head;
-        for (size_t i = 0; i < index; i++)
-            node = node->next;
-    } else {
+    DoubleLinkNode *node = list->head;
+    size_t i = 0;
+    if (index > (list->length - 1) / 2) {
         node = list->tail;
-        for (size_t i = list->length - 1; i > index; i--)
-            node = node->prev;
+        i = list->length - 1;
+    }
+    if (list->finger) {
+        size_t distance = i > index ? i - index : index - i;
+        size_t fingerDistance = list->fingerIndex > index ? list->fingerIndex - index : index - list->fingerIndex;
+        if (fingerDistance < distance) {
+            node = list->finger;
+            i = list->fingerIndex;
+        }
     }
+    for (; i < index; i++)
+        node = node->next;
+    for (; i > index; i--)
+        node = node->prev;
+    setFinger(list, index, node);
     return node;
 }
 
 static DoubleLinkNode *popNode(DoubleLinkedList *list, size_t index) {
     DoubleLinkNode *node;
+    DoubleLinkNode *next = NULL; // 接替被删除节点位置的节点
     if (!index) {
         node = list->head;
         list->head = list->head->next;
+        if (list->length > 1)
+            next = list->head;
         if (list->length == 2)
             list->tail = list->head->next = NULL;
     } else if (index == (list->length - 1)) {
@@ -240,10 +407,111 @@ static DoubleLinkNode *popNode(DoubleLinkedList *list, size_t index) {
         }
     } else {
         node = getNode(list, index);
+        next = node->next;
         node->prev->next = node->next;
         node->next->prev = node->prev;
     }
+    fingerRemove(list, index, 1, next);
     node->prev = node->next = NULL;
     list->length--;
     return node;
 }
+
+// 尾节点，只有一个元素时tail为NULL。
+static DoubleLinkNode *lastNode(const DoubleLinkedList *list) {
+    return list->length > 1 ? list->tail : list->length ? list->head : NULL;
+}
+
+// 按首尾节点与长度设置双向链表，保持元素不多于一个时tail为NULL。
+static void setEnds(DoubleLinkedList *list, DoubleLinkNode *head, DoubleLinkNode *last, size_t length) {
+    list->length = length;
+    if (!length) {
+        list->head = list->tail = NULL;
+        return;
+    }
+    head->prev = last->next = NULL;
+    list->head = head;
+    list->tail = length > 1 ? last : NULL;
+}
+
+// 摘下从from开始的count个节点，只在两端修改指针，节点间的链接保持不变。
+static void takeChain(DoubleLinkedList *list, size_t from, size_t count, DoubleLinkNode **first,
+                      DoubleLinkNode **last) {
+    DoubleLinkNode *oldLast = lastNode(list);
+    *first = getNode(list, from);
+    *last = getNode(list, from + count - 1);
+    DoubleLinkNode *prev = from ? (*first)->prev : NULL;
+    DoubleLinkNode *next = from + count < list->length ? (*last)->next : NULL;
+    if (prev)
+        prev->next = next;
+    if (next)
+        next->prev = prev;
+    fingerRemove(list, from, count, next);
+    setEnds(list, prev ? list->head : next, next ? oldLast : prev, list->length - count);
+}
+
+// 把以first开始、last结束的count个节点链接到index位置上。
+static void putChain(DoubleLinkedList *list, size_t index, DoubleLinkNode *first, DoubleLinkNode *last, size_t count) {
+    DoubleLinkNode *oldLast = lastNode(list);
+    DoubleLinkNode *prev = index ? getNode(list, index - 1) : NULL;
+    DoubleLinkNode *next = index < list->length ? (prev ? prev->next : list->head) : NULL;
+    first->prev = prev;
+    last->next = next;
+    if (prev)
+        prev->next = first;
+    if (next)
+        next->prev = last;
+    fingerInsert(list, index, count);
+    setEnds(list, prev ? list->head : first, next ? oldLast : last, list->length + count);
+}
+
+// 节点可在两个双向链表间移动：元素大小相同，且节点来自同一个共享节点池或都由malloc分配，独占的节点池不会相同。
+static _Bool compatible(const DoubleLinkedList *list, const DoubleLinkedList *other) {
+    return list != other && list->elemSize == other->elemSize && list->pool == other->pool;
+}
+
+// 定位缓存不属于双向链表的内容，只读操作也可更新。
+static void setFinger(const DoubleLinkedList *list, size_t index, DoubleLinkNode *node) {
+    DoubleLinkedList *mutable = (DoubleLinkedList *) list;
+    mutable->finger = node;
+    mutable->fingerIndex = index;
+}
+
+// 在index位置插入count个节点后，其后的定位缓存位置后移。
+static void fingerInsert(DoubleLinkedList *list, size_t index, size_t count) {
+    if (list->finger && list->fingerIndex >= index)
+        list->fingerIndex += count;
+}
+
+// 删除index开始的count个节点后，定位缓存若在其中则改为接替它们的next节点，next为NULL时失效。
+static void fingerRemove(DoubleLinkedList *list, size_t index, size_t count, DoubleLinkNode *next) {
+    if (!list->finger || list->fingerIndex < index)
+        return;
+    if (list->fingerIndex >= index + count)
+        list->fingerIndex -= count;
+    else {
+        list->finger = next;
+        list->fingerIndex = index;
+    }
+}
+
+static void freeNode(const DoubleLinkedList *list, DoubleLinkNode *node) {
+    if (list->pool)
+        nodePool_put(list->pool, node);
+    else
+        free(node);
+}
+
+// 独占的节点池直接释放全部内存块，无需逐个归还节点。
+static void freeNodes(DoubleLinkedList *list) {
+    if (list->ownPool) {
+        nodePool_reset(list->pool);
+        return;
+    }
+    DoubleLinkNode *node = list->head;
+    for (size_t i = 0; i < list->length; i++) {
+        DoubleLinkNode *next = node->next;
+        freeNode(list, node);
+        node = next;
+    }
+}
@@ -13,20 +13,27 @@
 #ifndef CLIB_DOUBLE_LINKED_LIST_H
 #define CLIB_DOUBLE_LINKED_LIST_H
 
+#include <stddef.h>
 #include <stdlib.h>
 
 #include "list.h"
+#include "node_pool.h"
 
-// 双向链表节点。
+// 双向链表节点，元素值与节点在同一块内存中。
 typedef struct DoubleLinkNode {
-    void *elem;
     struct DoubleLinkNode *next, *prev;
+    _Alignas(max_align_t) unsigned char elem[];
 } DoubleLinkNode;
 
 // 双向链式线性表。
+// 按位置访问时缓存最近定位的节点，邻近位置的访问从缓存节点出发，因此只读访问也会修改缓存，多线程同时读需自行加锁。
 typedef struct {
     size_t elemSize, length;
     DoubleLinkNode *head, *tail;
+    DoubleLinkNode *finger; // 最近定位的节点，NULL表示无缓存
+    size_t fingerIndex;     // finger所在位置
+    NodePool *pool; // 节点池，NULL表示节点由malloc分配
+    _Bool ownPool;  // 节点池是否由线性表独占
 } DoubleLinkedList;
 
 // 新建双向链表。
@@ -35,6 +42,14 @@ typedef struct {
 // 空间复杂度：O(1)
 DoubleLinkedList *doubleLinkedList_alloc(size_t elemSize);
 
+// 新建从节点池分配节点的双向链表。
+// elemSize：每个元素占用的字节大小。
+// pool：节点池，可在节点大小相同的线性表间共享，由调用方销毁；NULL表示双向链表独占一个节点池，清空或销毁时整块释放。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+// 返回NULL: 节点池已绑定其它节点大小。
+DoubleLinkedList *doubleLinkedList_allocWithPool(size_t elemSize, NodePool *pool);
+
 // 销毁双向链表。
 // list：双向链表。
 // 时间复杂度：O(n)
@@ -63,6 +78,7 @@ int doubleLinkedList_get(const DoubleLinkedList *list, size_t index, void *elem)
 // 时间复杂度：O(n)
 // 空间复杂度：O(1)
 // 返回1: 越界。
+// 返回2: 内存不足。
 int doubleLinkedList_insert(DoubleLinkedList *list, size_t index, const void *elem);
 
 // 删除双向链表中某个位置上的元素。
@@ -90,6 +106,26 @@ int doubleLinkedList_locate(const DoubleLinkedList *list, ListElemComparer cmp,
 // 空间复杂度：O(1)
 int doubleLinkedList_travel(const DoubleLinkedList *list, ListElemVisitor visit);
 
+// 带上下文查找元素在双向链表中的位置。
+// list：双向链表。
+// cmp：元素比较函数。
+// elem：要寻找的元素。
+// ctx：传给比较函数的上下文。
+// index：元素位置塞入index中。
+// 时间复杂度：O(n)
+// 空间复杂度：O(1)
+// 返回1: 未找到。
+int doubleLinkedList_locateCtx(const DoubleLinkedList *list, ListElemCtxComparer cmp, const void *elem, void *ctx, size_t *index);
+
+// 带上下文遍历双向链表，遍历函数返回非0时停止。
+// list：双向链表。
+// visit：遍历函数。
+// ctx：传给遍历函数的上下文。
+// 时间复杂度：O(n)
+// 空间复杂度：O(1)
+// 返回visit的非0返回值: 遍历提前结束。
+int doubleLinkedList_travelCtx(const DoubleLinkedList *list, ListElemCtxVisitor visit, void *ctx);
+
 // 清空双向链表中元素。
 // list：双向链表。
 // 时间复杂度：O(n)
@@ -109,6 +145,7 @@ int doubleLinkedList_rpop(DoubleLinkedList *list, void *elem);
 // elem：被添加的元素。
 // 时间复杂度：O(n)
 // 空间复杂度：O(1)
+// 返回2: 内存不足。
 int doubleLinkedList_lpush(DoubleLinkedList *list, const void *elem);
 
 // 向双向链表右边添加元素。
@@ -116,6 +153,7 @@ int doubleLinkedList_lpush(DoubleLinkedList *list, const void *elem);
 // elem：被添加的元素。
 // 时间复杂度：O(n)
 // 空间复杂度：O(1)
+// 返回2: 内存不足。
 int doubleLinkedList_rpush(DoubleLinkedList *list, const void *elem);
 
 // 取出双向链表中最左边的元素。
@@ -153,6 +191,93 @@ int doubleLinkedList_getDel(DoubleLinkedList *list, size_t index, void *elem);
 // 返回1: 越界。
 int doubleLinkedList_getSet(DoubleLinkedList *list, size_t index, void *elem);
 
+// 获取双向链表中元素的存储地址，可原地读写元素，删除该元素后地址失效。
+// list：双向链表。
+// index：元素所在位置。
+// 时间复杂度：O(n)
+// 空间复杂度：O(1)
+// 返回NULL: 越界。
+void *doubleLinkedList_at(const DoubleLinkedList *list, size_t index);
+
+// 迭代位置置于双向链表首个元素。
+// list：双向链表。
+// cursor：将被设置为迭代位置。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+void doubleLinkedList_iterBegin(const DoubleLinkedList *list, ListCursor *cursor);
+
+// 迭代位置前进到下一个元素。
+// list：双向链表。
+// cursor：迭代位置。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+// 返回1: 迭代已结束。
+int doubleLinkedList_iterNext(const DoubleLinkedList *list, ListCursor *cursor);
+
+// 获取迭代位置上元素的存储地址。
+// list：双向链表。
+// cursor：迭代位置。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+// 返回NULL: 迭代已结束。
+void *doubleLinkedList_iterAt(const DoubleLinkedList *list, const ListCursor *cursor);
+
+// 在迭代位置上的元素前插入元素，迭代位置仍指向原元素；迭代已结束时追加到尾部。
+// list：双向链表。
+// cursor：迭代位置。
+// elem：被插入的元素。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+// 返回2: 内存不足。
+int doubleLinkedList_iterInsertBefore(DoubleLinkedList *list, ListCursor *cursor, const void *elem);
+
+// 删除迭代位置上的元素，迭代位置指向下一个元素。
+// list：双向链表。
+// cursor：迭代位置。
+// elem：非NULL时将被设置为删除的元素值。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+// 返回1: 迭代已结束。
+int doubleLinkedList_iterErase(DoubleLinkedList *list, ListCursor *cursor, void *elem);
+
+// 将other中[from, to)位置上的节点移到list的index位置上，不复制元素也不分配节点。
+// list：双向链表。
+// index：移入的首个元素在list中的位置。
+// other：移出节点的双向链表，须与list元素大小相同，且共享同一个节点池或都不使用节点池。
+// from：移出的首个元素在other中的位置。
+// to：移出的最后一个元素在other中的下一个位置。
+// 时间复杂度：O(m)，m为index、from、to离各自链表两端的最近距离，在两端移动为O(1)
+// 空间复杂度：O(1)
+// 返回1: 越界。
+// 返回3: 两个双向链表的节点不能互相移动。
+int doubleLinkedList_splice(DoubleLinkedList *list, size_t index, DoubleLinkedList *other, size_t from, size_t to);
+
+// 将list中index及之后的节点移到other尾部。
+// list：双向链表。
+// index：移出的首个元素位置。
+// other：接收节点的双向链表，须与list元素大小相同，且共享同一个节点池或都不使用节点池。
+// 时间复杂度：O(m)，m为index离两端的最近距离
+// 空间复杂度：O(1)
+// 返回1: 越界。
+// 返回3: 两个双向链表的节点不能互相移动。
+int doubleLinkedList_split(DoubleLinkedList *list, size_t index, DoubleLinkedList *other);
+
+// 将other的全部节点移到list尾部，other被清空。
+// list：双向链表。
+// other：被链接的双向链表，须与list元素大小相同，且共享同一个节点池或都不使用节点池。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+// 返回3: 两个双向链表的节点不能互相移动。
+int doubleLinkedList_concat(DoubleLinkedList *list, DoubleLinkedList *other);
+
+// 按比较函数升序排列双向链表，自底向上归并重新链接节点，元素不移动，相等元素保持原有顺序。
+// list：双向链表。
+// cmp：元素比较函数。
+// ctx：传给比较函数的上下文。
+// 时间复杂度：O(n*log(n))
+// 空间复杂度：O(1)
+int doubleLinkedList_sort(DoubleLinkedList *list, ListElemCtxComparer cmp, void *ctx);
+
 // 打印双向链表中元素。
 // list：双向链表。
 // f：打印输出对象。
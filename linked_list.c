@@ -15,29 +15,57 @@
 
 #include "linked_list.h"
 
+extern void memorySwap(void *p0, void *p1, size_t size);
+
+extern void *chainSort(void *head, size_t elemOffset, ListElemCtxComparer cmp, void *ctx);
+
 static SingleLinkNode *getNode(const LinkedList *list, size_t index);
 
-static SingleLinkNode *newNode(size_t elemSize, const void *elem);
+static SingleLinkNode *newNode(const LinkedList *list, const void *elem);
+
+static void freeNode(const LinkedList *list, SingleLinkNode *node);
+
+static void freeNodes(LinkedList *list);
 
 static void popNode(LinkedList *list, size_t index, void *elem);
 
+static _Bool compatible(const LinkedList *list, const LinkedList *other);
+
+static void setFinger(const LinkedList *list, size_t index, SingleLinkNode *node);
+
+static void fingerInsert(LinkedList *list, size_t index, size_t count);
+
+static void fingerRemove(LinkedList *list, size_t index, SingleLinkNode *next);
+
 LinkedList *linkedList_alloc(size_t elemSize) {
     LinkedList *list = malloc(sizeof(LinkedList));
     list->elemSize = elemSize;
     list->length = 0;
-    list->head = NULL;
+    list->head = list->tail = list->finger = NULL;
+    list->fingerIndex = 0;
+    list->pool = NULL;
+    list->ownPool = 0;
     return list;
 }
 
-void linkedList_free(LinkedList *list) {
-    SingleLinkNode *node = list->head;
-    for (size_t i = 0; i < list->length; i++) {
-        SingleLinkNode *next = node->next;
-        free(node->elem);
-        free(node);
-        node = next;
+LinkedList *linkedList_allocWithPool(size_t elemSize, NodePool *pool) {
+    NodePool *nodePool = pool ? pool : nodePool_alloc(0);
+    if (nodePool_bind(nodePool, sizeof(SingleLinkNode) + elemSize)) {
+        if (!pool)
+            nodePool_free(nodePool);
+        return NULL;
     }
-    list->head = NULL;
+    LinkedList *list = linkedList_alloc(elemSize);
+    list->pool = nodePool;
+    list->ownPool = !pool;
+    return list;
+}
+
+void linkedList_free(LinkedList *list) {
+    freeNodes(list);
+    if (list->ownPool)
+        nodePool_free(list->pool);
+    list->head = list->tail = list->finger = NULL;
     list->elemSize = list->length = 0;
     free(list);
 }
@@ -57,7 +85,9 @@ int linkedList_get(const LinkedList *list, size_t index, void *elem) {
 int linkedList_insert(LinkedList *list, size_t index, const void *elem) {
     if (index > list->length)
         return 1;
-    SingleLinkNode *node = newNode(list->elemSize, elem);
+    SingleLinkNode *node = newNode(list, elem);
+    if (node == NULL)
+        return 2;
 
     if (!index) { // 首部追加元素
         node->next = list->head;
@@ -67,6 +97,9 @@ int linkedList_insert(LinkedList *list, size_t index, const void *elem) {
         node->next = prevNode->next;
         prevNode->next = node;
     }
+    if (index == list->length)
+        list->tail = node;
+    fingerInsert(list, index, 1);
 
     list->length++;
     return 0;
@@ -98,16 +131,33 @@ int linkedList_travel(const LinkedList *list, ListElemVisitor visit) {
     return 0;
 }
 
-int linkedList_clear(LinkedList *list) {
+int linkedList_locateCtx(const LinkedList *list, ListElemCtxComparer cmp, const void *elem, void *ctx, size_t *index) {
     SingleLinkNode *node = list->head;
     for (size_t i = 0; i < list->length; i++) {
-        SingleLinkNode *next = node->next;
-        free(node->elem);
-        free(node);
-        node = next;
+        if (!cmp(node->elem, elem, ctx)) {
+            *index = i;
+            return 0;
+        }
+        node = node->next;
     }
+    return 1;
+}
+
+int linkedList_travelCtx(const LinkedList *list, ListElemCtxVisitor visit, void *ctx) {
+    SingleLinkNode *node = list->head;
+    for (size_t i = 0; i < list->length; i++) {
+        int res = visit(node->elem, ctx);
+        if (res)
+            return res;
+        node = node->next;
+    }
+    return 0;
+}
+
+int linkedList_clear(LinkedList *list) {
+    freeNodes(list);
     list->length = 0;
-    list->head = NULL;
+    list->head = list->tail = list->finger = NULL;
     return 0;
 }
 
@@ -139,12 +189,116 @@ int linkedList_getDel(LinkedList *list, size_t index, void *elem) {
 }
 
 int linkedList_getSet(LinkedList *list, size_t index, void *elem) {
+    if (index >= list->length)
+        return 1;
     SingleLinkNode *node = getNode(list, index);
-    void *tmp = malloc(list->elemSize);
-    memcpy(tmp, node->elem, list->elemSize);
-    memcpy(node->elem, elem, list->elemSize);
-    memcpy(elem, tmp, list->elemSize);
-    free(tmp);
+    memorySwap(node->elem, elem, list->elemSize);
+    return 0;
+}
+
+void *linkedList_at(const LinkedList *list, size_t index) {
+    if (index >= list->length)
+        return NULL;
+    return getNode(list, index)->elem;
+}
+
+void linkedList_iterBegin(const LinkedList *list, ListCursor *cursor) {
+    cursor->index = 0;
+    cursor->node = list->length ? list->head : NULL;
+    cursor->prev = NULL;
+}
+
+int linkedList_iterNext(const LinkedList *list, ListCursor *cursor) {
+    if (cursor->index >= list->length)
+        return 1;
+    SingleLinkNode *node = cursor->node;
+    cursor->prev = node;
+    cursor->node = ++cursor->index < list->length ? node->next : NULL;
+    return 0;
+}
+
+void *linkedList_iterAt(const LinkedList *list, const ListCursor *cursor) {
+    if (cursor->index >= list->length)
+        return NULL;
+    return ((SingleLinkNode *) cursor->node)->elem;
+}
+
+int linkedList_iterInsertBefore(LinkedList *list, ListCursor *cursor, const void *elem) {
+    SingleLinkNode *node = newNode(list, elem);
+    if (node == NULL)
+        return 2;
+    SingleLinkNode *prev = cursor->prev;
+    node->next = cursor->node;
+    if (prev)
+        prev->next = node;
+    else
+        list->head = node;
+    if (cursor->index >= list->length)
+        list->tail = node;
+    fingerInsert(list, cursor->index, 1);
+    cursor->prev = node;
+    cursor->index++;
+    list->length++;
+    return 0;
+}
+
+int linkedList_iterErase(LinkedList *list, ListCursor *cursor, void *elem) {
+    if (cursor->index >= list->length)
+        return 1;
+    SingleLinkNode *node = cursor->node, *prev = cursor->prev;
+    if (prev)
+        prev->next = node->next;
+    else
+        list->head = node->next;
+    if (node == list->tail)
+        list->tail = prev;
+    cursor->node = cursor->index + 1 < list->length ? node->next : NULL;
+    fingerRemove(list, cursor->index, cursor->node);
+
+    if (elem != NULL)
+        memcpy(elem, node->elem, list->elemSize);
+    freeNode(list, node);
+    list->length--;
+    return 0;
+}
+
+int linkedList_concat(LinkedList *list, LinkedList *other) {
+    return linkedList_splice(list, list->length, other);
+}
+
+int linkedList_splice(LinkedList *list, size_t index, LinkedList *other) {
+    if (index > list->length)
+        return 1;
+    if (!compatible(list, other))
+        return 3;
+    if (!other->length)
+        return 0;
+
+    if (!index) {
+        other->tail->next = list->head;
+        list->head = other->head;
+    } else {
+        SingleLinkNode *prevNode = getNode(list, index - 1);
+        other->tail->next = prevNode->next;
+        prevNode->next = other->head;
+    }
+    if (index == list->length)
+        list->tail = other->tail;
+    fingerInsert(list, index, other->length);
+    list->length += other->length;
+
+    other->head = other->tail = other->finger = NULL;
+    other->length = 0;
+    return 0;
+}
+
+int linkedList_sort(LinkedList *list, ListElemCtxComparer cmp, void *ctx) {
+    list->head = chainSort(list->head, offsetof(SingleLinkNode, elem), cmp, ctx);
+    SingleLinkNode *node = list->head;
+    while (node && node->next)
+        node = node->next;
+    list->tail = node;
+    setFinger(list, 0, NULL);
     return 0;
 }
 
@@ -167,35 +321,97 @@ int linkedList_fprint(const LinkedList *list, FILE *f, ListElemToString str, siz
     return 0;
 }
 
+// 最近定位的节点不在index之后时从它出发，否则从首节点出发。
 static SingleLinkNode *getNode(const LinkedList *list, size_t index) {
+    if (index + 1 == list->length)
+        return list->tail;
     SingleLinkNode *node = list->head;
-    for (size_t i = 0; i < index; i++)
+    size_t i = 0;
+    if (list->finger && list->fingerIndex <= index) {
+        node = list->finger;
+        i = list->fingerIndex;
+    }
+    for (; i < index; i++)
         node = node->next;
+    setFinger(list, index, node);
     return node;
 }
 
-static SingleLinkNode *newNode(size_t elemSize, const void *elem) {
-    SingleLinkNode *newNode = malloc(sizeof(SingleLinkNode));
-    newNode->elem = malloc(elemSize);
-    memcpy(newNode->elem, elem, elemSize);
+static SingleLinkNode *newNode(const LinkedList *list, const void *elem) {
+    SingleLinkNode *newNode = list->pool ? nodePool_get(list->pool) : malloc(sizeof(SingleLinkNode) + list->elemSize);
+    if (newNode == NULL)
+        return NULL;
+    memcpy(newNode->elem, elem, list->elemSize);
     newNode->next = NULL;
     return newNode;
 }
 
 static void popNode(LinkedList *list, size_t index, void *elem) {
     SingleLinkNode *delNode;
+    SingleLinkNode *prevNode = NULL;
     if (!index) { // 删除首元素
         delNode = list->head;
         list->head = delNode->next;
     } else {
-        SingleLinkNode *prevNode = getNode(list, index - 1);
+        prevNode = getNode(list, index - 1);
         delNode = prevNode->next;
         prevNode->next = delNode->next;
     }
+    if (delNode == list->tail)
+        list->tail = prevNode;
+    fingerRemove(list, index, index < list->length - 1 ? delNode->next : NULL);
 
     if (elem != NULL)
         memcpy(elem, delNode->elem, list->elemSize);
-    free(delNode->elem);
-    free(delNode);
+    freeNode(list, delNode);
     list->length--;
 }
+
+// 节点可在两个单链表间移动：元素大小相同，且节点来自同一个共享节点池或都由malloc分配，独占的节点池不会相同。
+static _Bool compatible(const LinkedList *list, const LinkedList *other) {
+    return list != other && list->elemSize == other->elemSize && list->pool == other->pool;
+}
+
+// 定位缓存不属于单链表的内容，只读操作也可更新。
+static void setFinger(const LinkedList *list, size_t index, SingleLinkNode *node) {
+    LinkedList *mutable = (LinkedList *) list;
+    mutable->finger = node;
+    mutable->fingerIndex = index;
+}
+
+// 在index位置插入count个节点后，其后的定位缓存位置后移。
+static void fingerInsert(LinkedList *list, size_t index, size_t count) {
+    if (list->finger && list->fingerIndex >= index)
+        list->fingerIndex += count;
+}
+
+// 删除index位置的节点后，定位缓存若是该节点则改为接替它的next节点，next为NULL时失效。
+static void fingerRemove(LinkedList *list, size_t index, SingleLinkNode *next) {
+    if (!list->finger || list->fingerIndex < index)
+        return;
+    if (list->fingerIndex > index)
+        list->fingerIndex--;
+    else
+        list->finger = next;
+}
+
+static void freeNode(const LinkedList *list, SingleLinkNode *node) {
+    if (list->pool)
+        nodePool_put(list->pool, node);
+    else
+        free(node);
+}
+
+// 独占的节点池直接释放全部内存块，无需逐个归还节点。
+static void freeNodes(LinkedList *list) {
+    if (list->ownPool) {
+        nodePool_reset(list->pool);
+        return;
+    }
+    SingleLinkNode *node = list->head;
+    for (size_t i = 0; i < list->length; i++) {
+        SingleLinkNode *next = node->next;
+        freeNode(list, node);
+        node = next;
+    }
+}
@@ -13,20 +13,27 @@
 #ifndef CLIB_LINKED_LIST_H
 #define CLIB_LINKED_LIST_H
 
+#include <stddef.h>
 #include <stdlib.h>
 
 #include "list.h"
+#include "node_pool.h"
 
-// 单链表节点。
+// 单链表节点，元素值与节点在同一块内存中。
 typedef struct SingleLinkNode {
-    void *elem;
     struct SingleLinkNode *next;
+    _Alignas(max_align_t) unsigned char elem[];
 } SingleLinkNode;
 
 // 单链线性表。
+// 按位置访问时缓存最近定位的节点，邻近位置的访问从缓存节点出发，因此只读访问也会修改缓存，多线程同时读需自行加锁。
 typedef struct {
     size_t length, elemSize;
-    SingleLinkNode *head;
+    SingleLinkNode *head, *tail;
+    SingleLinkNode *finger; // 最近定位的节点，NULL表示无缓存
+    size_t fingerIndex;     // finger所在位置
+    NodePool *pool; // 节点池，NULL表示节点由malloc分配
+    _Bool ownPool;  // 节点池是否由线性表独占
 } LinkedList;
 
 // 新建单链表。
@@ -35,6 +42,14 @@ typedef struct {
 // 空间复杂度：O(1)
 LinkedList *linkedList_alloc(size_t elemSize);
 
+// 新建从节点池分配节点的单链表。
+// elemSize：每个元素占用的字节大小。
+// pool：节点池，可在节点大小相同的线性表间共享，由调用方销毁；NULL表示单链表独占一个节点池，清空或销毁时整块释放。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+// 返回NULL: 节点池已绑定其它节点大小。
+LinkedList *linkedList_allocWithPool(size_t elemSize, NodePool *pool);
+
 // 销毁单链表。
 // list：单链表。
 // 时间复杂度：O(n)
@@ -63,6 +78,7 @@ int linkedList_get(const LinkedList *list, size_t index, void *elem);
 // 时间复杂度：O(n)
 // 空间复杂度：O(1)
 // 返回1: 越界。
+// 返回2: 内存不足。
 int linkedList_insert(LinkedList *list, size_t index, const void *elem);
 
 // 删除单链表个某个位置上的元素。
@@ -90,6 +106,26 @@ int linkedList_locate(const LinkedList *list, ListElemComparer cmp, const void *
 // 空间复杂度：O(1)
 int linkedList_travel(const LinkedList *list, ListElemVisitor visit);
 
+// 带上下文查找元素在单链表中的位置。
+// list：单链表。
+// cmp：元素比较函数。
+// elem：要寻找的元素。
+// ctx：传给比较函数的上下文。
+// index：元素位置塞入index中。
+// 时间复杂度：O(n)
+// 空间复杂度：O(1)
+// 返回1: 未找到。
+int linkedList_locateCtx(const LinkedList *list, ListElemCtxComparer cmp, const void *elem, void *ctx, size_t *index);
+
+// 带上下文遍历单链表，遍历函数返回非0时停止。
+// list：单链表。
+// visit：遍历函数。
+// ctx：传给遍历函数的上下文。
+// 时间复杂度：O(n)
+// 空间复杂度：O(1)
+// 返回visit的非0返回值: 遍历提前结束。
+int linkedList_travelCtx(const LinkedList *list, ListElemCtxVisitor visit, void *ctx);
+
 // 清空单链表。
 // list：单链表。
 // 时间复杂度：O(n)
@@ -99,7 +135,7 @@ int linkedList_clear(LinkedList *list);
 // 取出单链表中右边元素。
 // list：单链表。
 // elem：元素值塞入elem中。
-// 时间复杂度：O(n)
+// 时间复杂度：O(n)，需找到尾元素的前驱
 // 空间复杂度：O(1)
 // 返回1: 越界。
 int linkedList_rpop(LinkedList *list, void *elem);
@@ -107,21 +143,23 @@ int linkedList_rpop(LinkedList *list, void *elem);
 // 向单链表左边添加元素。
 // list：单链表。
 // elem：被添加的元素。
-// 时间复杂度：O(n)
+// 时间复杂度：O(1)
 // 空间复杂度：O(1)
+// 返回2: 内存不足。
 int linkedList_lpush(LinkedList *list, const void *elem);
 
 // 向单链表右边添加元素。
 // list：单链表。
 // elem：被添加的元素。
-// 时间复杂度：O(n)
+// 时间复杂度：O(1)
 // 空间复杂度：O(1)
+// 返回2: 内存不足。
 int linkedList_rpush(LinkedList *list, const void *elem);
 
 // 取出单链表最左边的元素。
 // list：单链表。
 // elem：元素值塞入elem中。
-// 时间复杂度：O(n)
+// 时间复杂度：O(1)
 // 空间复杂度：O(1)
 // 返回1: 越界。
 int linkedList_lpop(LinkedList *list, void *elem);
@@ -151,6 +189,81 @@ int linkedList_getDel(LinkedList *list, size_t index, void *elem);
 // 返回1: 越界。
 int linkedList_getSet(LinkedList *list, size_t index, void *elem);
 
+// 获取单链表中元素的存储地址，可原地读写元素，删除该元素后地址失效。
+// list：单链表。
+// index：元素所在位置。
+// 时间复杂度：O(n)
+// 空间复杂度：O(1)
+// 返回NULL: 越界。
+void *linkedList_at(const LinkedList *list, size_t index);
+
+// 迭代位置置于单链表首个元素。
+// list：单链表。
+// cursor：将被设置为迭代位置。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+void linkedList_iterBegin(const LinkedList *list, ListCursor *cursor);
+
+// 迭代位置前进到下一个元素。
+// list：单链表。
+// cursor：迭代位置。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+// 返回1: 迭代已结束。
+int linkedList_iterNext(const LinkedList *list, ListCursor *cursor);
+
+// 获取迭代位置上元素的存储地址。
+// list：单链表。
+// cursor：迭代位置。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+// 返回NULL: 迭代已结束。
+void *linkedList_iterAt(const LinkedList *list, const ListCursor *cursor);
+
+// 在迭代位置上的元素前插入元素，迭代位置仍指向原元素；迭代已结束时追加到尾部。
+// list：单链表。
+// cursor：迭代位置。
+// elem：被插入的元素。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+// 返回2: 内存不足。
+int linkedList_iterInsertBefore(LinkedList *list, ListCursor *cursor, const void *elem);
+
+// 删除迭代位置上的元素，迭代位置指向下一个元素。
+// list：单链表。
+// cursor：迭代位置。
+// elem：非NULL时将被设置为删除的元素值。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+// 返回1: 迭代已结束。
+int linkedList_iterErase(LinkedList *list, ListCursor *cursor, void *elem);
+
+// 将other的全部节点链接到list尾部，不复制元素，other被清空。
+// list：单链表。
+// other：被链接的单链表，须与list元素大小相同，且共享同一个节点池或都不使用节点池。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+// 返回3: 两个单链表的节点不能互相移动。
+int linkedList_concat(LinkedList *list, LinkedList *other);
+
+// 将other的全部节点链接到list的index位置上，不复制元素，other被清空。
+// list：单链表。
+// index：other首元素在list中的位置。
+// other：被链接的单链表，须与list元素大小相同，且共享同一个节点池或都不使用节点池。
+// 时间复杂度：O(index)，在首尾链接为O(1)
+// 空间复杂度：O(1)
+// 返回1: 越界。
+// 返回3: 两个单链表的节点不能互相移动。
+int linkedList_splice(LinkedList *list, size_t index, LinkedList *other);
+
+// 按比较函数升序排列单链表，自底向上归并重新链接节点，元素不移动，相等元素保持原有顺序。
+// list：单链表。
+// cmp：元素比较函数。
+// ctx：传给比较函数的上下文。
+// 时间复杂度：O(n*log(n))
+// 空间复杂度：O(1)
+int linkedList_sort(LinkedList *list, ListElemCtxComparer cmp, void *ctx);
+
 // 打印单链表中的元素。
 // list：单链表。
 // f：打印输出对象。
@@ -17,6 +17,7 @@
 
 #include "linked_list.h"
 #include "linked_list.c"
+#include "node_pool.c"
 
 #define TEST_LENGTH 20000
 
@@ -24,6 +25,16 @@ static int intCmp(const void *o1, const void *o2);
 
 static void intVisitor(void *p);
 
+static void testPool(void);
+
+static void testSplice(void);
+
+static void testFinger(void);
+
+static void testSort(void);
+
+static int ctxIntCmp(const void *o1, const void *o2, void *ctx);
+
 // static size_t intToString(void *elem, char *s);
 
 int main(void) {
@@ -103,6 +114,232 @@ int main(void) {
     assert(!linkedList_clear(list));
 
     linkedList_free(list);
+
+    testPool();
+    testSplice();
+    testFinger();
+    testSort();
+}
+
+// 重新链接节点降序排序，与计数排序结果一致，排序后首尾与前后链接正确。
+static void testSort(void) {
+    enum {Length = 5000};
+    LinkedList *list = linkedList_alloc(sizeof(int));
+    int expect[Length], order = -1, elem;
+    for (int i = 0; i < Length; i++) {
+        expect[i] = rand() % 1000;
+        assert(!linkedList_rpush(list, expect + i));
+    }
+    assert(linkedList_at(list, Length / 2));
+    assert(!linkedList_sort(list, ctxIntCmp, &order));
+    int counts[1000] = {0};
+    for (int i = 0; i < Length; i++)
+        counts[expect[i]]++;
+    for (int v = 0, i = 0; v < 1000; v++)
+        while (counts[v]--)
+            expect[i++] = v;
+    for (int i = 0; i < Length; i++)
+        assert(*(int *) linkedList_at(list, i) == expect[Length - 1 - i]);
+    SingleLinkNode *node = list->head;
+    for (int i = 1; i < Length; i++)
+        node = node->next;
+    assert(node == list->tail && !node->next);
+    elem = -1;
+    assert(!linkedList_rpush(list, &elem));
+    assert(!linkedList_rpop(list, &elem) && elem == -1);
+    assert(!linkedList_lpop(list, &elem) && elem == expect[Length - 1]);
+    assert(!linkedList_clear(list));
+    assert(!linkedList_sort(list, ctxIntCmp, &order));
+    elem = 1;
+    assert(!linkedList_rpush(list, &elem));
+    assert(!linkedList_sort(list, ctxIntCmp, &order));
+    assert(!linkedList_get(list, 0, &elem) && elem == 1);
+    linkedList_free(list);
+}
+
+// 局部访问与增删交替进行，定位缓存始终与数组模型一致。
+static void testFinger(void) {
+    enum {Capacity = 2000};
+    LinkedList *list = linkedList_alloc(sizeof(int));
+    int model[Capacity], length = 0, elem;
+    srand(2);
+    for (int r = 0; r < 20000; r++) {
+        size_t index = length ? rand() % length : 0;
+        switch (rand() % 6) {
+            case 0: // 在附近位置插入
+            case 1:
+                if (length == Capacity)
+                    break;
+                index = length && list->finger ? list->fingerIndex + rand() % 3 : index;
+                if (index > length)
+                    index = length;
+                memmove(model + index + 1, model + index, (length - index) * sizeof(int));
+                model[index] = r;
+                length++;
+                assert(!linkedList_insert(list, index, &r));
+                break;
+            case 2: // 删除附近位置的元素
+                if (!length)
+                    break;
+                index = list->finger && list->fingerIndex < length ? list->fingerIndex : index;
+                assert(!linkedList_getDel(list, index, &elem));
+                assert(elem == model[index]);
+                memmove(model + index, model + index + 1, (length - index - 1) * sizeof(int));
+                length--;
+                break;
+            case 3: // 两端弹出
+                if (!length)
+                    break;
+                if (r % 2) {
+                    assert(!linkedList_lpop(list, &elem) && elem == model[0]);
+                    memmove(model, model + 1, --length * sizeof(int));
+                } else
+                    assert(!linkedList_rpop(list, &elem) && elem == model[--length]);
+                break;
+            default: // 顺序读取一段
+                for (size_t i = index; i < length && i < index + 5; i++)
+                    assert(*(int *) linkedList_at(list, i) == model[i]);
+        }
+        assert(linkedList_len(list) == length);
+        if (list->finger) {
+            assert(list->fingerIndex < length);
+            assert(*(int *) list->finger->elem == model[list->fingerIndex]);
+        }
+    }
+    for (int i = 0; i < length; i++)
+        assert(!linkedList_get(list, i, &elem) && elem == model[i]);
+    assert(!linkedList_clear(list));
+    assert(!list->finger);
+    linkedList_free(list);
+}
+
+// 尾指针在各种增删后保持正确，链接两个单链表不复制元素。
+static void testSplice(void) {
+    LinkedList *list = linkedList_alloc(sizeof(int));
+    LinkedList *other = linkedList_alloc(sizeof(int));
+    int elem;
+    for (int i = 0; i < 10; i++)
+        assert(!linkedList_rpush(list, &i));
+    assert(!linkedList_rpop(list, &elem) && elem == 9);
+    assert(*(int *) list->tail->elem == 8);
+    assert(!linkedList_del(list, 8));
+    assert(!linkedList_del(list, 0));
+    elem = 100;
+    assert(!linkedList_rpush(list, &elem));
+    assert(*(int *) linkedList_at(list, 7) == 100); // [1..7, 100]
+
+    for (int i = 10; i < 15; i++)
+        assert(!linkedList_rpush(other, &i));
+    void *moved = linkedList_at(other, 0);
+    assert(!linkedList_concat(list, other));
+    assert(!linkedList_len(other) && !other->head && !other->tail);
+    assert(linkedList_len(list) == 13 && linkedList_at(list, 8) == moved);
+    assert(*(int *) list->tail->elem == 14);
+
+    for (int i = 20; i < 23; i++)
+        assert(!linkedList_rpush(other, &i));
+    assert(linkedList_splice(list, 14, other) == 1);
+    assert(!linkedList_splice(list, 0, other));
+    for (int i = 30; i < 32; i++)
+        assert(!linkedList_rpush(other, &i));
+    assert(!linkedList_splice(list, 5, other));
+    assert(!linkedList_splice(list, 5, other)); // 空单链表
+    const int expected[] = {20, 21, 22, 1, 2, 30, 31, 3, 4, 5, 6, 7, 100, 10, 11, 12, 13, 14};
+    assert(linkedList_len(list) == sizeof(expected) / sizeof(int));
+    for (size_t i = 0; i < linkedList_len(list); i++)
+        assert(*(int *) linkedList_at(list, i) == expected[i]);
+    elem = 15;
+    assert(!linkedList_rpush(list, &elem));
+    assert(!linkedList_get(list, linkedList_len(list) - 1, &elem) && elem == 15);
+    linkedList_free(other);
+
+    // 元素大小不同或节点来源不同时不能链接。
+    other = linkedList_alloc(sizeof(long long));
+    assert(linkedList_concat(list, other) == 3);
+    linkedList_free(other);
+    other = linkedList_allocWithPool(sizeof(int), NULL);
+    assert(!linkedList_rpush(other, &elem));
+    assert(linkedList_concat(list, other) == 3);
+    assert(linkedList_concat(list, list) == 3);
+    linkedList_free(other);
+
+    // 迭代器插入删除同样维护尾指针。
+    assert(!linkedList_clear(list));
+    assert(!list->tail);
+    ListCursor cursor;
+    linkedList_iterBegin(list, &cursor);
+    for (int i = 0; i < 3; i++)
+        assert(!linkedList_iterInsertBefore(list, &cursor, &i));
+    assert(*(int *) list->tail->elem == 2);
+    linkedList_iterBegin(list, &cursor);
+    assert(!linkedList_iterNext(list, &cursor));
+    assert(!linkedList_iterNext(list, &cursor));
+    assert(!linkedList_iterErase(list, &cursor, &elem) && elem == 2);
+    assert(*(int *) list->tail->elem == 1);
+    elem = 3;
+    assert(!linkedList_rpush(list, &elem));
+    assert(*(int *) linkedList_at(list, 2) == 3);
+    linkedList_free(list);
+
+    // 共享节点池的单链表间可以链接。
+    NodePool *pool = nodePool_alloc(0);
+    list = linkedList_allocWithPool(sizeof(int), pool);
+    other = linkedList_allocWithPool(sizeof(int), pool);
+    for (int i = 0; i < 3; i++) {
+        assert(!linkedList_rpush(list, &i));
+        assert(!linkedList_rpush(other, &i));
+    }
+    assert(!linkedList_concat(list, other));
+    assert(linkedList_len(list) == 6);
+    linkedList_free(other);
+    linkedList_free(list);
+    nodePool_free(pool);
+}
+
+// 从节点池分配节点：独占节点池与共享节点池。
+static void testPool(void) {
+    LinkedList *list = linkedList_allocWithPool(sizeof(int), NULL);
+    assert(list);
+    int elem, res;
+    for (int r = 0; r < 2; r++) {
+        for (int i = 0; i < TEST_LENGTH; i++) {
+            elem = i;
+            size_t index = rand() % (linkedList_len(list) + 1u);
+            assert(!linkedList_insert(list, index, &elem));
+            assert(!linkedList_get(list, index, &res));
+            assert(res == elem);
+        }
+        for (int i = 0; i < TEST_LENGTH / 2; i++)
+            assert(!linkedList_del(list, rand() % linkedList_len(list)));
+        assert(linkedList_len(list) == TEST_LENGTH / 2);
+        assert(!linkedList_clear(list));
+        assert(!list->pool->slabs);
+    }
+    linkedList_free(list);
+
+    NodePool *pool = nodePool_alloc(16);
+    LinkedList *list0 = linkedList_allocWithPool(sizeof(int), pool);
+    LinkedList *list1 = linkedList_allocWithPool(sizeof(int), pool);
+    assert(list0 && list1);
+    assert(!linkedList_allocWithPool(sizeof(double[4]), pool));
+    for (int i = 0; i < 100; i++) {
+        assert(!linkedList_rpush(list0, &i));
+        assert(!linkedList_lpush(list1, &i));
+    }
+    for (int i = 0; i < 100; i++) {
+        assert(!linkedList_lpop(list0, &res));
+        assert(res == i);
+        assert(!linkedList_rpop(list1, &res));
+        assert(res == i);
+    }
+    void *freeNodes = pool->freeNodes;
+    assert(!linkedList_rpush(list0, &elem));
+    assert(!linkedList_lpop(list0, &res));
+    assert(pool->freeNodes == freeNodes); // 节点被复用
+    assert(!linkedList_rpush(list1, &elem));
+    linkedList_free(list0);
+    linkedList_free(list1);
+    nodePool_free(pool);
 }
 
 static int intCmp(const void *o1, const void *o2) {
@@ -127,3 +364,8 @@ static void intVisitor(void *p) {
     strncpy(s, buf, len);
     return len;
 }*/
+
+static int ctxIntCmp(const void *o1, const void *o2, void *ctx) {
+    int n1 = *(const int *) o1, n2 = *(const int *) o2;
+    return ((n1 > n2) - (n1 < n2)) * *(int *) ctx;
+}
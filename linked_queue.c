@@ -15,19 +15,41 @@
 
 #include "linked_queue.h"
 
+static void freeNode(const LinkedQueue *q, LinkQueueNode *node);
+
 LinkedQueue *linkedQueue_alloc(size_t elemSize) {
     LinkedQueue *q = malloc(sizeof(LinkedQueue));
     q->length = 0;
     q->front = q->rear = NULL;
     q->elemSize = elemSize;
+    q->pool = NULL;
+    q->ownPool = 0;
+    return q;
+}
+
+LinkedQueue *linkedQueue_allocWithPool(size_t elemSize, NodePool *pool) {
+    NodePool *nodePool = pool ? pool : nodePool_alloc(0);
+    if (nodePool_bind(nodePool, sizeof(LinkQueueNode) + elemSize)) {
+        if (!pool)
+            nodePool_free(nodePool);
+        return NULL;
+    }
+    LinkedQueue *q = linkedQueue_alloc(elemSize);
+    q->pool = nodePool;
+    q->ownPool = !pool;
     return q;
 }
 
 void linkedQueue_free(LinkedQueue *q) {
-    LinkQueueNode *node = q->front;
-    for (int i = 0; i < q->length; i++) {
-        free(node->elem);
-        node = node->next;
+    if (q->ownPool) {
+        nodePool_free(q->pool);
+    } else {
+        LinkQueueNode *node = q->rear;
+        for (size_t i = 0; i < q->length; i++) {
+            LinkQueueNode *next = node->next;
+            freeNode(q, node);
+            node = next;
+        }
     }
     q->length = q->elemSize = 0;
     q->front = q->rear = NULL;
@@ -35,8 +57,9 @@ void linkedQueue_free(LinkedQueue *q) {
 }
 
 int linkedQueue_into(LinkedQueue *q, const void *elem) {
-    LinkQueueNode *node = malloc(sizeof(LinkQueueNode));
-    node->elem = malloc(q->elemSize);
+    LinkQueueNode *node = q->pool ? nodePool_get(q->pool) : malloc(sizeof(LinkQueueNode) + q->elemSize);
+    if (node == NULL)
+        return 2;
     node->next = NULL;
     memcpy(node->elem, elem, q->elemSize);
 
@@ -56,13 +79,11 @@ int linkedQueue_exit(LinkedQueue *q, void *elem) {
     memcpy(elem, q->rear->elem, q->elemSize);
 
     if (q->length == 1) {
-        free(q->front->elem);
-        free(q->front);
+        freeNode(q, q->front);
         q->front = q->rear = NULL;
     } else {
         LinkQueueNode *node = q->rear->next;
-        free(q->rear->elem);
-        free(q->rear);
+        freeNode(q, q->rear);
         q->rear = node;
     }
 
@@ -73,3 +94,10 @@ int linkedQueue_exit(LinkedQueue *q, void *elem) {
 size_t linkedQueue_len(const LinkedQueue *q) {
     return q->length;
 }
+
+static void freeNode(const LinkedQueue *q, LinkQueueNode *node) {
+    if (q->pool)
+        nodePool_put(q->pool, node);
+    else
+        free(node);
+}
@@ -13,18 +13,23 @@
 #ifndef CLIB_LINKED_QUEUE_H
 #define CLIB_LINKED_QUEUE_H
 
+#include <stddef.h>
 #include <stdlib.h>
 
-// 队列节点。
+#include "node_pool.h"
+
+// 队列节点，元素值与节点在同一块内存中。
 typedef struct LinkQueueNode {
-    void *elem;
     struct LinkQueueNode *next;
+    _Alignas(max_align_t) unsigned char elem[];
 } LinkQueueNode;
 
 // 队列。
 typedef struct {
     LinkQueueNode *front, *rear;
     size_t elemSize, length;
+    NodePool *pool; // 节点池，NULL表示节点由malloc分配
+    _Bool ownPool;  // 节点池是否由队列独占
 } LinkedQueue;
 
 // 新建队列。
@@ -33,6 +38,14 @@ typedef struct {
 // 空间复杂度：O(1)
 LinkedQueue *linkedQueue_alloc(size_t elemSize);
 
+// 新建从节点池分配节点的队列。
+// elemSize：每个元素占用的字节大小。
+// pool：节点池，可在节点大小相同的队列间共享，由调用方销毁；NULL表示队列独占一个节点池。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+// 返回NULL: 节点池已绑定其它节点大小。
+LinkedQueue *linkedQueue_allocWithPool(size_t elemSize, NodePool *pool);
+
 // 销毁队列。
 // queue：队列。
 // 时间复杂度：O(1)
@@ -44,6 +57,7 @@ void linkedQueue_free(LinkedQueue *queue);
 // elem：被加入的元素。
 // 时间复杂度：O(1)
 // 空间复杂度：O(1)
+// 返回2: 内存不足。
 int linkedQueue_into(LinkedQueue *queue, const void *elem);
 
 // 从队列中取元素。
@@ -11,9 +11,11 @@
  */
 
 #include <assert.h>
+#include <stdint.h>
 #include <stdio.h>
 
 #include "linked_queue.c"
+#include "node_pool.c"
 
 int main(void) {
     LinkedQueue *queue = linkedQueue_alloc(sizeof(int));
@@ -28,4 +30,34 @@ int main(void) {
     }
 
     linkedQueue_free(queue);
+
+    queue = linkedQueue_allocWithPool(sizeof(int), NULL);
+    assert(queue);
+    for (int r = 0; r < 3; r++) {
+        for (int i = 0; i < 1000; i++) assert(!linkedQueue_into(queue, &i));
+        for (int i = 0; i < 1000; i++) {
+            int tmp;
+            assert(!linkedQueue_exit(queue, &tmp));
+            assert(tmp == i);
+        }
+    }
+    for (int i = 0; i < 10; i++) assert(!linkedQueue_into(queue, &i));
+    linkedQueue_free(queue);
+
+    NodePool *pool = nodePool_alloc(0);
+    queue = linkedQueue_allocWithPool(sizeof(int), pool);
+    assert(queue);
+    assert(!linkedQueue_allocWithPool(sizeof(double[4]), pool));
+    for (int i = 0; i < 10; i++) assert(!linkedQueue_into(queue, &i));
+    linkedQueue_free(queue);
+    nodePool_free(pool);
+
+    // 节点池无法分配时入队失败，队列不变。
+    pool = nodePool_alloc(SIZE_MAX / 1024);
+    queue = linkedQueue_allocWithPool(sizeof(int), pool);
+    int elem = 1;
+    assert(linkedQueue_into(queue, &elem) == 2);
+    assert(linkedQueue_exit(queue, &elem) == 1);
+    linkedQueue_free(queue);
+    nodePool_free(pool);
 }
@@ -10,35 +10,533 @@
  * See the Mulan PSL v2 for more details.
  */
 
+#include <pthread.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <unistd.h>
+
 #include "list.h"
 #include "array_list.h"
+#include "btree_list.h"
 #include "circle_linked_list.h"
+#include "deque_list.h"
 #include "double_linked_list.h"
 #include "linked_list.h"
+#include "skip_list.h"
 #include "static_linked_list.h"
+#include "thread_pool.h"
+#include "unrolled_list.h"
 
-List *list_alloc(size_t elemSize, ListImplType type) {
-    List *list = malloc(sizeof(List));
-    switch (type) {
-        case ListImplType_Array:
-            list->impl = arrayList_alloc(elemSize);
-            break;
-        case ListImplType_Linked:
-            list->impl = linkedList_alloc(elemSize);
-            break;
-        case ListImplType_DoubleLinked:
-            list->impl = doubleLinkedList_alloc(elemSize);
-            break;
-        case ListImplType_StaticLinked:
-            list->impl = staticLinkedList_alloc(elemSize);
-            break;
-        case ListImplType_CircleLinked:
-            list->impl = circleLinkedList_alloc(elemSize);
+extern void *pointerAdd(void *p1, size_t delta);
+
+extern void memorySort(void *base, size_t count, size_t size, ListElemCtxComparer cmp, void *ctx);
+
+extern int memorySortStable(void *base, size_t count, size_t size, ListElemCtxComparer cmp, void *ctx);
+
+static int sortByCopy(List *list, ListElemCtxComparer cmp, void *ctx, _Bool stable);
+
+static size_t bound(const List *list, ListElemCtxComparer cmp, const void *elem, void *ctx, _Bool upper);
+
+static _Bool validOps(const ListImplOps *ops);
+
+// 多线程操作每段至少的元素个数
+const static size_t ParallelGrain = 4096;
+
+// 一次多线程操作：[0, length)每grain个元素为一段，由共享线程池按段号递增分给各线程。
+typedef struct ParallelJob {
+    const List *list;
+    ListSpan span; // 连续存储时整个线性表的视图，base为NULL时经list_at取元素
+    size_t length, grain, chunks;
+    atomic_size_t limit; // 不再处理下标不小于该值的元素
+    atomic_int result;   // 遍历时访问器的非0返回值
+    void (*run)(struct ParallelJob *job, size_t from, size_t to, size_t chunk);
+    ListElemCtxVisitor *visit;
+    ListElemCtxComparer *cmp;
+    ListElemAccumulator *accumulate;
+    const void *elem;        // 查找的元素，归约时为结果初值
+    unsigned char *partials; // 归约时各段的部分结果
+    size_t resultSize;
+    void *ctx;
+} ParallelJob;
+
+static size_t parallelPrepare(ParallelJob *job, const List *list, size_t threads);
+
+static void parallelExecute(ParallelJob *job, size_t threads);
+
+static void parallelChunks(size_t from, size_t to, void *ctx);
+
+static void *parallelElem(const ParallelJob *job, size_t index);
+
+static void travelChunk(ParallelJob *job, size_t from, size_t to, size_t chunk);
+
+static void locateChunk(ParallelJob *job, size_t from, size_t to, size_t chunk);
+
+static void reduceChunk(ParallelJob *job, size_t from, size_t to, size_t chunk);
+
+static int reduceVisitor(void *elem, void *ctx);
+
+// 生成内置实现的适配函数，将实现函数包装为操作表所需的签名。
+#define LIST_IMPL_ADAPTERS(prefix)                                                                      \
+    static void prefix##Free(void *impl) { prefix##_free(impl); }                                       \
+    static size_t prefix##Len(const void *impl) { return prefix##_len(impl); }                          \
+    static int prefix##Get(const void *impl, size_t index, void *elem) {                                \
+        return prefix##_get(impl, index, elem);                                                         \
+    }                                                                                                   \
+    static int prefix##Insert(void *impl, size_t index, const void *elem) {                             \
+        return prefix##_insert(impl, index, elem);                                                      \
+    }                                                                                                   \
+    static int prefix##Del(void *impl, size_t index) { return prefix##_del(impl, index); }              \
+    static int prefix##Locate(const void *impl, ListElemComparer cmp, const void *elem, size_t *index) { \
+        return prefix##_locate(impl, cmp, elem, index);                                                 \
+    }                                                                                                   \
+    static int prefix##Travel(const void *impl, ListElemVisitor visit) {                                \
+        return prefix##_travel(impl, visit);                                                            \
+    }                                                                                                   \
+    static int prefix##LocateCtx(const void *impl, ListElemCtxComparer cmp, const void *elem, void *ctx, \
+                                 size_t *index) {                                                       \
+        return prefix##_locateCtx(impl, cmp, elem, ctx, index);                                         \
+    }                                                                                                   \
+    static int prefix##TravelCtx(const void *impl, ListElemCtxVisitor visit, void *ctx) {               \
+        return prefix##_travelCtx(impl, visit, ctx);                                                    \
+    }                                                                                                   \
+    static int prefix##Clear(void *impl) { return prefix##_clear(impl); }                               \
+    static int prefix##Rpop(void *impl, void *elem) { return prefix##_rpop(impl, elem); }               \
+    static int prefix##Lpush(void *impl, const void *elem) { return prefix##_lpush(impl, elem); }       \
+    static int prefix##Rpush(void *impl, const void *elem) { return prefix##_rpush(impl, elem); }       \
+    static int prefix##Lpop(void *impl, void *elem) { return prefix##_lpop(impl, elem); }               \
+    static int prefix##Set(void *impl, size_t index, const void *elem) {                                \
+        return prefix##_set(impl, index, elem);                                                         \
+    }                                                                                                   \
+    static int prefix##GetDel(void *impl, size_t index, void *elem) {                                   \
+        return prefix##_getDel(impl, index, elem);                                                      \
+    }                                                                                                   \
+    static int prefix##GetSet(void *impl, size_t index, void *elem) {                                   \
+        return prefix##_getSet(impl, index, elem);                                                      \
+    }                                                                                                   \
+    static int prefix##Fprint(const void *impl, FILE *f, ListElemToString str, size_t sizeOfElem) {     \
+        return prefix##_fprint(impl, f, str, sizeOfElem);                                               \
+    }
+
+// 生成内置实现操作表的公共部分。
+#define LIST_IMPL_OPS(prefix)       \
+    .free = prefix##Free,           \
+    .len = prefix##Len,             \
+    .get = prefix##Get,             \
+    .insert = prefix##Insert,       \
+    .del = prefix##Del,             \
+    .locate = prefix##Locate,       \
+    .travel = prefix##Travel,       \
+    .locateCtx = prefix##LocateCtx, \
+    .travelCtx = prefix##TravelCtx, \
+    .clear = prefix##Clear,         \
+    .rpop = prefix##Rpop,           \
+    .lpush = prefix##Lpush,         \
+    .rpush = prefix##Rpush,         \
+    .lpop = prefix##Lpop,           \
+    .set = prefix##Set,             \
+    .getDel = prefix##GetDel,       \
+    .getSet = prefix##GetSet,       \
+    .fprint = prefix##Fprint
+
+// 生成链式实现迭代操作的适配函数。
+#define LIST_ITER_ADAPTERS(prefix)                                                          \
+    static void prefix##IterBegin(const void *impl, ListCursor *cursor) {                   \
+        prefix##_iterBegin(impl, cursor);                                                   \
+    }                                                                                       \
+    static int prefix##IterNext(const void *impl, ListCursor *cursor) {                     \
+        return prefix##_iterNext(impl, cursor);                                             \
+    }                                                                                       \
+    static void *prefix##IterAt(const void *impl, const ListCursor *cursor) {               \
+        return prefix##_iterAt(impl, cursor);                                               \
+    }                                                                                       \
+    static int prefix##IterInsertBefore(void *impl, ListCursor *cursor, const void *elem) { \
+        return prefix##_iterInsertBefore(impl, cursor, elem);                               \
+    }                                                                                       \
+    static int prefix##IterErase(void *impl, ListCursor *cursor, void *elem) {              \
+        return prefix##_iterErase(impl, cursor, elem);                                      \
+    }
+
+// 生成链式实现操作表的迭代部分。
+#define LIST_ITER_OPS(prefix)                     \
+    .iterBegin = prefix##IterBegin,               \
+    .iterNext = prefix##IterNext,                 \
+    .iterAt = prefix##IterAt,                     \
+    .iterInsertBefore = prefix##IterInsertBefore, \
+    .iterErase = prefix##IterErase
+
+LIST_IMPL_ADAPTERS(arrayList)
+
+LIST_IMPL_ADAPTERS(linkedList)
+
+LIST_ITER_ADAPTERS(linkedList)
+
+LIST_IMPL_ADAPTERS(doubleLinkedList)
+
+LIST_ITER_ADAPTERS(doubleLinkedList)
+
+LIST_IMPL_ADAPTERS(staticLinkedList)
+
+LIST_IMPL_ADAPTERS(circleLinkedList)
+
+LIST_ITER_ADAPTERS(circleLinkedList)
+
+LIST_IMPL_ADAPTERS(dequeList)
+
+LIST_IMPL_ADAPTERS(skipList)
+
+LIST_ITER_ADAPTERS(skipList)
+
+LIST_IMPL_ADAPTERS(btreeList)
+
+LIST_ITER_ADAPTERS(btreeList)
+
+LIST_IMPL_ADAPTERS(unrolledList)
+
+LIST_ITER_ADAPTERS(unrolledList)
+
+static void *arrayListAlloc(size_t elemSize, const ListOptions *opts) {
+    return arrayList_allocWithPolicy(elemSize, opts ? opts->growth : NULL);
+}
+
+static void *linkedListAlloc(size_t elemSize, const ListOptions *opts) {
+    if (opts && opts->usePool)
+        return linkedList_allocWithPool(elemSize, opts->pool);
+    return linkedList_alloc(elemSize);
+}
+
+static void *doubleLinkedListAlloc(size_t elemSize, const ListOptions *opts) {
+    if (opts && opts->usePool)
+        return doubleLinkedList_allocWithPool(elemSize, opts->pool);
+    return doubleLinkedList_alloc(elemSize);
+}
+
+static void *staticLinkedListAlloc(size_t elemSize, const ListOptions *opts) {
+    if (!opts)
+        return staticLinkedList_alloc(elemSize);
+    return staticLinkedList_allocWithIndexWidth(elemSize, opts->growth, opts->indexWidth);
+}
+
+static void *circleLinkedListAlloc(size_t elemSize, const ListOptions *opts) {
+    if (opts && opts->usePool)
+        return circleLinkedList_allocWithPool(elemSize, opts->pool);
+    return circleLinkedList_alloc(elemSize);
+}
+
+static void *dequeListAlloc(size_t elemSize, const ListOptions *opts) {
+    return dequeList_allocWithPolicy(elemSize, opts ? opts->growth : NULL);
+}
+
+static void *skipListAlloc(size_t elemSize, const ListOptions *opts) {
+    return skipList_alloc(elemSize);
+}
+
+static void *btreeListAlloc(size_t elemSize, const ListOptions *opts) {
+    return btreeList_alloc(elemSize);
+}
+
+static void *unrolledListAlloc(size_t elemSize, const ListOptions *opts) {
+    return unrolledList_allocWithBlockSize(elemSize, opts ? opts->blockSize : 0);
+}
+
+static int arrayListInsertRange(void *impl, size_t index, const void *elems, size_t count) {
+    return arrayList_insertRange(impl, index, elems, count);
+}
+
+static int arrayListDelRange(void *impl, size_t index, size_t count) {
+    return arrayList_delRange(impl, index, count);
+}
+
+static int arrayListGetRange(const void *impl, size_t index, size_t count, void *elems) {
+    return arrayList_getRange(impl, index, count, elems);
+}
+
+static int arrayListReserve(void *impl, size_t capacity) {
+    return arrayList_reserve(impl, capacity);
+}
+
+static int arrayListShrinkToFit(void *impl) {
+    return arrayList_shrinkToFit(impl);
+}
+
+static int arrayListSort(void *impl, ListElemCtxComparer cmp, void *ctx) {
+    return arrayList_sort(impl, cmp, ctx);
+}
+
+static int arrayListSortStable(void *impl, ListElemCtxComparer cmp, void *ctx) {
+    return arrayList_sortStable(impl, cmp, ctx);
+}
+
+static int arrayListLowerBound(const void *impl, ListElemCtxComparer cmp, const void *elem, void *ctx,
+                               size_t *index) {
+    return arrayList_lowerBound(impl, cmp, elem, ctx, index);
+}
+
+static int arrayListUpperBound(const void *impl, ListElemCtxComparer cmp, const void *elem, void *ctx,
+                               size_t *index) {
+    return arrayList_upperBound(impl, cmp, elem, ctx, index);
+}
+
+static int arrayListLocateBytes(const void *impl, size_t offset, const void *key, size_t keySize, size_t *index) {
+    return arrayList_locateKey(impl, offset, key, keySize, index);
+}
+
+static int staticLinkedListSort(void *impl, ListElemCtxComparer cmp, void *ctx) {
+    return staticLinkedList_sort(impl, cmp, ctx);
+}
+
+static int staticLinkedListSortStable(void *impl, ListElemCtxComparer cmp, void *ctx) {
+    return staticLinkedList_sortStable(impl, cmp, ctx);
+}
+
+// 链表的归并排序本身稳定，两种排序共用。
+static int linkedListSort(void *impl, ListElemCtxComparer cmp, void *ctx) {
+    return linkedList_sort(impl, cmp, ctx);
+}
+
+static int doubleLinkedListSort(void *impl, ListElemCtxComparer cmp, void *ctx) {
+    return doubleLinkedList_sort(impl, cmp, ctx);
+}
+
+static int circleLinkedListSort(void *impl, ListElemCtxComparer cmp, void *ctx) {
+    return circleLinkedList_sort(impl, cmp, ctx);
+}
+
+static int staticLinkedListReserve(void *impl, size_t capacity) {
+    return staticLinkedList_reserve(impl, capacity);
+}
+
+static int staticLinkedListShrinkToFit(void *impl) {
+    return staticLinkedList_shrinkToFit(impl);
+}
+
+static void *arrayListAt(const void *impl, size_t index) {
+    return arrayList_at(impl, index);
+}
+
+static int arrayListSpan(const void *impl, size_t index, size_t count, ListSpan *span) {
+    return arrayList_span(impl, index, count, span);
+}
+
+static void *linkedListAt(const void *impl, size_t index) {
+    return linkedList_at(impl, index);
+}
+
+static void *doubleLinkedListAt(const void *impl, size_t index) {
+    return doubleLinkedList_at(impl, index);
+}
+
+static void *staticLinkedListAt(const void *impl, size_t index) {
+    return staticLinkedList_at(impl, index);
+}
+
+static void *circleLinkedListAt(const void *impl, size_t index) {
+    return circleLinkedList_at(impl, index);
+}
+
+static int dequeListReserve(void *impl, size_t capacity) {
+    return dequeList_reserve(impl, capacity);
+}
+
+static int dequeListShrinkToFit(void *impl) {
+    return dequeList_shrinkToFit(impl);
+}
+
+static void *dequeListAt(const void *impl, size_t index) {
+    return dequeList_at(impl, index);
+}
+
+static int dequeListLocateBytes(const void *impl, size_t offset, const void *key, size_t keySize, size_t *index) {
+    return dequeList_locateKey(impl, offset, key, keySize, index);
+}
+
+static void *skipListAt(const void *impl, size_t index) {
+    return skipList_at(impl, index);
+}
+
+static void *btreeListAt(const void *impl, size_t index) {
+    return btreeList_at(impl, index);
+}
+
+static int btreeListGetRange(const void *impl, size_t index, size_t count, void *elems) {
+    return btreeList_getRange(impl, index, count, elems);
+}
+
+static int btreeListLocateBytes(const void *impl, size_t offset, const void *key, size_t keySize, size_t *index) {
+    return btreeList_locateKey(impl, offset, key, keySize, index);
+}
+
+static int btreeListSpan(const void *impl, size_t index, size_t count, ListSpan *span) {
+    return btreeList_span(impl, index, count, span);
+}
+
+static int btreeListTravelRange(const void *impl, size_t index, size_t count, ListElemCtxVisitor visit, void *ctx) {
+    return btreeList_travelRange(impl, index, count, visit, ctx);
+}
+
+static void *unrolledListAt(const void *impl, size_t index) {
+    return unrolledList_at(impl, index);
+}
+
+static int unrolledListGetRange(const void *impl, size_t index, size_t count, void *elems) {
+    return unrolledList_getRange(impl, index, count, elems);
+}
+
+static int unrolledListLocateBytes(const void *impl, size_t offset, const void *key, size_t keySize,
+                                   size_t *index) {
+    return unrolledList_locateKey(impl, offset, key, keySize, index);
+}
+
+static int unrolledListSpan(const void *impl, size_t index, size_t count, ListSpan *span) {
+    return unrolledList_span(impl, index, count, span);
+}
+
+static int unrolledListTravelRange(const void *impl, size_t index, size_t count, ListElemCtxVisitor visit,
+                                   void *ctx) {
+    return unrolledList_travelRange(impl, index, count, visit, ctx);
+}
+
+static const ListImplOps arrayListOps = {
+        LIST_IMPL_OPS(arrayList),
+        .alloc = arrayListAlloc,
+        .insertRange = arrayListInsertRange,
+        .delRange = arrayListDelRange,
+        .getRange = arrayListGetRange,
+        .reserve = arrayListReserve,
+        .shrinkToFit = arrayListShrinkToFit,
+        .at = arrayListAt,
+        .span = arrayListSpan,
+        .sort = arrayListSort,
+        .sortStable = arrayListSortStable,
+        .lowerBound = arrayListLowerBound,
+        .upperBound = arrayListUpperBound,
+        .locateBytes = arrayListLocateBytes,
+};
+
+static const ListImplOps linkedListOps = {
+        LIST_IMPL_OPS(linkedList),
+        .alloc = linkedListAlloc,
+        .at = linkedListAt,
+        .sort = linkedListSort,
+        .sortStable = linkedListSort,
+        LIST_ITER_OPS(linkedList),
+};
+
+static const ListImplOps doubleLinkedListOps = {
+        LIST_IMPL_OPS(doubleLinkedList),
+        .alloc = doubleLinkedListAlloc,
+        .at = doubleLinkedListAt,
+        .sort = doubleLinkedListSort,
+        .sortStable = doubleLinkedListSort,
+        LIST_ITER_OPS(doubleLinkedList),
+};
+
+static const ListImplOps staticLinkedListOps = {
+        LIST_IMPL_OPS(staticLinkedList),
+        .alloc = staticLinkedListAlloc,
+        .reserve = staticLinkedListReserve,
+        .shrinkToFit = staticLinkedListShrinkToFit,
+        .at = staticLinkedListAt,
+        .sort = staticLinkedListSort,
+        .sortStable = staticLinkedListSortStable,
+};
+
+static const ListImplOps circleLinkedListOps = {
+        LIST_IMPL_OPS(circleLinkedList),
+        .alloc = circleLinkedListAlloc,
+        .at = circleLinkedListAt,
+        .sort = circleLinkedListSort,
+        .sortStable = circleLinkedListSort,
+        LIST_ITER_OPS(circleLinkedList),
+};
+
+static const ListImplOps dequeListOps = {
+        LIST_IMPL_OPS(dequeList),
+        .alloc = dequeListAlloc,
+        .reserve = dequeListReserve,
+        .shrinkToFit = dequeListShrinkToFit,
+        .at = dequeListAt,
+        .locateBytes = dequeListLocateBytes,
+};
+
+static const ListImplOps skipListOps = {
+        LIST_IMPL_OPS(skipList),
+        .alloc = skipListAlloc,
+        .at = skipListAt,
+        LIST_ITER_OPS(skipList),
+};
+
+static const ListImplOps btreeListOps = {
+        LIST_IMPL_OPS(btreeList),
+        .alloc = btreeListAlloc,
+        .getRange = btreeListGetRange,
+        .at = btreeListAt,
+        .span = btreeListSpan,
+        .locateBytes = btreeListLocateBytes,
+        .travelRange = btreeListTravelRange,
+        LIST_ITER_OPS(btreeList),
+};
+
+static const ListImplOps unrolledListOps = {
+        LIST_IMPL_OPS(unrolledList),
+        .alloc = unrolledListAlloc,
+        .getRange = unrolledListGetRange,
+        .at = unrolledListAt,
+        .span = unrolledListSpan,
+        .locateBytes = unrolledListLocateBytes,
+        .travelRange = unrolledListTravelRange,
+        LIST_ITER_OPS(unrolledList),
+};
+
+// 已注册的实现，下标为实现类型。
+static const ListImplOps *impls[ListImplType_Max] = {
+        [ListImplType_Array] = &arrayListOps,
+        [ListImplType_Linked] = &linkedListOps,
+        [ListImplType_DoubleLinked] = &doubleLinkedListOps,
+        [ListImplType_StaticLinked] = &staticLinkedListOps,
+        [ListImplType_CircleLinked] = &circleLinkedListOps,
+        [ListImplType_Deque] = &dequeListOps,
+        [ListImplType_SkipList] = &skipListOps,
+        [ListImplType_BTree] = &btreeListOps,
+        [ListImplType_Unrolled] = &unrolledListOps,
+};
+
+// 保护impls中自定义实现的槽位。
+static pthread_mutex_t implsLock = PTHREAD_MUTEX_INITIALIZER;
+
+int list_registerImpl(const ListImplOps *ops, ListImplType *type) {
+    if (!validOps(ops))
+        return 3;
+    int res = 1;
+    pthread_mutex_lock(&implsLock);
+    for (int i = ListImplType_Custom; i < ListImplType_Max; i++) {
+        if (!impls[i]) {
+            impls[i] = ops;
+            *type = (ListImplType) i;
+            res = 0;
             break;
-        default:
-            return NULL;
+        }
     }
+    pthread_mutex_unlock(&implsLock);
+    return res;
+}
+
+List *list_alloc(size_t elemSize, ListImplType type) {
+    return list_allocWithOptions(elemSize, type, NULL);
+}
+
+List *list_allocWithOptions(size_t elemSize, ListImplType type, const ListOptions *opts) {
+    if (type < 0 || type >= ListImplType_Max)
+        return NULL;
+    pthread_mutex_lock(&implsLock);
+    const ListImplOps *ops = impls[type];
+    pthread_mutex_unlock(&implsLock);
+    if (!ops)
+        return NULL;
+    List *list = malloc(sizeof(List));
     list->type = type;
+    list->ops = ops;
+    list->elemSize = elemSize;
+    list->impl = list->ops->alloc(elemSize, opts);
     if (!list->impl) {
         free(list);
         return NULL;
@@ -47,277 +545,496 @@ List *list_alloc(size_t elemSize, ListImplType type) {
 }
 
 void list_free(List *list) {
-    switch (list->type) {
-        case ListImplType_Array:
-            arrayList_free(list->impl);
-            break;
-        case ListImplType_Linked:
-            linkedList_free(list->impl);
-            break;
-        case ListImplType_DoubleLinked:
-            doubleLinkedList_free(list->impl);
-            break;
-        case ListImplType_StaticLinked:
-            staticLinkedList_free(list->impl);
-            break;
-        case ListImplType_CircleLinked:
-            circleLinkedList_free(list->impl);
-            break;
-    }
+    list->ops->free(list->impl);
     free(list);
 }
 
 size_t list_len(const List *list) {
-    switch (list->type) {
-        case ListImplType_Array:
-            return arrayList_len(list->impl);
-        case ListImplType_Linked:
-            return linkedList_len(list->impl);
-        case ListImplType_DoubleLinked:
-            return doubleLinkedList_len(list->impl);
-        case ListImplType_StaticLinked:
-            return staticLinkedList_len(list->impl);
-        case ListImplType_CircleLinked:
-            return circleLinkedList_len(list->impl);
-        default:
-            return 0;
-    }
+    return list->ops->len(list->impl);
 }
 
 int list_get(const List *list, size_t index, void *elem) {
-    switch (list->type) {
-        case ListImplType_Array:
-            return arrayList_get(list->impl, index, elem);
-        case ListImplType_Linked:
-            return linkedList_get(list->impl, index, elem);
-        case ListImplType_DoubleLinked:
-            return doubleLinkedList_get(list->impl, index, elem);
-        case ListImplType_StaticLinked:
-            return staticLinkedList_get(list->impl, index, elem);
-        case ListImplType_CircleLinked:
-            return circleLinkedList_get(list->impl, index, elem);
-        default:
-            return 1;
-    }
+    return list->ops->get(list->impl, index, elem);
 }
 
 int list_insert(List *list, size_t index, const void *elem) {
-    switch (list->type) {
-        case ListImplType_Array:
-            return arrayList_insert(list->impl, index, elem);
-        case ListImplType_Linked:
-            return linkedList_insert(list->impl, index, elem);
-        case ListImplType_DoubleLinked:
-            return doubleLinkedList_insert(list->impl, index, elem);
-        case ListImplType_StaticLinked:
-            return staticLinkedList_insert(list->impl, index, elem);
-        case ListImplType_CircleLinked:
-            return circleLinkedList_insert(list->impl, index, elem);
-        default:
-            return 1;
-    }
+    return list->ops->insert(list->impl, index, elem);
 }
 
 int list_del(List *list, size_t index) {
-    switch (list->type) {
-        case ListImplType_Array:
-            return arrayList_del(list->impl, index);
-        case ListImplType_Linked:
-            return linkedList_del(list->impl, index);
-        case ListImplType_DoubleLinked:
-            return doubleLinkedList_del(list->impl, index);
-        case ListImplType_StaticLinked:
-            return staticLinkedList_del(list->impl, index);
-        case ListImplType_CircleLinked:
-            return circleLinkedList_del(list->impl, index);
-        default:
-            return 1;
-    }
+    return list->ops->del(list->impl, index);
 }
 
 int list_locate(const List *list, ListElemComparer cmp, const void *elem, size_t *index) {
-    switch (list->type) {
-        case ListImplType_Array:
-            return arrayList_locate(list->impl, cmp, elem, index);
-        case ListImplType_Linked:
-            return linkedList_locate(list->impl, cmp, elem, index);
-        case ListImplType_DoubleLinked:
-            return doubleLinkedList_locate(list->impl, cmp, elem, index);
-        case ListImplType_StaticLinked:
-            return staticLinkedList_locate(list->impl, cmp, elem, index);
-        case ListImplType_CircleLinked:
-            return circleLinkedList_locate(list->impl, cmp, elem, index);
-        default:
-            return 1;
-    }
+    return list->ops->locate(list->impl, cmp, elem, index);
 }
 
 int list_travel(const List *list, ListElemVisitor visit) {
-    switch (list->type) {
-        case ListImplType_Array:
-            return arrayList_travel(list->impl, visit);
-        case ListImplType_Linked:
-            return linkedList_travel(list->impl, visit);
-        case ListImplType_DoubleLinked:
-            return doubleLinkedList_travel(list->impl, visit);
-        case ListImplType_StaticLinked:
-            return staticLinkedList_travel(list->impl, visit);
-        case ListImplType_CircleLinked:
-            return circleLinkedList_travel(list->impl, visit);
-        default:
-            return 1;
+    return list->ops->travel(list->impl, visit);
+}
+
+int list_locateCtx(const List *list, ListElemCtxComparer cmp, const void *elem, void *ctx, size_t *index) {
+    return list->ops->locateCtx(list->impl, cmp, elem, ctx, index);
+}
+
+int list_locateBytes(const List *list, size_t offset, const void *key, size_t keySize, size_t *index) {
+    if (list->ops->locateBytes)
+        return list->ops->locateBytes(list->impl, offset, key, keySize, index);
+    if (offset > list->elemSize || keySize > list->elemSize - offset)
+        return 1;
+    unsigned char buf[list->elemSize];
+    ListIter iter;
+    for (list_iterBegin(list, &iter); !list_iterEnd(&iter); list_iterNext(&iter)) {
+        unsigned char *elem = list_iterAt(&iter);
+        if (elem == NULL) {
+            list_iterGet(&iter, buf);
+            elem = buf;
+        }
+        if (!memcmp(elem + offset, key, keySize)) {
+            *index = iter.cursor.index;
+            return 0;
+        }
     }
+    return 1;
 }
 
-int list_clear(List *list) {
-    switch (list->type) {
-        case ListImplType_Array:
-            return arrayList_clear(list->impl);
-        case ListImplType_Linked:
-            return linkedList_clear(list->impl);
-        case ListImplType_DoubleLinked:
-            return doubleLinkedList_clear(list->impl);
-        case ListImplType_StaticLinked:
-            return staticLinkedList_clear(list->impl);
-        case ListImplType_CircleLinked:
-            return circleLinkedList_clear(list->impl);
-        default:
-            return 1;
+int list_travelCtx(const List *list, ListElemCtxVisitor visit, void *ctx) {
+    return list->ops->travelCtx(list->impl, visit, ctx);
+}
+
+// 未提供时用迭代器逐个访问，不能取得元素地址的实现先复制出元素。
+int list_travelRange(const List *list, size_t index, size_t count, ListElemCtxVisitor visit, void *ctx) {
+    if (list->ops->travelRange)
+        return list->ops->travelRange(list->impl, index, count, visit, ctx);
+    size_t length = list_len(list);
+    if (index > length || count > length - index)
+        return 1;
+    ListIter iter;
+    list_iterBegin(list, &iter);
+    if (list->ops->iterBegin) {
+        for (size_t i = 0; i < index; i++)
+            list_iterNext(&iter);
+    } else {
+        iter.cursor.index = index;
     }
+    unsigned char buf[list->elemSize];
+    for (; count; count--, list_iterNext(&iter)) {
+        void *elem = list_iterAt(&iter);
+        if (elem == NULL) {
+            list_iterGet(&iter, buf);
+            elem = buf;
+        }
+        int res = visit(elem, ctx);
+        if (res)
+            return res;
+    }
+    return 0;
 }
 
-int list_rpop(List *list, void *elem) {
-    switch (list->type) {
-        case ListImplType_Array:
-            return arrayList_rpop(list->impl, elem);
-        case ListImplType_Linked:
-            return linkedList_rpop(list->impl, elem);
-        case ListImplType_DoubleLinked:
-            return doubleLinkedList_rpop(list->impl, elem);
-        case ListImplType_StaticLinked:
-            return staticLinkedList_rpop(list->impl, elem);
-        case ListImplType_CircleLinked:
-            return circleLinkedList_rpop(list->impl, elem);
-        default:
-            return 1;
+int list_parallelTravel(const List *list, ListElemCtxVisitor visit, void *ctx, size_t threads) {
+    ParallelJob job = {.run = travelChunk, .visit = visit, .ctx = ctx};
+    size_t workers = parallelPrepare(&job, list, threads);
+    if (!workers)
+        return list_travelCtx(list, visit, ctx);
+    parallelExecute(&job, workers);
+    return atomic_load(&job.result);
+}
+
+int list_parallelLocate(const List *list, ListElemCtxComparer cmp, const void *elem, void *ctx, size_t *index,
+                        size_t threads) {
+    ParallelJob job = {.run = locateChunk, .cmp = cmp, .elem = elem, .ctx = ctx};
+    size_t workers = parallelPrepare(&job, list, threads);
+    if (!workers)
+        return list_locateCtx(list, cmp, elem, ctx, index);
+    parallelExecute(&job, workers);
+    size_t found = atomic_load(&job.limit);
+    if (found >= job.length)
+        return 1;
+    *index = found;
+    return 0;
+}
+
+int list_parallelReduce(const List *list, ListElemAccumulator accumulate, ListAccCombiner combine, void *result,
+                        size_t resultSize, void *ctx, size_t threads) {
+    ParallelJob job = {.run = reduceChunk, .accumulate = accumulate, .elem = result, .resultSize = resultSize,
+                       .ctx = ctx};
+    size_t workers = parallelPrepare(&job, list, threads);
+    if (!workers) {
+        job.partials = result;
+        return list_travelCtx(list, reduceVisitor, &job);
     }
+    if (!job.chunks) // 空表没有分段，result保持初值
+        return 0;
+    job.partials = malloc(job.chunks * resultSize);
+    if (job.partials == NULL)
+        return 2;
+    parallelExecute(&job, workers);
+    for (size_t i = 0; i < job.chunks; i++)
+        combine(result, job.partials + i * resultSize, ctx);
+    free(job.partials);
+    return 0;
+}
+
+int list_clear(List *list) {
+    return list->ops->clear(list->impl);
+}
+
+int list_rpop(List *list, void *elem) {
+    return list->ops->rpop(list->impl, elem);
 }
 
 int list_lpush(List *list, const void *elem) {
-    switch (list->type) {
-        case ListImplType_Array:
-            return arrayList_lpush(list->impl, elem);
-        case ListImplType_Linked:
-            return linkedList_lpush(list->impl, elem);
-        case ListImplType_DoubleLinked:
-            return doubleLinkedList_lpush(list->impl, elem);
-        case ListImplType_StaticLinked:
-            return staticLinkedList_lpush(list->impl, elem);
-        case ListImplType_CircleLinked:
-            return circleLinkedList_lpush(list->impl, elem);
-        default:
-            return 1;
-    }
+    return list->ops->lpush(list->impl, elem);
 }
 
 int list_rpush(List *list, const void *elem) {
-    switch (list->type) {
-        case ListImplType_Array:
-            return arrayList_rpush(list->impl, elem);
-        case ListImplType_Linked:
-            return linkedList_rpush(list->impl, elem);
-        case ListImplType_DoubleLinked:
-            return doubleLinkedList_rpush(list->impl, elem);
-        case ListImplType_StaticLinked:
-            return staticLinkedList_rpush(list->impl, elem);
-        case ListImplType_CircleLinked:
-            return circleLinkedList_rpush(list->impl, elem);
-        default:
-            return 1;
-    }
+    return list->ops->rpush(list->impl, elem);
 }
 
 int list_lpop(List *list, void *elem) {
-    switch (list->type) {
-        case ListImplType_Array:
-            return arrayList_lpop(list->impl, elem);
-        case ListImplType_Linked:
-            return linkedList_lpop(list->impl, elem);
-        case ListImplType_DoubleLinked:
-            return doubleLinkedList_lpop(list->impl, elem);
-        case ListImplType_StaticLinked:
-            return staticLinkedList_lpop(list->impl, elem);
-        case ListImplType_CircleLinked:
-            return circleLinkedList_lpop(list->impl, elem);
-        default:
-            return 1;
-    }
+    return list->ops->lpop(list->impl, elem);
 }
 
 int list_set(const List *list, size_t index, const void *elem) {
-    switch (list->type) {
-        case ListImplType_Array:
-            return arrayList_set(list->impl, index, elem);
-        case ListImplType_Linked:
-            return linkedList_set(list->impl, index, elem);
-        case ListImplType_DoubleLinked:
-            return doubleLinkedList_set(list->impl, index, elem);
-        case ListImplType_StaticLinked:
-            return staticLinkedList_set(list->impl, index, elem);
-        case ListImplType_CircleLinked:
-            return circleLinkedList_set(list->impl, index, elem);
-        default:
-            return 1;
-    }
+    return list->ops->set(list->impl, index, elem);
 }
 
 int list_getDel(List *list, size_t index, void *elem) {
-    switch (list->type) {
-        case ListImplType_Array:
-            return arrayList_getDel(list->impl, index, elem);
-        case ListImplType_Linked:
-            return linkedList_getDel(list->impl, index, elem);
-        case ListImplType_DoubleLinked:
-            return doubleLinkedList_getDel(list->impl, index, elem);
-        case ListImplType_StaticLinked:
-            return staticLinkedList_getDel(list->impl, index, elem);
-        case ListImplType_CircleLinked:
-            return circleLinkedList_getDel(list->impl, index, elem);
-        default:
-            return 1;
-    }
+    return list->ops->getDel(list->impl, index, elem);
 }
 
 int list_getSet(const List *list, size_t index, void *elem) {
-    switch (list->type) {
-        case ListImplType_Array:
-            return arrayList_getSet(list->impl, index, elem);
-        case ListImplType_Linked:
-            return linkedList_getSet(list->impl, index, elem);
-        case ListImplType_DoubleLinked:
-            return doubleLinkedList_getSet(list->impl, index, elem);
-        case ListImplType_StaticLinked:
-            return staticLinkedList_getSet(list->impl, index, elem);
-        case ListImplType_CircleLinked:
-            return circleLinkedList_getSet(list->impl, index, elem);
-        default:
-            return 1;
-    }
+    return list->ops->getSet(list->impl, index, elem);
 }
 
 int list_fprint(const List *list, FILE *f, ListElemToString str, size_t sizeOfElem) {
-    switch (list->type) {
-        case ListImplType_Array:
-            return arrayList_fprint(list->impl, f, str, sizeOfElem);
-        case ListImplType_Linked:
-            return linkedList_fprint(list->impl, f, str, sizeOfElem);
-        case ListImplType_DoubleLinked:
-            return doubleLinkedList_fprint(list->impl, f, str, sizeOfElem);
-        case ListImplType_StaticLinked:
-            return staticLinkedList_fprint(list->impl, f, str, sizeOfElem);
-        case ListImplType_CircleLinked:
-            return circleLinkedList_fprint(list->impl, f, str, sizeOfElem);
-        default:
-            return 1;
+    return list->ops->fprint(list->impl, f, str, sizeOfElem);
+}
+
+int list_insertRange(List *list, size_t index, const void *elems, size_t count) {
+    if (list->ops->insertRange)
+        return list->ops->insertRange(list->impl, index, elems, count);
+    if (index > list_len(list))
+        return 1;
+    // 中途失败时删除已插入的元素，线性表保持原样。
+    for (size_t i = 0; i < count; i++) {
+        int res = list->ops->insert(list->impl, index + i, pointerAdd((void *) elems, i * list->elemSize));
+        if (res) {
+            while (i--)
+                list->ops->del(list->impl, index + i);
+            return res;
+        }
+    }
+    return 0;
+}
+
+int list_delRange(List *list, size_t index, size_t count) {
+    if (list->ops->delRange)
+        return list->ops->delRange(list->impl, index, count);
+    size_t length = list_len(list);
+    if (index > length || count > length - index)
+        return 1;
+    for (size_t i = 0; i < count; i++)
+        list->ops->del(list->impl, index);
+    return 0;
+}
+
+int list_rpushN(List *list, const void *elems, size_t count) {
+    return list_insertRange(list, list_len(list), elems, count);
+}
+
+int list_getRange(const List *list, size_t index, size_t count, void *elems) {
+    if (list->ops->getRange)
+        return list->ops->getRange(list->impl, index, count, elems);
+    size_t length = list_len(list);
+    if (index > length || count > length - index)
+        return 1;
+    for (size_t i = 0; i < count; i++)
+        list->ops->get(list->impl, index + i, pointerAdd(elems, i * list->elemSize));
+    return 0;
+}
+
+int list_reserve(List *list, size_t capacity) {
+    if (list->ops->reserve)
+        return list->ops->reserve(list->impl, capacity);
+    return 0;
+}
+
+int list_shrinkToFit(List *list) {
+    if (list->ops->shrinkToFit)
+        return list->ops->shrinkToFit(list->impl);
+    return 0;
+}
+
+int list_sort(List *list, ListElemCtxComparer cmp, void *ctx) {
+    if (list->ops->sort)
+        return list->ops->sort(list->impl, cmp, ctx);
+    return sortByCopy(list, cmp, ctx, 0);
+}
+
+int list_sortStable(List *list, ListElemCtxComparer cmp, void *ctx) {
+    if (list->ops->sortStable)
+        return list->ops->sortStable(list->impl, cmp, ctx);
+    return sortByCopy(list, cmp, ctx, 1);
+}
+
+int list_lowerBound(const List *list, ListElemCtxComparer cmp, const void *elem, void *ctx, size_t *index) {
+    if (list->ops->lowerBound)
+        return list->ops->lowerBound(list->impl, cmp, elem, ctx, index);
+    *index = bound(list, cmp, elem, ctx, 0);
+    return 0;
+}
+
+int list_upperBound(const List *list, ListElemCtxComparer cmp, const void *elem, void *ctx, size_t *index) {
+    if (list->ops->upperBound)
+        return list->ops->upperBound(list->impl, cmp, elem, ctx, index);
+    *index = bound(list, cmp, elem, ctx, 1);
+    return 0;
+}
+
+int list_binarySearch(const List *list, ListElemCtxComparer cmp, const void *elem, void *ctx, size_t *index) {
+    list_lowerBound(list, cmp, elem, ctx, index);
+    if (*index >= list_len(list))
+        return 1;
+    void *found = list_at(list, *index);
+    if (found)
+        return cmp(found, elem, ctx) ? 1 : 0;
+    unsigned char buf[list->elemSize];
+    list_get(list, *index, buf);
+    return cmp(buf, elem, ctx) ? 1 : 0;
+}
+
+int list_sortedInsert(List *list, ListElemCtxComparer cmp, const void *elem, void *ctx) {
+    size_t index;
+    list_upperBound(list, cmp, elem, ctx, &index);
+    return list_insert(list, index, elem);
+}
+
+void *list_at(const List *list, size_t index) {
+    if (list->ops->at)
+        return list->ops->at(list->impl, index);
+    return NULL;
+}
+
+int list_span(const List *list, size_t index, size_t count, ListSpan *span) {
+    if (list->ops->span)
+        return list->ops->span(list->impl, index, count, span);
+    return 2;
+}
+
+void list_iterBegin(const List *list, ListIter *iter) {
+    iter->list = list;
+    if (list->ops->iterBegin) {
+        list->ops->iterBegin(list->impl, &iter->cursor);
+        return;
     }
+    iter->cursor.index = iter->cursor.offset = 0;
+    iter->cursor.node = iter->cursor.prev = NULL;
+}
+
+_Bool list_iterEnd(const ListIter *iter) {
+    return iter->cursor.index >= list_len(iter->list);
+}
+
+int list_iterNext(ListIter *iter) {
+    const List *list = iter->list;
+    if (list->ops->iterNext)
+        return list->ops->iterNext(list->impl, &iter->cursor);
+    if (list_iterEnd(iter))
+        return 1;
+    iter->cursor.index++;
+    return 0;
+}
+
+int list_iterGet(const ListIter *iter, void *elem) {
+    const List *list = iter->list;
+    if (!list->ops->iterAt)
+        return list_get(list, iter->cursor.index, elem);
+    void *p = list->ops->iterAt(list->impl, &iter->cursor);
+    if (!p)
+        return 1;
+    memcpy(elem, p, list->elemSize);
+    return 0;
+}
+
+void *list_iterAt(const ListIter *iter) {
+    const List *list = iter->list;
+    if (list->ops->iterAt)
+        return list->ops->iterAt(list->impl, &iter->cursor);
+    return list_at(list, iter->cursor.index);
+}
+
+int list_iterSet(const ListIter *iter, const void *elem) {
+    const List *list = iter->list;
+    if (!list->ops->iterAt)
+        return list_set(list, iter->cursor.index, elem);
+    void *p = list->ops->iterAt(list->impl, &iter->cursor);
+    if (!p)
+        return 1;
+    memcpy(p, elem, list->elemSize);
+    return 0;
+}
+
+int list_iterInsertBefore(ListIter *iter, const void *elem) {
+    List *list = (List *) iter->list;
+    if (list->ops->iterInsertBefore)
+        return list->ops->iterInsertBefore(list->impl, &iter->cursor, elem);
+    int res = list_insert(list, iter->cursor.index, elem);
+    if (!res)
+        iter->cursor.index++;
+    return res;
+}
+
+int list_iterErase(ListIter *iter, void *elem) {
+    List *list = (List *) iter->list;
+    if (list->ops->iterErase)
+        return list->ops->iterErase(list->impl, &iter->cursor, elem);
+    if (elem)
+        return list_getDel(list, iter->cursor.index, elem);
+    return list_del(list, iter->cursor.index);
+}
+
+// 复制到缓冲区排序，再用迭代器按顺序写回，写回对各实现都是O(n)。
+static int sortByCopy(List *list, ListElemCtxComparer cmp, void *ctx, _Bool stable) {
+    size_t length = list_len(list);
+    if (length < 2)
+        return 0;
+    void *elems = malloc(length * list->elemSize);
+    if (elems == NULL)
+        return 2;
+    list_getRange(list, 0, length, elems);
+    if (stable) {
+        if (memorySortStable(elems, length, list->elemSize, cmp, ctx)) {
+            free(elems);
+            return 2;
+        }
+    } else {
+        memorySort(elems, length, list->elemSize, cmp, ctx);
+    }
+    ListIter iter;
+    list_iterBegin(list, &iter);
+    for (size_t i = 0; i < length; i++, list_iterNext(&iter))
+        list_iterSet(&iter, pointerAdd(elems, i * list->elemSize));
+    free(elems);
+    return 0;
+}
+
+// 按下标二分，能取得元素地址时不复制元素。
+static size_t bound(const List *list, ListElemCtxComparer cmp, const void *elem, void *ctx, _Bool upper) {
+    unsigned char buf[list->elemSize];
+    size_t lo = 0, count = list_len(list);
+    while (count) {
+        size_t half = count / 2;
+        void *mid = list_at(list, lo + half);
+        if (mid == NULL) {
+            list_get(list, lo + half, buf);
+            mid = buf;
+        }
+        int res = cmp(mid, elem, ctx);
+        if (res < 0 || (upper && !res)) {
+            lo += half + 1;
+            count -= half + 1;
+        } else {
+            count = half;
+        }
+    }
+    return lo;
+}
+
+// 必需操作都不为NULL，迭代操作因游标含义由实现决定，须全部提供或全部为NULL。
+static _Bool validOps(const ListImplOps *ops) {
+    if (!ops || !ops->alloc || !ops->free || !ops->len || !ops->get || !ops->insert || !ops->del || !ops->locate ||
+        !ops->travel || !ops->locateCtx || !ops->travelCtx || !ops->clear || !ops->rpop || !ops->lpush ||
+        !ops->rpush || !ops->lpop || !ops->set || !ops->getDel || !ops->getSet || !ops->fprint)
+        return 0;
+    _Bool iter = ops->iterBegin != NULL;
+    return iter == (ops->iterNext != NULL) && iter == (ops->iterAt != NULL) &&
+           iter == (ops->iterInsertBefore != NULL) && iter == (ops->iterErase != NULL);
+}
+
+// 按下标可O(1)取元素的实现才分段，返回参与的线程数，为0表示应在调用线程中顺序执行。
+static size_t parallelPrepare(ParallelJob *job, const List *list, size_t threads) {
+    if (!list->ops->at || list->ops->iterBegin)
+        return 0;
+    if (!threads) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = online > 0 ? online : 1;
+    }
+    size_t length = list_len(list);
+    job->list = list;
+    job->length = length;
+    if (list_span(list, 0, length, &job->span) || !length)
+        job->span.base = NULL;
+    // 每个线程平均约十六段，找到元素后其余线程很快就会领到被跳过的段。
+    job->grain = length / threads / 16;
+    if (job->grain < ParallelGrain)
+        job->grain = ParallelGrain;
+    job->chunks = (length + job->grain - 1) / job->grain;
+    atomic_init(&job->limit, length);
+    atomic_init(&job->result, 0);
+    return threads < job->chunks ? threads : job->chunks ? job->chunks : 1;
+}
+
+// 调用线程与共享线程池中至多threads-1个工作线程一起领取分段，返回时所有分段都已完成或被跳过。
+// 线程池不可用或内存不足时在调用线程中顺序执行。
+static void parallelExecute(ParallelJob *job, size_t threads) {
+    ThreadPool *pool = threads < 2 ? NULL : threadPool_shared();
+    if (!pool || threadPool_parallelFor(pool, 0, job->chunks, 1, threads, parallelChunks, job))
+        parallelChunks(0, job->chunks, job);
+}
+
+// 处理[from, to)号段，某段起点已不小于limit时其后的段也都不必处理。
+static void parallelChunks(size_t from, size_t to, void *ctx) {
+    ParallelJob *job = ctx;
+    for (size_t chunk = from; chunk < to; chunk++) {
+        size_t start = chunk * job->grain;
+        if (start >= atomic_load(&job->limit))
+            return;
+        job->run(job, start, start + job->grain < job->length ? start + job->grain : job->length, chunk);
+    }
+}
+
+static void *parallelElem(const ParallelJob *job, size_t index) {
+    if (job->span.base)
+        return (unsigned char *) job->span.base + index * job->span.stride;
+    return list_at(job->list, index);
+}
+
+static void travelChunk(ParallelJob *job, size_t from, size_t to, size_t chunk) {
+    (void) chunk;
+    for (size_t i = from; i < to; i++) {
+        int res = job->visit(parallelElem(job, i), job->ctx);
+        if (res) {
+            int expected = 0;
+            atomic_compare_exchange_strong(&job->result, &expected, res);
+            atomic_store(&job->limit, 0);
+            return;
+        }
+    }
+}
+
+// 每个元素都检查limit，别的线程在更靠前的位置找到后立即停止。
+static void locateChunk(ParallelJob *job, size_t from, size_t to, size_t chunk) {
+    (void) chunk;
+    for (size_t i = from; i < to && i < atomic_load_explicit(&job->limit, memory_order_relaxed); i++) {
+        if (!job->cmp(parallelElem(job, i), job->elem, job->ctx)) {
+            size_t limit = atomic_load(&job->limit);
+            while (i < limit && !atomic_compare_exchange_weak(&job->limit, &limit, i));
+            return;
+        }
+    }
+}
+
+static void reduceChunk(ParallelJob *job, size_t from, size_t to, size_t chunk) {
+    unsigned char *acc = job->partials + chunk * job->resultSize;
+    memcpy(acc, job->elem, job->resultSize);
+    for (size_t i = from; i < to; i++)
+        job->accumulate(acc, parallelElem(job, i), job->ctx);
+}
+
+// 不能分段的实现顺序归约时，经list_travelCtx逐个累加。
+static int reduceVisitor(void *elem, void *ctx) {
+    ParallelJob *job = ctx;
+    job->accumulate(job->partials, elem, job->ctx);
+    return 0;
 }
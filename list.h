@@ -16,21 +16,23 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "node_pool.h"
+
 // 线性表实现类型
 typedef enum {
     ListImplType_Array,        // 数组实现
     ListImplType_Linked,       // 链表实现
     ListImplType_DoubleLinked, // 双向链表实现
     ListImplType_StaticLinked, // 静态链表实现
-    ListImplType_CircleLinked  // 环链表实现
+    ListImplType_CircleLinked, // 环链表实现
+    ListImplType_Deque,        // 环形缓冲区双端队列实现
+    ListImplType_SkipList,     // 跳表实现
+    ListImplType_BTree,        // 计数B+树实现
+    ListImplType_Unrolled,     // 分块链表实现
+    ListImplType_Custom = 32,  // 自定义实现起始值，由list_registerImpl分配
+    ListImplType_Max = 64      // 实现类型上限
 } ListImplType;
 
-// 线性表
-typedef struct {
-    ListImplType type; // 线性表类型
-    void *impl;        // 线性表实现
-} List;
-
 // 线性表比较器。
 // 返回0表示相等。
 // 返回-1表示后者大。
@@ -40,15 +42,145 @@ typedef int ListElemComparer(const void *e1, const void *e2);
 // 线性表元素访问器。
 typedef void ListElemVisitor(void *elem);
 
+// 带上下文的线性表比较器，返回值同ListElemComparer。
+// ctx：调用方传入的上下文。
+typedef int ListElemCtxComparer(const void *e1, const void *e2, void *ctx);
+
+// 带上下文的线性表元素访问器。
+// ctx：调用方传入的上下文。
+// 返回非0时停止遍历。
+typedef int ListElemCtxVisitor(void *elem, void *ctx);
+
 // 将元素转化成字符串形式表示到s并返回长度。
 typedef size_t ListElemToString(void *elem, char *s);
 
+// 并行归约中把元素累加到部分结果acc。
+// ctx：调用方传入的上下文。
+typedef void ListElemAccumulator(void *acc, const void *elem, void *ctx);
+
+// 并行归约中把部分结果src合并到dst，须满足结合律。
+// ctx：调用方传入的上下文。
+typedef void ListAccCombiner(void *dst, const void *src, void *ctx);
+
+// 顺序存储的容量策略。
+typedef struct {
+    size_t initCapacity; // 首次分配的容量，0表示按需增长
+    double growFactor;   // 容量超过扩容阈值后每次扩容的系数，须大于1
+    double shrinkFactor; // 元素个数乘以该系数不超过容量时缩容，缩容后保留一半空闲区间以防反复扩缩
+    _Bool neverShrink;   // 为真时删除元素不缩容
+} ListGrowthPolicy;
+
+// 静态链表索引宽度。
+typedef enum {
+    ListIndexWidth_Default, // 默认宽度，即32位
+    ListIndexWidth_16,      // 16位，容量不超过65536
+    ListIndexWidth_32,      // 32位，容量不超过2^32
+    ListIndexWidth_64,      // 64位
+} ListIndexWidth;
+
+// 线性表创建选项。
+typedef struct {
+    const ListGrowthPolicy *growth; // 顺序存储的容量策略，NULL表示默认策略
+    _Bool usePool;                  // 链式存储从节点池分配节点
+    NodePool *pool;                 // usePool为真时使用的节点池，NULL表示线性表独占一个节点池
+    ListIndexWidth indexWidth;      // 静态链表的索引宽度
+    size_t blockSize;               // 分块链表每块的元素个数，0表示默认
+} ListOptions;
+
+// 连续存储的元素视图。
+typedef struct {
+    void *base;    // 首个元素地址
+    size_t length; // 元素个数
+    size_t stride; // 相邻元素地址间隔的字节数
+} ListSpan;
+
+// 迭代位置，由各实现维护。
+typedef struct {
+    size_t index;  // 当前元素下标，等于元素个数时迭代结束
+    void *node;    // 链式实现中当前元素所在节点
+    void *prev;    // 链式实现中当前元素的前驱节点
+    size_t offset; // 分块实现中当前元素在块内的位置
+} ListCursor;
+
+// 线性表迭代器，迭代期间经其它途径修改线性表将使其失效。
+typedef struct {
+    const struct List *list; // 所迭代的线性表
+    ListCursor cursor;       // 迭代位置
+} ListIter;
+
+// 线性表实现操作表。
+// 每种实现提供一份，impl参数为实现对象，其余参数与返回值同list_*函数。
+typedef struct {
+    void *(*alloc)(size_t elemSize, const ListOptions *opts);
+    void (*free)(void *impl);
+    size_t (*len)(const void *impl);
+    int (*get)(const void *impl, size_t index, void *elem);
+    int (*insert)(void *impl, size_t index, const void *elem);
+    int (*del)(void *impl, size_t index);
+    int (*locate)(const void *impl, ListElemComparer cmp, const void *elem, size_t *index);
+    int (*travel)(const void *impl, ListElemVisitor visit);
+    int (*locateCtx)(const void *impl, ListElemCtxComparer cmp, const void *elem, void *ctx, size_t *index);
+    int (*travelCtx)(const void *impl, ListElemCtxVisitor visit, void *ctx);
+    int (*clear)(void *impl);
+    int (*rpop)(void *impl, void *elem);
+    int (*lpush)(void *impl, const void *elem);
+    int (*rpush)(void *impl, const void *elem);
+    int (*lpop)(void *impl, void *elem);
+    int (*set)(void *impl, size_t index, const void *elem);
+    int (*getDel)(void *impl, size_t index, void *elem);
+    int (*getSet)(void *impl, size_t index, void *elem);
+    int (*fprint)(const void *impl, FILE *f, ListElemToString str, size_t sizeOfElem);
+
+    // 以下为可选操作，为NULL时由list.c逐个元素完成。
+    int (*insertRange)(void *impl, size_t index, const void *elems, size_t count);
+    int (*delRange)(void *impl, size_t index, size_t count);
+    int (*getRange)(const void *impl, size_t index, size_t count, void *elems);
+    int (*reserve)(void *impl, size_t capacity);
+    int (*shrinkToFit)(void *impl);
+    void *(*at)(const void *impl, size_t index);
+    int (*span)(const void *impl, size_t index, size_t count, ListSpan *span);
+    int (*travelRange)(const void *impl, size_t index, size_t count, ListElemCtxVisitor visit, void *ctx);
+    int (*sort)(void *impl, ListElemCtxComparer cmp, void *ctx);
+    int (*sortStable)(void *impl, ListElemCtxComparer cmp, void *ctx);
+    int (*lowerBound)(const void *impl, ListElemCtxComparer cmp, const void *elem, void *ctx, size_t *index);
+    int (*upperBound)(const void *impl, ListElemCtxComparer cmp, const void *elem, void *ctx, size_t *index);
+    int (*locateBytes)(const void *impl, size_t offset, const void *key, size_t keySize, size_t *index);
+
+    // 迭代操作，须全部提供或全部为NULL，为NULL时按下标访问元素。
+    void (*iterBegin)(const void *impl, ListCursor *cursor);
+    int (*iterNext)(const void *impl, ListCursor *cursor);
+    void *(*iterAt)(const void *impl, const ListCursor *cursor);
+    int (*iterInsertBefore)(void *impl, ListCursor *cursor, const void *elem);
+    int (*iterErase)(void *impl, ListCursor *cursor, void *elem);
+} ListImplOps;
+
+// 线性表
+typedef struct List {
+    ListImplType type;      // 线性表类型
+    const ListImplOps *ops; // 线性表实现操作表
+    void *impl;             // 线性表实现
+    size_t elemSize;        // 每个元素占用的字节数
+} List;
+
+// 注册自定义线性表实现，可在多个线程中同时调用。
+// ops：实现操作表，须在线性表使用期间保持有效；可选操作以外的操作不能为NULL，迭代操作须全部提供或全部为NULL。
+// type：分配的实现类型值将被设置，之后可用于list_alloc。
+// 返回1: 可注册数量已满。
+// 返回3: 操作表为NULL或不完整。
+int list_registerImpl(const ListImplOps *ops, ListImplType *type);
+
 // 初始化线性表。
 // list：指针地址将被设置为初始化的线性表。
 // elemSize：线性表中每个元素占用的空间字节数。
 // impl：使用哪种实现。
 List *list_alloc(size_t elemSize, ListImplType type);
 
+// 按选项初始化线性表。
+// elemSize：线性表中每个元素占用的空间字节数。
+// impl：使用哪种实现。
+// opts：创建选项，NULL表示默认选项。
+List *list_allocWithOptions(size_t elemSize, ListImplType type, const ListOptions *opts);
+
 // 销毁线性表。
 // list：线性表对象。
 void list_free(List *list);
@@ -70,6 +202,7 @@ int list_get(const List *list, size_t index, void *elem);
 // index：元素在线性表的下表值。
 // elem：插入的元素。
 // 返回1: 越界。
+// 返回2: 内存不足。
 int list_insert(List *list, size_t index, const void *elem);
 
 // 删除线性表某个位置上的元素。
@@ -91,6 +224,82 @@ int list_locate(const List *list, ListElemComparer cmp, const void *elem, size_t
 // visit：遍历函数。
 int list_travel(const List *list, ListElemVisitor visit);
 
+// 带上下文找到元素在线性表上的位置，可在多个线程中同时查找不同线性表。
+// list：线性表对象。
+// cmp：比较函数。
+// elem：要定位的元素。
+// ctx：传给比较函数的上下文。
+// index：元素下表将被设置。
+// 返回1: 未找到。
+int list_locateCtx(const List *list, ListElemCtxComparer cmp, const void *elem, void *ctx, size_t *index);
+
+// 按字节找到元素在线性表上的位置，比较每个元素offset处的keySize个字节，不调用比较函数。
+// 顺序表、双端队列、B+树线性表和分块链表在连续存放的元素上批量比较，4、8、16字节的元素整体作为键时使用SIMD指令。
+// 浮点数按位比较，+0.0与-0.0不等，位模式相同的NaN相等。
+// list：线性表对象。
+// offset：键在元素中的字节偏移。
+// key：要寻找的键。
+// keySize：键的字节大小。
+// index：元素下表将被设置。
+// 返回1: 未找到，或键超出了元素范围。
+int list_locateBytes(const List *list, size_t offset, const void *key, size_t keySize, size_t *index);
+
+// 带上下文遍历线性表元素，访问器返回非0时停止遍历。
+// list：线性表对象。
+// visit：遍历函数。
+// ctx：传给遍历函数的上下文。
+// 返回visit的非0返回值: 遍历提前结束。
+int list_travelCtx(const List *list, ListElemCtxVisitor visit, void *ctx);
+
+// 带上下文遍历线性表上连续多个元素，访问器返回非0时停止遍历。
+// list：线性表对象。
+// index：第一个元素的位置。
+// count：元素个数。
+// visit：遍历函数。
+// ctx：传给遍历函数的上下文。
+// 时间复杂度：树形实现O(log(n)+count)，其余实现与迭代器前进到index相同。
+// 返回1: 越界。
+// 返回visit的非0返回值: 遍历提前结束。
+int list_travelRange(const List *list, size_t index, size_t count, ListElemCtxVisitor visit, void *ctx);
+
+// 以下为多线程操作，在threadPool_shared返回的线程池上执行，其工作线程数固定为在线处理器个数。
+// 顺序表、静态链表和双端队列按下标分段，由调用线程和线程池中的线程依次领取；其它实现或元素较少时在调用线程中顺序执行。
+// 回调函数会在多个线程中同时被调用，每个元素只交给一个线程；执行期间不能修改线性表。
+// 多个线程可同时发起多线程操作，各操作的分段在同一线程池中交错执行，不会排队串行。
+// 参数threads超过线程池工作线程数加1时按该值执行，不报错。
+
+// 多线程遍历线性表元素，访问器返回非0时其余线程不再领取新的分段。
+// list：线性表对象。
+// visit：遍历函数。
+// ctx：传给遍历函数的上下文。
+// threads：线程数，含调用线程，0表示在线处理器个数。
+// 返回visit的某个非0返回值: 遍历提前结束。
+int list_parallelTravel(const List *list, ListElemCtxVisitor visit, void *ctx, size_t threads);
+
+// 多线程查找元素，结果与list_locateCtx相同，为第一个相等元素的位置。
+// 分段按下标递增领取，找到后跳过更靠后的分段，正在比较更靠后分段的线程也随即停止。
+// list：线性表对象。
+// cmp：比较函数。
+// elem：要定位的元素。
+// ctx：传给比较函数的上下文。
+// index：元素下标将被设置。
+// threads：线程数，含调用线程，0表示在线处理器个数。
+// 返回1: 未找到。
+int list_parallelLocate(const List *list, ListElemCtxComparer cmp, const void *elem, void *ctx, size_t *index,
+                        size_t threads);
+
+// 多线程归约，每个分段从result的初值开始累加，再按分段顺序合并到result，合并顺序与线程数无关。
+// list：线性表对象。
+// accumulate：累加函数。
+// combine：合并函数。
+// result：传入初值，须为合并的单位元，例如求和时为0；返回时为归约结果。
+// resultSize：结果占用的字节大小。
+// ctx：传给累加和合并函数的上下文。
+// threads：线程数，含调用线程，0表示在线处理器个数。
+// 返回2: 内存不足。
+int list_parallelReduce(const List *list, ListElemAccumulator accumulate, ListAccCombiner combine, void *result,
+                        size_t resultSize, void *ctx, size_t threads);
+
 // 重置线性表。
 // list：操作对象。
 int list_clear(List *list);
@@ -104,11 +313,13 @@ int list_rpop(List *list, void *elem);
 // 向线性表首部插入元素。
 // list：线性表对象。
 // elem：被插入的元素。
+// 返回2: 内存不足。
 int list_lpush(List *list, const void *elem);
 
 // 在线性表尾部插入元素。
 // list：线性表对象。
 // elem：被插入的元素。
+// 返回2: 内存不足。
 int list_rpush(List *list, const void *elem);
 
 // 弹出线性表首部元素。
@@ -146,4 +357,154 @@ int list_getSet(const List *list, size_t index, void *elem);
 // sizeOfElem：元素字符串至少占用的字节数。
 int list_fprint(const List *list, FILE *f, ListElemToString str, size_t sizeOfElem);
 
+// 把连续多个元素添加到线性表上的某个位置。
+// list：线性表对象。
+// index：第一个元素插入的位置。
+// elems：被插入的元素数组。
+// count：元素个数。
+// 返回1: 越界。
+// 返回2: 内存不足，已插入的元素会被删除，线性表保持不变。
+int list_insertRange(List *list, size_t index, const void *elems, size_t count);
+
+// 删除线性表上连续多个元素。
+// list：线性表对象。
+// index：第一个元素的位置。
+// count：元素个数。
+// 返回1: 越界。
+int list_delRange(List *list, size_t index, size_t count);
+
+// 在线性表尾部插入多个元素。
+// list：线性表对象。
+// elems：被插入的元素数组。
+// count：元素个数。
+int list_rpushN(List *list, const void *elems, size_t count);
+
+// 获取线性表上连续多个元素。
+// list：线性表对象。
+// index：第一个元素的位置。
+// count：元素个数。
+// elems：将被设置为元素值。
+// 返回1: 越界。
+int list_getRange(const List *list, size_t index, size_t count, void *elems);
+
+// 预留线性表容量，只对顺序存储的实现有效。
+// list：线性表对象。
+// capacity：至少能容纳的元素个数。
+// 返回2: 内存不足。
+int list_reserve(List *list, size_t capacity);
+
+// 释放线性表多余容量，只对顺序存储的实现有效。
+// list：线性表对象。
+// 返回2: 内存不足。
+int list_shrinkToFit(List *list);
+
+// 按比较函数升序排列线性表，不保证相等元素的相对顺序。
+// 顺序表用内省排序，静态链表只重排索引，链表重新链接节点，其余实现复制到缓冲区排好后写回。
+// list：线性表对象。
+// cmp：元素比较函数。
+// ctx：传给比较函数的上下文。
+// 返回2: 内存不足。
+int list_sort(List *list, ListElemCtxComparer cmp, void *ctx);
+
+// 按比较函数升序排列线性表，相等元素保持原有顺序。
+// list：线性表对象。
+// cmp：元素比较函数。
+// ctx：传给比较函数的上下文。
+// 返回2: 内存不足。
+int list_sortStable(List *list, ListElemCtxComparer cmp, void *ctx);
+
+// 以下为有序线性表操作，线性表须已按cmp升序排列，例如由list_sort排好或只经list_sortedInsert插入。
+// 顺序表比较O(log(n))次且不复制元素，其余实现经list_at或list_get按下标二分。
+
+// 二分查找第一个不小于elem的元素。
+// list：线性表对象。
+// cmp：元素比较函数。
+// elem：要比较的元素。
+// ctx：传给比较函数的上下文。
+// index：将被设置为该元素的位置，都小于elem时为元素个数。
+int list_lowerBound(const List *list, ListElemCtxComparer cmp, const void *elem, void *ctx, size_t *index);
+
+// 二分查找第一个大于elem的元素。
+// list：线性表对象。
+// cmp：元素比较函数。
+// elem：要比较的元素。
+// ctx：传给比较函数的上下文。
+// index：将被设置为该元素的位置，都不大于elem时为元素个数。
+int list_upperBound(const List *list, ListElemCtxComparer cmp, const void *elem, void *ctx, size_t *index);
+
+// 二分查找与elem相等的元素。
+// list：线性表对象。
+// cmp：元素比较函数。
+// elem：要寻找的元素。
+// ctx：传给比较函数的上下文。
+// index：将被设置为第一个相等元素的位置；未找到时为保持有序的插入位置。
+// 返回1: 未找到。
+int list_binarySearch(const List *list, ListElemCtxComparer cmp, const void *elem, void *ctx, size_t *index);
+
+// 插入元素并保持有序，插在相等元素之后；顺序表只移动一次内存。
+// list：线性表对象。
+// cmp：元素比较函数。
+// elem：被插入的元素。
+// ctx：传给比较函数的上下文。
+// 返回2: 内存不足。
+int list_sortedInsert(List *list, ListElemCtxComparer cmp, const void *elem, void *ctx);
+
+// 获取线性表上元素的存储地址，可原地读写元素，插入或删除元素后地址失效。
+// list：线性表对象。
+// index：元素下标。
+// 返回NULL: 越界或实现不支持。
+void *list_at(const List *list, size_t index);
+
+// 获取线性表上连续多个元素的视图，只对连续存储的实现有效，插入或删除元素后视图失效。
+// list：线性表对象。
+// index：第一个元素的位置。
+// count：元素个数。
+// span：将被设置为元素视图。
+// 返回1: 越界。
+// 返回2: 实现不是连续存储，或元素跨越了分块实现的块边界。
+int list_span(const List *list, size_t index, size_t count, ListSpan *span);
+
+// 迭代器置于线性表首个元素，链式实现逐个前进为O(1)。
+// list：线性表对象。
+// iter：将被设置为迭代器。
+void list_iterBegin(const List *list, ListIter *iter);
+
+// 迭代是否已结束。
+// iter：迭代器。
+_Bool list_iterEnd(const ListIter *iter);
+
+// 迭代器前进到下一个元素。
+// iter：迭代器。
+// 返回1: 迭代已结束。
+int list_iterNext(ListIter *iter);
+
+// 获取迭代器当前元素。
+// iter：迭代器。
+// elem：将被设置为元素值。
+// 返回1: 迭代已结束。
+int list_iterGet(const ListIter *iter, void *elem);
+
+// 获取迭代器当前元素的存储地址，可原地读写元素。
+// iter：迭代器。
+// 返回NULL: 迭代已结束或实现不支持。
+void *list_iterAt(const ListIter *iter);
+
+// 设置迭代器当前元素。
+// iter：迭代器。
+// elem：元素。
+// 返回1: 迭代已结束。
+int list_iterSet(const ListIter *iter, const void *elem);
+
+// 在迭代器当前元素前插入元素，迭代器仍指向原元素；迭代已结束时追加到尾部。
+// iter：迭代器。
+// elem：被插入的元素。
+// 返回2: 内存不足。
+int list_iterInsertBefore(ListIter *iter, const void *elem);
+
+// 删除迭代器当前元素，迭代器指向下一个元素。
+// iter：迭代器。
+// elem：非NULL时将被设置为删除的元素值。
+// 返回1: 迭代已结束。
+int list_iterErase(ListIter *iter, void *elem);
+
 #endif // CLIB_LIST_H
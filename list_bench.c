@@ -0,0 +1,1004 @@
+/*
+ * Copyright (c) 2023 ivfzhou
+ * clib is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+
+// 线性表性能测试
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <time.h>
+
+#include "list.c"
+
+CLIB_ARRAY_LIST_DEFINE(BenchIntList, int);
+
+#define BENCH_LENGTH 1000
+
+#define BENCH_ROUNDS 100000
+
+static double now(void);
+
+static int switchGet(const List *list, size_t index, void *elem);
+
+static void benchVisitor(void *elem);
+
+static int benchRangeVisitor(void *elem, void *ctx);
+
+static int benchCmp(const void *e1, const void *e2);
+
+static int benchWideCmp(const void *e1, const void *e2);
+
+static int benchPairCmp(const void *e1, const void *e2);
+
+static int benchKeyCmp(const void *e1, const void *e2, void *ctx);
+
+static int benchQsortCmp(const void *e1, const void *e2);
+
+static void benchGet(void);
+
+static void benchRpushN(void);
+
+static void benchGrowth(void);
+
+static void benchAt(void);
+
+static void benchDeque(void);
+
+static void benchLinked(void);
+
+static void benchPool(void);
+
+static void benchIter(void);
+
+static void benchStaticDelete(void);
+
+static void benchIndexWidth(void);
+
+static void benchAppend(void);
+
+static void benchSplice(void);
+
+static void benchFinger(void);
+
+static void benchSkipList(void);
+
+static void benchBTree(void);
+
+static void benchUnrolled(void);
+
+static void benchSort(void);
+
+static void benchParallelSort(void);
+
+static void benchSortedInsert(void);
+
+static void benchLocateKey(void);
+
+static void benchTyped(void);
+
+static void benchParallel(void);
+
+static int benchIncVisitor(void *elem, void *ctx);
+
+static int benchEqualCmp(const void *e1, const void *e2, void *ctx);
+
+static void benchSumAccumulate(void *acc, const void *elem, void *ctx);
+
+static void benchSumCombine(void *dst, const void *src, void *ctx);
+
+int main(void) {
+    benchGet();
+    benchRpushN();
+    benchGrowth();
+    benchAt();
+    benchDeque();
+    benchLinked();
+    benchPool();
+    benchIter();
+    benchStaticDelete();
+    benchIndexWidth();
+    benchAppend();
+    benchSplice();
+    benchFinger();
+    benchSkipList();
+    benchBTree();
+    benchUnrolled();
+    benchSort();
+    benchParallelSort();
+    benchSortedInsert();
+    benchLocateKey();
+    benchTyped();
+    benchParallel();
+}
+
+// list_get热循环中分发开销：直接调用、switch分发、操作表分发。
+static void benchGet(void) {
+    List *list = list_alloc(sizeof(int), ListImplType_Array);
+    for (int i = 0; i < BENCH_LENGTH; i++)
+        list_rpush(list, &i);
+
+    volatile long long sum = 0;
+    int elem;
+
+    double begin = now();
+    for (int r = 0; r < BENCH_ROUNDS; r++)
+        for (size_t i = 0; i < BENCH_LENGTH; i++) {
+            arrayList_get(list->impl, i, &elem);
+            sum += elem;
+        }
+    double direct = now() - begin;
+
+    begin = now();
+    for (int r = 0; r < BENCH_ROUNDS; r++)
+        for (size_t i = 0; i < BENCH_LENGTH; i++) {
+            switchGet(list, i, &elem);
+            sum += elem;
+        }
+    double switched = now() - begin;
+
+    begin = now();
+    for (int r = 0; r < BENCH_ROUNDS; r++)
+        for (size_t i = 0; i < BENCH_LENGTH; i++) {
+            list_get(list, i, &elem);
+            sum += elem;
+        }
+    double ops = now() - begin;
+
+    double calls = (double) BENCH_ROUNDS * BENCH_LENGTH;
+    printf("list_get direct %.2fns/op, switch %.2fns/op, ops %.2fns/op\n",
+           direct * 1e9 / calls, switched * 1e9 / calls, ops * 1e9 / calls);
+
+    list_free(list);
+}
+
+// 逐个追加与批量追加一百万个元素。
+static void benchRpushN(void) {
+    const size_t total = 1000000, batch = 1000;
+    int *elems = malloc(sizeof(int) * batch);
+    for (size_t i = 0; i < batch; i++)
+        elems[i] = (int) i;
+
+    List *list = list_alloc(sizeof(int), ListImplType_Array);
+    double begin = now();
+    for (size_t i = 0; i < total; i++)
+        list_rpush(list, &elems[i % batch]);
+    double single = now() - begin;
+    list_free(list);
+
+    list = list_alloc(sizeof(int), ListImplType_Array);
+    begin = now();
+    for (size_t i = 0; i < total; i += batch)
+        list_rpushN(list, elems, batch);
+    double batched = now() - begin;
+    list_free(list);
+
+    printf("append %zu elems: rpush %.2fms, rpushN(%zu) %.2fms\n", total, single * 1e3, batch, batched * 1e3);
+    free(elems);
+}
+
+// 预留容量与按需扩容，以及元素个数在缩容点附近波动。
+static void benchGrowth(void) {
+    const size_t total = 1000000;
+    int elem = 0;
+
+    List *list = list_alloc(sizeof(int), ListImplType_Array);
+    double begin = now();
+    for (size_t i = 0; i < total; i++)
+        list_rpush(list, &elem);
+    double grown = now() - begin;
+    list_free(list);
+
+    list = list_alloc(sizeof(int), ListImplType_Array);
+    begin = now();
+    list_reserve(list, total);
+    for (size_t i = 0; i < total; i++)
+        list_rpush(list, &elem);
+    double reserved = now() - begin;
+
+    begin = now();
+    for (int r = 0; r < 1000; r++) {
+        for (size_t i = 0; i < total / 100; i++)
+            list_rpop(list, &elem);
+        for (size_t i = 0; i < total / 100; i++)
+            list_rpush(list, &elem);
+    }
+    double oscillate = now() - begin;
+    list_free(list);
+
+    printf("rpush %zu elems: grow %.2fms, reserve %.2fms; oscillate 1%% x1000 %.2fms\n",
+           total, grown * 1e3, reserved * 1e3, oscillate * 1e3);
+}
+
+// 256字节元素的读取：list_get复制、list_at原地访问、list_span遍历。
+static void benchAt(void) {
+    typedef struct {
+        long long key;
+        char payload[248];
+    } Record;
+    const size_t length = 100000;
+    const int rounds = 50;
+    Record record = {0};
+
+    List *list = list_alloc(sizeof(Record), ListImplType_Array);
+    list_reserve(list, length);
+    for (size_t i = 0; i < length; i++) {
+        record.key = (long long) i;
+        list_rpush(list, &record);
+    }
+
+    volatile long long sum = 0;
+    double begin = now();
+    for (int r = 0; r < rounds; r++)
+        for (size_t i = 0; i < length; i++) {
+            list_get(list, i, &record);
+            sum += record.key;
+        }
+    double copied = now() - begin;
+
+    begin = now();
+    for (int r = 0; r < rounds; r++)
+        for (size_t i = 0; i < length; i++)
+            sum += ((Record *) list_at(list, i))->key;
+    double pointed = now() - begin;
+
+    begin = now();
+    for (int r = 0; r < rounds; r++) {
+        ListSpan span;
+        list_span(list, 0, length, &span);
+        for (size_t i = 0; i < span.length; i++)
+            sum += ((Record *) ((char *) span.base + i * span.stride))->key;
+    }
+    double spanned = now() - begin;
+
+    double calls = (double) rounds * length;
+    printf("read 256B elems: get %.2fns/op, at %.2fns/op, span %.2fns/op\n",
+           copied * 1e9 / calls, pointed * 1e9 / calls, spanned * 1e9 / calls);
+    list_free(list);
+}
+
+// 双端混合操作：保持约length个元素，随机在两端压入弹出。
+static void benchDeque(void) {
+    const ListImplType types[] = {ListImplType_Array, ListImplType_DoubleLinked, ListImplType_Deque};
+    const char *names[] = {"array", "doubleLinked", "deque"};
+    const size_t length = 100000, ops = 1000000;
+
+    for (int t = 0; t < 3; t++) {
+        List *list = list_alloc(sizeof(int), types[t]);
+        int elem = 0;
+        for (size_t i = 0; i < length; i++)
+            list_rpush(list, &elem);
+        srand(1);
+        double begin = now();
+        for (size_t i = 0; i < ops; i++) {
+            switch (rand() % 4) {
+                case 0:
+                    list_lpush(list, &elem);
+                    list_rpop(list, &elem);
+                    break;
+                case 1:
+                    list_rpush(list, &elem);
+                    list_lpop(list, &elem);
+                    break;
+                case 2:
+                    list_lpush(list, &elem);
+                    list_lpop(list, &elem);
+                    break;
+                default:
+                    list_rpush(list, &elem);
+                    list_rpop(list, &elem);
+            }
+        }
+        double cost = now() - begin;
+        printf("deque mix %zu elems %s: %.2fns/op\n", length, names[t], cost * 1e9 / (double) ops / 2);
+        list_free(list);
+    }
+}
+
+// 链式实现上list_test.c式的随机插入删除、遍历，以及头尾压入弹出。
+static void benchLinked(void) {
+    const ListImplType types[] = {ListImplType_Linked, ListImplType_DoubleLinked, ListImplType_CircleLinked};
+    const char *names[] = {"linked", "doubleLinked", "circleLinked"};
+    const size_t length = 20000, pushes = 1000000;
+
+    for (int t = 0; t < 3; t++) {
+        List *list = list_alloc(sizeof(int), types[t]);
+        srand(1);
+        double begin = now();
+        for (size_t i = 0; i < length; i++) {
+            int elem = (int) i;
+            list_insert(list, rand() % (list_len(list) + 1), &elem);
+        }
+        for (size_t i = 0; i < length; i++)
+            list_del(list, rand() % list_len(list));
+        double random = now() - begin;
+
+        int elem = 0;
+        begin = now();
+        for (size_t i = 0; i < pushes; i++)
+            list_lpush(list, &elem);
+        for (size_t i = 0; i < pushes; i++)
+            list_lpop(list, &elem);
+        double pushPop = now() - begin;
+
+        for (size_t i = 0; i < length; i++)
+            list_lpush(list, &elem);
+        begin = now();
+        for (int r = 0; r < 100; r++)
+            list_travel(list, benchVisitor);
+        double travel = now() - begin;
+
+        printf("%s: random insert/del %zu %.2fms, lpush/lpop %zu %.2fms, travel %zu x100 %.2fms\n",
+               names[t], length, random * 1e3, pushes, pushPop * 1e3, length, travel * 1e3);
+        list_free(list);
+    }
+}
+
+// 双向链表节点由malloc分配与由节点池分配：压入弹出、随机插入删除、遍历。
+static void benchPool(void) {
+    const char *names[] = {"malloc", "pool"};
+    const size_t length = 20000, pushes = 1000000;
+
+    for (int t = 0; t < 2; t++) {
+        List *list = list_allocWithOptions(sizeof(int), ListImplType_DoubleLinked, &(ListOptions) {.usePool = t});
+        int elem = 0;
+        double begin = now();
+        for (int r = 0; r < 10; r++) {
+            for (size_t i = 0; i < pushes / 10; i++)
+                list_rpush(list, &elem);
+            for (size_t i = 0; i < pushes / 10; i++)
+                list_lpop(list, &elem);
+        }
+        double pushPop = now() - begin;
+
+        srand(1);
+        begin = now();
+        for (size_t i = 0; i < length; i++)
+            list_insert(list, rand() % (list_len(list) + 1), &elem);
+        for (size_t i = 0; i < length / 2; i++)
+            list_del(list, rand() % list_len(list));
+        double random = now() - begin;
+
+        begin = now();
+        for (int r = 0; r < 100; r++)
+            list_travel(list, benchVisitor);
+        double travel = now() - begin;
+
+        begin = now();
+        list_clear(list);
+        double clear = now() - begin;
+
+        printf("doubleLinked %s: rpush/lpop %zu %.2fms, random insert/del %zu %.2fms, travel %zu x100 %.2fms, clear %.3fms\n",
+               names[t], pushes, pushPop * 1e3, length, random * 1e3, length / 2, travel * 1e3, clear * 1e3);
+        list_free(list);
+    }
+}
+
+// 顺序扫描：按下标list_get与迭代器；按条件删除：list_del与list_iterErase。
+static void benchIter(void) {
+    const ListImplType types[] = {ListImplType_Array, ListImplType_Linked, ListImplType_DoubleLinked, ListImplType_CircleLinked};
+    const char *names[] = {"array", "linked", "doubleLinked", "circleLinked"};
+    const size_t length = 20000;
+
+    for (int t = 0; t < 4; t++) {
+        List *list = list_alloc(sizeof(int), types[t]);
+        for (int i = 0; i < (int) length; i++)
+            list_rpush(list, &i);
+
+        volatile long long sum = 0;
+        int elem;
+        double begin = now();
+        for (size_t i = 0; i < length; i++) {
+            list_get(list, i, &elem);
+            sum += elem;
+        }
+        double indexed = now() - begin;
+
+        ListIter iter;
+        begin = now();
+        for (list_iterBegin(list, &iter); !list_iterGet(&iter, &elem); list_iterNext(&iter))
+            sum += elem;
+        double iterated = now() - begin;
+
+        begin = now();
+        for (size_t i = 0; i < list_len(list);) {
+            list_get(list, i, &elem);
+            if (elem % 2)
+                list_del(list, i);
+            else
+                i++;
+        }
+        double deleted = now() - begin;
+
+        for (int i = 0; i < (int) length / 2; i++)
+            list_rpush(list, &i);
+        begin = now();
+        for (list_iterBegin(list, &iter); !list_iterGet(&iter, &elem);) {
+            if (elem % 2)
+                list_iterErase(&iter, NULL);
+            else
+                list_iterNext(&iter);
+        }
+        double erased = now() - begin;
+
+        printf("%s scan %zu: get %.2fms, iter %.2fms; filter: del %.2fms, iterErase %.2fms\n",
+               names[t], length, indexed * 1e3, iterated * 1e3, deleted * 1e3, erased * 1e3);
+        list_free(list);
+    }
+}
+
+// 静态链表删除为主的负载：随机位置删空、首部弹出删空、保持长度的随机插入删除。
+static void benchStaticDelete(void) {
+    const size_t elemSizes[] = {4, 64};
+    const size_t length = 100000;
+
+    for (int s = 0; s < 2; s++) {
+        size_t elemSize = elemSizes[s];
+        void *elem = calloc(1, elemSize);
+        List *list = list_alloc(elemSize, ListImplType_StaticLinked);
+
+        for (size_t i = 0; i < length; i++)
+            list_rpush(list, elem);
+        srand(1);
+        double begin = now();
+        for (size_t i = 0; i < length; i++)
+            list_del(list, rand() % list_len(list));
+        double random = now() - begin;
+
+        for (size_t i = 0; i < length; i++)
+            list_rpush(list, elem);
+        begin = now();
+        for (size_t i = 0; i < length; i++)
+            list_lpop(list, elem);
+        double front = now() - begin;
+
+        for (size_t i = 0; i < length; i++)
+            list_rpush(list, elem);
+        begin = now();
+        for (size_t i = 0; i < length; i++) {
+            list_del(list, rand() % list_len(list));
+            list_insert(list, rand() % (list_len(list) + 1), elem);
+        }
+        double mix = now() - begin;
+
+        printf("staticLinked %zuB x %zu: random del %.2fms, lpop %.2fms, del/insert mix %.2fms\n",
+               elemSize, length, random * 1e3, front * 1e3, mix * 1e3);
+        list_free(list);
+        free(elem);
+    }
+}
+
+// 静态链表删除与插入主要是移动索引，索引越窄移动的字节越少。
+static void benchIndexWidth(void) {
+    const ListIndexWidth widths[] = {ListIndexWidth_16, ListIndexWidth_32, ListIndexWidth_64};
+    const char *names[] = {"16", "32", "64"};
+    const size_t length = 60000;
+    int elem = 0;
+
+    for (int w = 0; w < 3; w++) {
+        List *list = list_allocWithOptions(sizeof(int), ListImplType_StaticLinked,
+                                           &(ListOptions) {.indexWidth = widths[w]});
+        for (size_t i = 0; i < length; i++)
+            list_rpush(list, &elem);
+        srand(1);
+        double begin = now();
+        for (size_t i = 0; i < length; i++) {
+            list_del(list, rand() % list_len(list));
+            list_insert(list, rand() % (list_len(list) + 1), &elem);
+        }
+        double mix = now() - begin;
+        begin = now();
+        for (size_t i = 0; i < length; i++)
+            list_lpop(list, &elem);
+        double front = now() - begin;
+
+        printf("staticLinked %s-bit index x %zu: del/insert mix %.2fms, lpop %.2fms\n",
+               names[w], length, mix * 1e3, front * 1e3);
+        list_free(list);
+    }
+}
+
+// 逐个追加构建单链表，再将两个单链表首尾相接。
+static void benchAppend(void) {
+    const size_t length = 100000;
+    LinkedList *list = linkedList_alloc(sizeof(int));
+    LinkedList *other = linkedList_alloc(sizeof(int));
+
+    double begin = now();
+    for (int i = 0; i < length; i++)
+        linkedList_rpush(list, &i);
+    double append = now() - begin;
+    for (int i = 0; i < length; i++)
+        linkedList_rpush(other, &i);
+    begin = now();
+    linkedList_concat(list, other);
+    double concat = now() - begin;
+
+    printf("linked rpush x %zu %.2fms, concat %zu + %zu %.3fms\n", length, append * 1e3, length, length,
+           concat * 1e3);
+    linkedList_free(list);
+    linkedList_free(other);
+}
+
+// 在两个双向链表间反复搬移1000个元素：逐个取出插入与整段移动节点。
+static void benchSplice(void) {
+    const size_t length = 20000, count = 1000, rounds = 10;
+    DoubleLinkedList *lists[2] = {doubleLinkedList_alloc(sizeof(int)), doubleLinkedList_alloc(sizeof(int))};
+    for (int i = 0; i < length; i++) {
+        doubleLinkedList_rpush(lists[0], &i);
+        doubleLinkedList_rpush(lists[1], &i);
+    }
+
+    int elem;
+    double begin = now();
+    for (size_t r = 0; r < rounds; r++) {
+        DoubleLinkedList *src = lists[r % 2], *dst = lists[!(r % 2)];
+        for (size_t i = 0; i < count; i++) {
+            doubleLinkedList_getDel(src, length / 4, &elem);
+            doubleLinkedList_insert(dst, length / 4 + i, &elem);
+        }
+    }
+    double moved = now() - begin;
+    begin = now();
+    for (size_t r = 0; r < rounds; r++)
+        doubleLinkedList_splice(lists[!(r % 2)], length / 4, lists[r % 2], length / 4, length / 4 + count);
+    double spliced = now() - begin;
+
+    printf("doubleLinked move %zu x %zu at %zu: getDel/insert %.2fms, splice %.2fms\n", count, rounds, length / 4,
+           moved * 1e3, spliced * 1e3);
+    doubleLinkedList_free(lists[0]);
+    doubleLinkedList_free(lists[1]);
+}
+
+// 按位置顺序读取与在相邻位置上反复插入删除。
+static void benchFinger(void) {
+    const ListImplType types[] = {ListImplType_Linked, ListImplType_DoubleLinked, ListImplType_CircleLinked};
+    const char *names[] = {"linked", "doubleLinked", "circleLinked"};
+    const size_t length = 20000;
+
+    for (int t = 0; t < 3; t++) {
+        List *list = list_alloc(sizeof(int), types[t]);
+        ListIter iter;
+        list_iterBegin(list, &iter);
+        for (int i = 0; i < length; i++)
+            list_iterInsertBefore(&iter, &i);
+
+        int elem;
+        double begin = now();
+        for (size_t i = 0; i < length; i++)
+            list_get(list, i, &elem);
+        double get = now() - begin;
+        begin = now();
+        for (size_t i = length / 3; i < length / 3 * 2; i++) {
+            list_insert(list, i, &elem);
+            list_del(list, i + 1);
+        }
+        double edit = now() - begin;
+
+        printf("%s x %zu: sequential get %.2fms, local insert/del %.2fms\n", names[t], length, get * 1e3,
+               edit * 1e3);
+        list_free(list);
+    }
+}
+
+// 百万元素上随机位置插入删除、随机读取与遍历：数组与跳表。
+static void benchSkipList(void) {
+    const ListImplType types[] = {ListImplType_Array, ListImplType_SkipList};
+    const char *names[] = {"array", "skipList"};
+    const size_t length = 1000000, ops = 10000;
+
+    for (int t = 0; t < 2; t++) {
+        List *list = list_alloc(sizeof(int), types[t]);
+        for (int i = 0; i < length; i++)
+            list_rpush(list, &i);
+
+        srand(1);
+        int elem = 0;
+        double begin = now();
+        for (size_t i = 0; i < ops; i++) {
+            list_insert(list, rand() % (list_len(list) + 1), &elem);
+            list_del(list, rand() % list_len(list));
+        }
+        double edit = now() - begin;
+        begin = now();
+        for (size_t i = 0; i < ops; i++)
+            list_get(list, rand() % length, &elem);
+        double get = now() - begin;
+        begin = now();
+        list_travel(list, benchVisitor);
+        double travel = now() - begin;
+
+        printf("%s x %zu: random insert+del %zu %.2fms, random get %zu %.2fms, travel %.2fms\n", names[t], length,
+               ops, edit * 1e3, ops, get * 1e3, travel * 1e3);
+        list_free(list);
+    }
+}
+
+// 百万元素上随机位置插入删除、随机读取与区间遍历：数组、跳表与B+树。
+static void benchBTree(void) {
+    const ListImplType types[] = {ListImplType_Array, ListImplType_SkipList, ListImplType_BTree};
+    const char *names[] = {"array", "skipList", "btree"};
+    const size_t length = 1000000, ops = 10000, window = 1000;
+
+    for (int t = 0; t < 3; t++) {
+        List *list = list_alloc(sizeof(int), types[t]);
+        for (int i = 0; i < length; i++)
+            list_rpush(list, &i);
+
+        srand(1);
+        int elem = 0;
+        double begin = now();
+        for (size_t i = 0; i < ops; i++) {
+            list_insert(list, rand() % (list_len(list) + 1), &elem);
+            list_del(list, rand() % list_len(list));
+        }
+        double edit = now() - begin;
+        begin = now();
+        for (size_t i = 0; i < ops; i++)
+            list_get(list, rand() % length, &elem);
+        double get = now() - begin;
+        long long sum = 0;
+        begin = now();
+        for (size_t i = 0; i < ops / 10; i++)
+            list_travelRange(list, rand() % (length - window), window, benchRangeVisitor, &sum);
+        double range = now() - begin;
+
+        printf("%s x %zu: random insert+del %zu %.2fms, random get %zu %.2fms, travelRange %zu x %zu %.2fms\n",
+               names[t], length, ops, edit * 1e3, ops, get * 1e3, ops / 10, window, range * 1e3);
+        list_free(list);
+    }
+}
+
+// 十万元素上遍历、查找不存在的元素与随机位置插入删除：双向链表与不同块大小的分块链表。
+static void benchUnrolled(void) {
+    const ListImplType types[] = {ListImplType_DoubleLinked, ListImplType_Unrolled, ListImplType_Unrolled};
+    const size_t blockSizes[] = {0, 16, 0};
+    const char *names[] = {"doubleLinked", "unrolled/16", "unrolled/default"};
+    const size_t length = 100000, ops = 10000, rounds = 100;
+
+    for (int t = 0; t < 3; t++) {
+        List *list = list_allocWithOptions(sizeof(int), types[t], &(ListOptions) {.blockSize = blockSizes[t]});
+        for (int i = 0; i < length; i++)
+            list_rpush(list, &i);
+
+        double begin = now();
+        for (size_t i = 0; i < rounds; i++)
+            list_travel(list, benchVisitor);
+        double travel = now() - begin;
+        int elem = -1;
+        size_t index;
+        begin = now();
+        for (size_t i = 0; i < rounds; i++)
+            list_locate(list, benchCmp, &elem, &index);
+        double locate = now() - begin;
+        srand(1);
+        elem = 0;
+        begin = now();
+        for (size_t i = 0; i < ops; i++) {
+            list_insert(list, rand() % (list_len(list) + 1), &elem);
+            list_del(list, rand() % list_len(list));
+        }
+        double edit = now() - begin;
+
+        printf("%s x %zu: travel x %zu %.2fms, locate miss x %zu %.2fms, random insert+del %zu %.2fms\n", names[t],
+               length, rounds, travel * 1e3, rounds, locate * 1e3, ops, edit * 1e3);
+        list_free(list);
+    }
+}
+
+// 百万元素排序：int与64字节结构体，以qsort为参照。
+static void benchSort(void) {
+    const ListImplType types[] = {ListImplType_Array, ListImplType_StaticLinked, ListImplType_Linked,
+                                  ListImplType_DoubleLinked, ListImplType_Deque, ListImplType_BTree};
+    const char *names[] = {"array", "staticLinked", "linked", "doubleLinked", "deque", "btree"};
+    const size_t elemSizes[] = {sizeof(int), 64}, length = 1000000;
+
+    for (int e = 0; e < 2; e++) {
+        size_t elemSize = elemSizes[e];
+        unsigned char *elems = calloc(length, elemSize);
+        srand(1);
+        for (size_t i = 0; i < length; i++)
+            *(int *) (elems + i * elemSize) = rand();
+
+        unsigned char *copy = malloc(length * elemSize);
+        memcpy(copy, elems, length * elemSize);
+        double begin = now();
+        qsort(copy, length, elemSize, benchQsortCmp);
+        printf("qsort x %zu, %zu bytes: %.2fms\n", length, elemSize, (now() - begin) * 1e3);
+        free(copy);
+
+        for (int t = 0; t < 6; t++) {
+            double costs[2];
+            for (int stable = 0; stable < 2; stable++) {
+                List *list = list_alloc(elemSize, types[t]);
+                list_rpushN(list, elems, length);
+                begin = now();
+                (stable ? list_sortStable : list_sort)(list, benchKeyCmp, NULL);
+                costs[stable] = now() - begin;
+                list_free(list);
+            }
+            printf("%s x %zu, %zu bytes: sort %.2fms, sortStable %.2fms\n", names[t], length, elemSize,
+                   costs[0] * 1e3, costs[1] * 1e3);
+        }
+        free(elems);
+    }
+}
+
+// 一千万个int多线程排序，线程数1、2、4、8，以单线程排序为参照。
+static void benchParallelSort(void) {
+    const size_t length = 10000000, threads[] = {1, 2, 4, 8};
+    int *elems = malloc(length * sizeof(int));
+    srand(1);
+    for (size_t i = 0; i < length; i++)
+        elems[i] = rand();
+
+    ArrayList *list = arrayList_alloc(sizeof(int));
+    arrayList_rpushN(list, elems, length);
+    double begin = now();
+    arrayList_sort(list, benchKeyCmp, NULL);
+    double sort = now() - begin;
+    arrayList_clear(list);
+    arrayList_rpushN(list, elems, length);
+    begin = now();
+    arrayList_sortStable(list, benchKeyCmp, NULL);
+    printf("array x %zu: sort %.2fms, sortStable %.2fms\n", length, sort * 1e3, (now() - begin) * 1e3);
+
+    for (int t = 0; t < 4; t++) {
+        arrayList_clear(list);
+        arrayList_rpushN(list, elems, length);
+        begin = now();
+        arrayList_parallelSort(list, benchKeyCmp, NULL, threads[t]);
+        sort = now() - begin;
+        arrayList_clear(list);
+        arrayList_rpushN(list, elems, length);
+        begin = now();
+        arrayList_parallelSortStable(list, benchKeyCmp, NULL, threads[t]);
+        printf("array x %zu, %zu threads: parallelSort %.2fms, parallelSortStable %.2fms\n", length, threads[t],
+               sort * 1e3, (now() - begin) * 1e3);
+    }
+    arrayList_free(list);
+    free(elems);
+}
+
+// 有序插入：逐个线性比较定位（多项式原写法）与二分定位，各表插入一万个随机键。
+static void benchSortedInsert(void) {
+    const ListImplType types[] = {ListImplType_Array, ListImplType_Deque, ListImplType_BTree, ListImplType_Unrolled};
+    const char *names[] = {"array", "deque", "btree", "unrolled"};
+    const int length = 10000;
+
+    for (int t = 0; t < 4; t++) {
+        List *list = list_alloc(sizeof(int), types[t]);
+        srand(1);
+        double begin = now();
+        for (int i = 0; i < length; i++) {
+            int key = rand() % (length * 10), elem;
+            size_t index = 0, size = list_len(list);
+            while (index < size && (list_get(list, index, &elem), elem <= key))
+                index++;
+            list_insert(list, index, &key);
+        }
+        double linear = now() - begin;
+        list_free(list);
+
+        list = list_alloc(sizeof(int), types[t]);
+        srand(1);
+        begin = now();
+        for (int i = 0; i < length; i++) {
+            int key = rand() % (length * 10);
+            list_sortedInsert(list, benchKeyCmp, &key, NULL);
+        }
+        double binary = now() - begin;
+        size_t index, hits = 0;
+        begin = now();
+        for (int key = 0; key < length * 10; key++)
+            hits += !list_binarySearch(list, benchKeyCmp, &key, NULL, &index);
+        printf("%s x %d: linear insert %.2fms, sortedInsert %.2fms, binarySearch x %d %.2fms (%zu hits)\n", names[t],
+               length, linear * 1e3, binary * 1e3, length * 10, (now() - begin) * 1e3, hits);
+        list_free(list);
+    }
+}
+
+// 一百万个元素中查找末尾元素：比较函数逐个回调与按字节定位，键为4、8、16字节的整个元素或24字节元素内的4字节键。
+static void benchLocateKey(void) {
+    const size_t length = 1000000, elemSizes[] = {4, 8, 16, 24};
+    const ListImplType types[] = {ListImplType_Array, ListImplType_Deque, ListImplType_BTree, ListImplType_Unrolled};
+    const char *names[] = {"array", "deque", "btree", "unrolled"};
+    const int rounds = 20;
+
+    for (int e = 0; e < 4; e++) {
+        size_t elemSize = elemSizes[e], index;
+        unsigned char *elems = calloc(length, elemSize);
+        for (size_t i = 0; i < length; i++)
+            *(int *) (elems + i * elemSize) = (int) i;
+        const unsigned char *key = elems + (length - 1) * elemSize;
+        size_t keySize = elemSize == 24 ? sizeof(int) : elemSize;
+        ListElemComparer *cmp = elemSize == 4 ? benchCmp : elemSize == 8 ? benchWideCmp : elemSize == 16 ? benchPairCmp : benchCmp;
+
+        ArrayList *array = arrayList_alloc(elemSize);
+        arrayList_rpushN(array, elems, length);
+        double begin = now();
+        for (int r = 0; r < rounds; r++)
+            arrayList_locate(array, cmp, key, &index);
+        double callback = (now() - begin) / rounds;
+        arrayList_free(array);
+        printf("%zu-byte elements, %zu-byte key x %zu: array locate %.3fms", elemSize, keySize, length, callback * 1e3);
+
+        for (int t = 0; t < 4; t++) {
+            List *list = list_alloc(elemSize, types[t]);
+            list_rpushN(list, elems, length);
+            begin = now();
+            for (int r = 0; r < rounds; r++)
+                list_locateBytes(list, 0, key, keySize, &index);
+            printf(", %s locateBytes %.3fms", names[t], (now() - begin) / rounds * 1e3);
+            list_free(list);
+        }
+        printf("\n");
+        free(elems);
+    }
+}
+
+// 一千万个int：类型擦除的ArrayList与CLIB_ARRAY_LIST_DEFINE生成的类型化顺序表，逐个追加、按下标读取求和、逐个改写。
+static void benchTyped(void) {
+    const int length = 10000000;
+    ArrayList *list = arrayList_alloc(sizeof(int));
+    BenchIntList *typed = BenchIntList_alloc();
+    double costs[2][3];
+
+    double begin = now();
+    for (int i = 0; i < length; i++)
+        arrayList_rpush(list, &i);
+    costs[0][0] = now() - begin;
+    begin = now();
+    for (int i = 0; i < length; i++)
+        BenchIntList_rpush(typed, &i);
+    costs[1][0] = now() - begin;
+
+    long long sums[2] = {0};
+    begin = now();
+    for (size_t i = 0; i < (size_t) length; i++) {
+        int elem = 0;
+        if (!arrayList_get(list, i, &elem))
+            sums[0] += elem;
+    }
+    costs[0][1] = now() - begin;
+    begin = now();
+    for (size_t i = 0; i < (size_t) length; i++) {
+        int elem = 0;
+        if (!BenchIntList_get(typed, i, &elem))
+            sums[1] += elem;
+    }
+    costs[1][1] = now() - begin;
+
+    begin = now();
+    for (size_t i = 0; i < (size_t) length; i++) {
+        int elem = (int) i * 3;
+        arrayList_set(list, i, &elem);
+    }
+    costs[0][2] = now() - begin;
+    begin = now();
+    for (size_t i = 0; i < (size_t) length; i++) {
+        int elem = (int) i * 3;
+        BenchIntList_set(typed, i, &elem);
+    }
+    costs[1][2] = now() - begin;
+
+    const char *names[] = {"ArrayList", "BenchIntList"};
+    for (int k = 0; k < 2; k++)
+        printf("%s x %d: rpush %.2fms, get %.2fms (sum %lld), set %.2fms\n", names[k], length, costs[k][0] * 1e3,
+               costs[k][1] * 1e3, sums[k], costs[k][2] * 1e3);
+    BenchIntList_free(typed);
+    arrayList_free(list);
+}
+
+// 两千万个int的顺序表与静态链表，多线程遍历、查找末尾元素、求和，线程数1、2、4、8。
+// 线程数超过共享线程池工作线程数加1时实际按该值执行，输出中同时给出实际线程数。
+static void benchParallel(void) {
+    const ListImplType types[] = {ListImplType_Array, ListImplType_StaticLinked};
+    const char *names[] = {"array", "staticLinked"};
+    const size_t length = 20000000, threads[] = {1, 2, 4, 8};
+    ThreadPool *pool = threadPool_shared();
+    size_t maxThreads = pool ? threadPool_threads(pool) + 1 : 1;
+
+    for (int t = 0; t < 2; t++) {
+        List *list = list_alloc(sizeof(int), types[t]);
+        for (size_t i = 0; i < length; i++)
+            list_rpush(list, &(int) {(int) i});
+        int last = (int) length - 1;
+        for (int k = 0; k < 4; k++) {
+            double begin = now();
+            list_parallelTravel(list, benchIncVisitor, NULL, threads[k]);
+            double travel = now() - begin;
+            size_t index;
+            last++;
+            begin = now();
+            list_parallelLocate(list, benchEqualCmp, &last, NULL, &index, threads[k]);
+            double locate = now() - begin;
+            long long sum = 0;
+            begin = now();
+            list_parallelReduce(list, benchSumAccumulate, benchSumCombine, &sum, sizeof(sum), NULL, threads[k]);
+            printf("%s x %zu, %zu threads (effective %zu): travel %.2fms, locate %.2fms (index %zu), reduce %.2fms (sum %lld)\n",
+                   names[t], length, threads[k], threads[k] < maxThreads ? threads[k] : maxThreads, travel * 1e3, locate * 1e3, index, (now() - begin) * 1e3, sum);
+        }
+        list_free(list);
+    }
+}
+
+static int benchIncVisitor(void *elem, void *ctx) {
+    (*(int *) elem)++;
+    return 0;
+}
+
+static int benchEqualCmp(const void *e1, const void *e2, void *ctx) {
+    return *(const int *) e1 != *(const int *) e2;
+}
+
+static void benchSumAccumulate(void *acc, const void *elem, void *ctx) {
+    *(long long *) acc += *(const int *) elem;
+}
+
+static void benchSumCombine(void *dst, const void *src, void *ctx) {
+    *(long long *) dst += *(const long long *) src;
+}
+
+static void benchVisitor(void *elem) {
+    (*(int *) elem)++;
+}
+
+static int benchRangeVisitor(void *elem, void *ctx) {
+    *(long long *) ctx += *(int *) elem;
+    return 0;
+}
+
+static int benchCmp(const void *e1, const void *e2) {
+    return *(const int *) e1 != *(const int *) e2;
+}
+
+static int benchWideCmp(const void *e1, const void *e2) {
+    return *(const long long *) e1 != *(const long long *) e2;
+}
+
+static int benchPairCmp(const void *e1, const void *e2) {
+    const long long *p1 = e1, *p2 = e2;
+    return p1[0] != p2[0] || p1[1] != p2[1];
+}
+
+static int benchKeyCmp(const void *e1, const void *e2, void *ctx) {
+    int k1 = *(const int *) e1, k2 = *(const int *) e2;
+    return (k1 > k2) - (k1 < k2);
+}
+
+static int benchQsortCmp(const void *e1, const void *e2) {
+    return benchKeyCmp(e1, e2, NULL);
+}
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + (double) ts.tv_nsec / 1e9;
+}
+
+// 原基于switch的分发方式，用于对比。
+static int switchGet(const List *list, size_t index, void *elem) {
+    switch (list->type) {
+        case ListImplType_Array:
+            return arrayList_get(list->impl, index, elem);
+        case ListImplType_Linked:
+            return linkedList_get(list->impl, index, elem);
+        case ListImplType_DoubleLinked:
+            return doubleLinkedList_get(list->impl, index, elem);
+        case ListImplType_StaticLinked:
+            return staticLinkedList_get(list->impl, index, elem);
+        case ListImplType_CircleLinked:
+            return circleLinkedList_get(list->impl, index, elem);
+        default:
+            return 1;
+    }
+}
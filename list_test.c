@@ -11,6 +11,7 @@
  */
 
 #include <assert.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <time.h>
 
@@ -18,44 +19,211 @@
 
 #define TEST_LENGTH 40000
 
+static int *collected;
+
+static size_t collectedLen;
+
 static int intCmp(const void *o1, const void *o2);
 
 static void intVisitor(void *p);
 
 static void testListImpl(ListImplType);
 
+static void testSharedPool(void);
+
+static void testIndexWidth(void);
+
+static void testBlockSize(void);
+
+static void testInsertRangeFailure(void);
+
+static void testNodeAllocFailure(ListImplType type);
+
+static int limitedInsert(void *impl, size_t index, const void *elem);
+
+static void testIter(ListImplType type);
+
+static void testCtx(ListImplType type);
+
+static void testSort(ListImplType type);
+
+static void testSorted(ListImplType type);
+
+static void testLocateBytes(ListImplType type);
+
+static void testParallel(ListImplType type);
+
+static int incVisitor(void *elem, void *ctx);
+
+static int stopVisitor(void *elem, void *ctx);
+
+static int valueCmp(const void *o1, const void *o2, void *ctx);
+
+static void hashAccumulate(void *acc, const void *elem, void *ctx);
+
+static void hashCombine(void *dst, const void *src, void *ctx);
+
+static int pairCmp(const void *o1, const void *o2, void *ctx);
+
+static int sumVisitor(void *p, void *ctx);
+
+static int modCmp(const void *o1, const void *o2, void *ctx);
+
+static void collectVisitor(void *p);
+
 int main(void) {
     time_t now = time(NULL);
 
     srand(now + 100);
-    // time_t begin = time(NULL);
     testListImpl(ListImplType_Array);
-    // printf("array list cost %fs\n", difftime(time(NULL), begin));
 
     srand(now + 100);
-    // begin = time(NULL);
     testListImpl(ListImplType_DoubleLinked);
-    // printf("double linked list cost %fs\n", difftime(time(NULL), begin));
 
     srand(now + 100);
-    // begin = time(NULL);
     testListImpl(ListImplType_CircleLinked);
-    // printf("circle linked list cost %fs\n", difftime(time(NULL), begin));
 
     srand(now + 100);
-    // begin = time(NULL);
     testListImpl(ListImplType_Linked);
-    // printf("linked list cost %fs\n", difftime(time(NULL), begin));
 
     srand(now + 100);
-    // begin = time(NULL);
     testListImpl(ListImplType_StaticLinked);
-    // printf("static linked list cost %fs\n", difftime(time(NULL), begin));
+
+    srand(now + 100);
+    testListImpl(ListImplType_Deque);
+
+    srand(now + 100);
+    testListImpl(ListImplType_SkipList);
+
+    srand(now + 100);
+    testListImpl(ListImplType_BTree);
+
+    srand(now + 100);
+    testListImpl(ListImplType_Unrolled);
+
+    ListImplType custom;
+    static ListImplOps incomplete;
+    incomplete = arrayListOps;
+    incomplete.locateCtx = NULL;
+    assert(list_registerImpl(&incomplete, &custom) == 3);
+    incomplete = linkedListOps;
+    incomplete.iterErase = NULL;
+    assert(list_registerImpl(&incomplete, &custom) == 3);
+    assert(list_registerImpl(NULL, &custom) == 3);
+    assert(!list_registerImpl(&arrayListOps, &custom));
+    assert(custom >= ListImplType_Custom);
+    srand(now + 100);
+    testListImpl(custom);
+
+    testSharedPool();
+    testIndexWidth();
+    testBlockSize();
+    testInsertRangeFailure();
+    testNodeAllocFailure(ListImplType_Linked);
+    testNodeAllocFailure(ListImplType_DoubleLinked);
+    testNodeAllocFailure(ListImplType_CircleLinked);
 }
 
-static void testListImpl(ListImplType type) {
+// 链式实现的节点池无法分配时各插入操作返回2，线性表不变。
+static void testNodeAllocFailure(ListImplType type) {
+    NodePool *pool = nodePool_alloc(SIZE_MAX / 1024);
+    List *list = list_allocWithOptions(sizeof(int), type, &(ListOptions) {.usePool = 1, .pool = pool});
+    int elems[3] = {1, 2, 3};
+    assert(list_insert(list, 0, elems) == 2);
+    assert(list_lpush(list, elems) == 2);
+    assert(list_rpush(list, elems) == 2);
+    assert(list_insertRange(list, 0, elems, 3) == 2);
+    ListIter iter;
+    list_iterBegin(list, &iter);
+    assert(list_iterInsertBefore(&iter, elems) == 2);
+    assert(!list_len(list));
+    list_free(list);
+    nodePool_free(pool);
+}
+
+// 逐个插入的回退实现中途失败时撤销已插入的元素。
+static void testInsertRangeFailure(void) {
+    static ListImplOps ops;
+    ops = arrayListOps;
+    ops.insert = limitedInsert;
+    ops.insertRange = NULL;
+    ListImplType type;
+    assert(!list_registerImpl(&ops, &type));
     List *list = list_alloc(sizeof(int), type);
+    int elems[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+    assert(!list_insertRange(list, 0, elems, 3));
+    assert(list_insertRange(list, 1, elems + 3, 5) == 2);
+    assert(list_len(list) == 3);
+    for (int i = 0; i < 3; i++)
+        assert(*(int *) list_at(list, i) == i);
+    assert(list_insertRange(list, 4, elems, 1) == 1);
+    list_free(list);
+}
+
+// 元素个数达到6个后插入失败。
+static int limitedInsert(void *impl, size_t index, const void *elem) {
+    if (arrayList_len(impl) >= 6)
+        return 2;
+    return arrayList_insert(impl, index, elem);
+}
+
+// 静态链表的索引宽度限制容量。
+static void testIndexWidth(void) {
+    List *list = list_allocWithOptions(sizeof(int), ListImplType_StaticLinked,
+                                       &(ListOptions) {.indexWidth = ListIndexWidth_16});
+    for (int i = 0; i < 65536; i++)
+        assert(!list_rpush(list, &i));
+    int elem = 0;
+    assert(list_rpush(list, &elem) == 2);
+    assert(!list_lpop(list, &elem) && elem == 0);
+    assert(!list_rpush(list, &elem));
+    assert(!list_get(list, 65535, &elem) && elem == 0);
+    list_free(list);
+}
+
+// 分块链表按选项设置块大小。
+static void testBlockSize(void) {
+    List *list = list_allocWithOptions(sizeof(int), ListImplType_Unrolled, &(ListOptions) {.blockSize = 4});
+    assert(((UnrolledList *) list->impl)->blockCapacity == 4);
+    for (int i = 0; i < 10; i++)
+        assert(!list_rpush(list, &i));
+    ListSpan span;
+    assert(!list_span(list, 4, 4, &span) && ((int *) span.base)[3] == 7);
+    assert(list_span(list, 3, 2, &span) == 2);
+    list_free(list);
+}
+
+// 链式实现间共享节点池，节点大小不同的实现不能共享。
+static void testSharedPool(void) {
+    NodePool *pool = nodePool_alloc(0);
+    ListOptions opts = {.usePool = 1, .pool = pool};
+    List *list0 = list_allocWithOptions(sizeof(int), ListImplType_DoubleLinked, &opts);
+    List *list1 = list_allocWithOptions(sizeof(int), ListImplType_CircleLinked, &opts);
+    assert(list0 && list1);
+    assert(!list_allocWithOptions(sizeof(double[4]), ListImplType_Linked, &opts));
+
+    for (int i = 0; i < 1000; i++) {
+        assert(!list_rpush(list0, &i));
+        assert(!list_rpush(list1, &i));
+    }
+    int elem;
+    for (int i = 0; i < 1000; i++) {
+        assert(!list_lpop(list0, &elem));
+        assert(elem == i);
+        assert(!list_rpush(list1, &elem));
+    }
+    assert(list_len(list1) == 2000);
+    assert(!list_clear(list1));
+    list_free(list0);
+    list_free(list1);
+    nodePool_free(pool);
+}
+
+static void testListImpl(ListImplType type) {
+    ListGrowthPolicy policy = {.initCapacity = 16, .growFactor = 1.5, .shrinkFactor = 4};
+    List *list = list_allocWithOptions(sizeof(int), type, &(ListOptions) {.growth = &policy, .usePool = 1});
     assert(list);
+    assert(!list_reserve(list, 8));
 
     int elem = 2;
     size_t index = 0;
@@ -104,14 +272,386 @@ static void testListImpl(ListImplType type) {
         assert(!list_get(list, index, &res));
         assert(res == elem);
     }
+    collected = malloc(sizeof(int) * TEST_LENGTH);
+    collectedLen = 0;
+    assert(!list_travel(list, collectVisitor));
+    ListIter iter;
+    index = 0;
+    for (list_iterBegin(list, &iter); !list_iterGet(&iter, &res); list_iterNext(&iter))
+        assert(res == collected[index++]);
+    assert(index == TEST_LENGTH && list_iterEnd(&iter));
+    free(collected);
+
     for (int i = 0; i < TEST_LENGTH; i++) {
         length = list_len(list);
         index = rand() % length;
         assert(!list_del(list, index));
     }
 
+    int elems[] = {1, 2, 3, 4, 5};
+    int range[5];
+    assert(!list_rpushN(list, elems, 3));
+    assert(!list_insertRange(list, 1, elems + 3, 2));
+    assert(list_len(list) == 5);
+    assert(!list_getRange(list, 0, 5, range));
+    assert(range[0] == 1 && range[1] == 4 && range[2] == 5 && range[3] == 2 && range[4] == 3);
+    assert(list_getRange(list, 3, 3, range) == 1);
+    assert(!list_delRange(list, 1, 3));
+    assert(list_len(list) == 2);
+    assert(!list_getRange(list, 0, 2, range));
+    assert(range[0] == 1 && range[1] == 3);
+    assert(list_delRange(list, 1, 2) == 1);
+
+    *(int *) list_at(list, 1) = 7;
+    assert(!list_get(list, 1, &elem) && elem == 7);
+    assert(list_at(list, 2) == NULL);
+    ListSpan span;
+    int spanRes = list_span(list, 0, 2, &span);
+    if (!spanRes) {
+        assert(span.length == 2 && ((int *) span.base)[0] == 1);
+        assert(*(int *) ((char *) span.base + span.stride) == 7);
+    } else {
+        assert(spanRes == 2);
+    }
+
+    assert(!list_shrinkToFit(list));
     list_clear(list);
     list_free(list);
+
+    testIter(type);
+    testCtx(type);
+    testSort(type);
+    testSorted(type);
+    testLocateBytes(type);
+    testParallel(type);
+}
+
+typedef struct {
+    long long sum;
+    int stopAt;
+    size_t visited;
+} SumCtx;
+
+// 带上下文的遍历与查找，上下文各自独立。
+static void testCtx(ListImplType type) {
+    List *list = list_alloc(sizeof(int), type);
+    for (int i = 1; i <= 100; i++)
+        assert(!list_rpush(list, &i));
+
+    SumCtx ctx0 = {.stopAt = 0}, ctx1 = {.stopAt = 10};
+    assert(!list_travelCtx(list, sumVisitor, &ctx0));
+    assert(ctx0.sum == 5050 && ctx0.visited == 100);
+    assert(list_travelCtx(list, sumVisitor, &ctx1) == 10);
+    assert(ctx1.sum == 55 && ctx1.visited == 10);
+
+    SumCtx ctx2 = {.stopAt = 0}, ctx3 = {.stopAt = 60};
+    assert(!list_travelRange(list, 10, 20, sumVisitor, &ctx2));
+    assert(ctx2.sum == 410 && ctx2.visited == 20);
+    assert(list_travelRange(list, 50, 50, sumVisitor, &ctx3) == 60);
+    assert(ctx3.sum == 555 && ctx3.visited == 10);
+    assert(!list_travelRange(list, 100, 0, sumVisitor, &ctx2));
+    assert(list_travelRange(list, 90, 11, sumVisitor, &ctx2) == 1);
+    assert(ctx2.visited == 20);
+
+    int mod = 7, rem = 3;
+    size_t index;
+    assert(!list_locateCtx(list, modCmp, &rem, &mod, &index));
+    assert(index == 2);
+    mod = 40;
+    assert(!list_locateCtx(list, modCmp, &rem, &mod, &index));
+    assert(index == 2);
+    rem = 0;
+    assert(!list_locateCtx(list, modCmp, &rem, &mod, &index));
+    assert(index == 39);
+    mod = 101;
+    assert(list_locateCtx(list, modCmp, &rem, &mod, &index) == 1);
+
+    list_free(list);
+}
+
+typedef struct {
+    int key;
+    int seq;
+} SortPair;
+
+// 排序随机、有序、逆序与全部相等的数据，稳定排序时相等键保持插入顺序。
+static void testSort(ListImplType type) {
+    const int length = 3000;
+    int *seen = malloc(sizeof(int) * length);
+    for (int round = 0; round < 8; round++) {
+        _Bool stable = round % 2;
+        List *list = list_alloc(sizeof(SortPair), type);
+        for (int i = 0; i < length; i++) {
+            int keys[] = {rand() % 50, i, length - i, 7};
+            SortPair pair = {keys[round / 2], i};
+            assert(!list_rpush(list, &pair));
+        }
+        size_t compares = 0;
+        assert(!(stable ? list_sortStable : list_sort)(list, pairCmp, &compares));
+        assert(compares > 0 && list_len(list) == length);
+
+        memset(seen, 0, sizeof(int) * length);
+        SortPair prev = {-1, -1}, pair;
+        ListIter iter;
+        for (list_iterBegin(list, &iter); !list_iterGet(&iter, &pair); list_iterNext(&iter)) {
+            assert(pair.key >= prev.key);
+            if (stable && pair.key == prev.key)
+                assert(pair.seq > prev.seq);
+            assert(!seen[pair.seq]++);
+            prev = pair;
+        }
+        assert(!list_get(list, length - 1, &pair) && pair.key == prev.key && pair.seq == prev.seq);
+        list_free(list);
+    }
+    free(seen);
+
+    List *list = list_alloc(sizeof(SortPair), type);
+    assert(!list_sort(list, pairCmp, &(size_t) {0}));
+    SortPair pair = {1, 0};
+    assert(!list_rpush(list, &pair));
+    assert(!list_sortStable(list, pairCmp, &(size_t) {0}));
+    assert(!list_lpop(list, &pair) && pair.key == 1 && !list_len(list));
+    list_free(list);
+}
+
+// 有序插入后上下界与线性扫描一致，稳定插入使相等键按插入顺序排列。
+static void testSorted(ListImplType type) {
+    List *list = list_alloc(sizeof(SortPair), type);
+    size_t compares = 0, index;
+    SortPair pair = {5, 0};
+    assert(!list_lowerBound(list, pairCmp, &pair, &compares, &index) && index == 0);
+    assert(!list_upperBound(list, pairCmp, &pair, &compares, &index) && index == 0);
+    assert(list_binarySearch(list, pairCmp, &pair, &compares, &index) == 1 && index == 0);
+
+    const int length = 2000;
+    for (int i = 0; i < length; i++) {
+        pair.key = rand() % 200 * 2;
+        pair.seq = i;
+        assert(!list_sortedInsert(list, pairCmp, &pair, &compares));
+    }
+    SortPair prev = {-1, -1};
+    ListIter iter;
+    for (list_iterBegin(list, &iter); !list_iterGet(&iter, &pair); list_iterNext(&iter)) {
+        assert(pair.key > prev.key || (pair.key == prev.key && pair.seq > prev.seq));
+        prev = pair;
+    }
+
+    for (int key = -1; key <= 400; key++) {
+        size_t lower = 0, upper;
+        while (lower < length && (list_get(list, lower, &pair), pair.key < key))
+            lower++;
+        for (upper = lower; upper < length && (list_get(list, upper, &pair), pair.key == key);)
+            upper++;
+        SortPair probe = {key, 0};
+        assert(!list_lowerBound(list, pairCmp, &probe, &compares, &index) && index == lower);
+        assert(!list_upperBound(list, pairCmp, &probe, &compares, &index) && index == upper);
+        int res = list_binarySearch(list, pairCmp, &probe, &compares, &index);
+        assert(index == lower && res == (lower == upper));
+    }
+    list_free(list);
+}
+
+// 按字节定位与逐个比较的结果一致，覆盖整个元素作为4、8、16、24字节键以及元素内偏移处的4字节键。
+// 交替从两端插入，使双端队列的缓冲区环绕。
+static void testLocateBytes(ListImplType type) {
+    const size_t elemSizes[] = {4, 8, 16, 24};
+    const int length = 300;
+    for (int e = 0; e < 4; e++) {
+        size_t elemSize = elemSizes[e], index;
+        unsigned char elem[24], got[24];
+        List *list = list_alloc(elemSize, type);
+        assert(list_locateBytes(list, 0, elem, 4, &index) == 1);
+        for (int i = 0; i < length; i++) {
+            int value = i * 3;
+            memset(elem, 0x5a, elemSize);
+            memcpy(elem, &value, sizeof(value));
+            memcpy(elem + elemSize - sizeof(value), &value, sizeof(value));
+            assert(!(i % 2 ? list_lpush : list_rpush)(list, elem));
+        }
+        assert(list_locateBytes(list, elemSize - 3, elem, 4, &index) == 1);
+
+        for (int value = -1; value <= length * 3; value++) {
+            memset(elem, 0x5a, elemSize);
+            memcpy(elem, &value, sizeof(value));
+            memcpy(elem + elemSize - sizeof(value), &value, sizeof(value));
+            size_t expect = 0;
+            ListIter iter;
+            for (list_iterBegin(list, &iter); !list_iterGet(&iter, got); list_iterNext(&iter), expect++)
+                if (!memcmp(got, elem, elemSize))
+                    break;
+            int found = expect < (size_t) length;
+            index = length;
+            assert(list_locateBytes(list, 0, elem, elemSize, &index) == !found);
+            assert(!found || index == expect);
+            index = length;
+            assert(list_locateBytes(list, elemSize - sizeof(value), &value, sizeof(value), &index) == !found);
+            assert(!found || index == expect);
+        }
+        list_free(list);
+    }
+}
+
+// 多线程遍历、查找、归约与单线程结果一致；归约的合并不满足交换律，结果仍与线程数无关。
+static void testParallel(ListImplType type) {
+    const int length = 50000;
+    List *list = list_alloc(sizeof(int), type);
+    for (int i = 0; i < length; i++) {
+        int elem = i % 20000;
+        assert(!list_rpush(list, &elem));
+    }
+    unsigned long long expect[2] = {0, 1};
+    for (int i = 0; i < length; i++)
+        hashAccumulate(expect, &(int) {i % 20000}, NULL);
+
+    const size_t threads[] = {0, 1, 3, 8};
+    for (int t = 0; t < 4; t++) {
+        assert(!list_parallelTravel(list, incVisitor, NULL, threads[t]));
+        ListIter iter;
+        int i = 0, elem;
+        for (list_iterBegin(list, &iter); !list_iterGet(&iter, &elem); list_iterNext(&iter), i++)
+            assert(elem == i % 20000 + 1);
+        assert(!list_parallelTravel(list, incVisitor, &(int) {-1}, threads[t]));
+
+        int stopAt = 12345;
+        assert(list_parallelTravel(list, stopVisitor, &stopAt, threads[t]) == 7);
+
+        size_t index = length;
+        for (int value = 0; value < 20000; value += 997) {
+            assert(!list_parallelLocate(list, valueCmp, &value, NULL, &index, threads[t]));
+            assert(index == (size_t) value);
+        }
+        int missing = 20000;
+        assert(list_parallelLocate(list, valueCmp, &missing, NULL, &index, threads[t]) == 1);
+
+        unsigned long long hash[2] = {0, 1};
+        assert(!list_parallelReduce(list, hashAccumulate, hashCombine, hash, sizeof(hash), NULL, threads[t]));
+        assert(hash[0] == expect[0] && hash[1] == expect[1]);
+    }
+
+    List *empty = list_alloc(sizeof(int), type);
+    unsigned long long hash[2] = {0, 1};
+    size_t index;
+    assert(!list_parallelTravel(empty, stopVisitor, &(int) {0}, 4));
+    assert(list_parallelLocate(empty, valueCmp, &(int) {0}, NULL, &index, 4) == 1);
+    assert(!list_parallelReduce(empty, hashAccumulate, hashCombine, hash, sizeof(hash), NULL, 4));
+    assert(hash[0] == 0 && hash[1] == 1);
+    list_free(empty);
+    list_free(list);
+}
+
+// ctx非NULL时加上其指向的值，否则加1。
+static int incVisitor(void *elem, void *ctx) {
+    *(int *) elem += ctx ? *(int *) ctx : 1;
+    return 0;
+}
+
+static int stopVisitor(void *elem, void *ctx) {
+    return *(int *) elem == *(int *) ctx ? 7 : 0;
+}
+
+static int valueCmp(const void *o1, const void *o2, void *ctx) {
+    return *(const int *) o1 != *(const int *) o2;
+}
+
+// 多项式哈希{h, p}：依次累加元素e得h*31+e，p为31的元素个数次幂，合并时dst在前。
+static void hashAccumulate(void *acc, const void *elem, void *ctx) {
+    unsigned long long *h = acc;
+    h[0] = h[0] * 31 + (unsigned int) *(const int *) elem;
+    h[1] *= 31;
+}
+
+static void hashCombine(void *dst, const void *src, void *ctx) {
+    unsigned long long *d = dst;
+    const unsigned long long *s = src;
+    d[0] = d[0] * s[1] + s[0];
+    d[1] *= s[1];
+}
+
+static int pairCmp(const void *o1, const void *o2, void *ctx) {
+    (*(size_t *) ctx)++;
+    const SortPair *p1 = o1, *p2 = o2;
+    return (p1->key > p2->key) - (p1->key < p2->key);
+}
+
+static int sumVisitor(void *p, void *ctx) {
+    SumCtx *sum = ctx;
+    int i = *(int *) p;
+    sum->sum += i;
+    sum->visited++;
+    return i == sum->stopAt ? i : 0;
+}
+
+static int modCmp(const void *o1, const void *o2, void *ctx) {
+    int mod = *(int *) ctx;
+    return *(int *) o1 % mod - *(int *) o2;
+}
+
+// 迭代器顺序读写、插入与删除。
+static void testIter(ListImplType type) {
+    List *list = list_alloc(sizeof(int), type);
+    ListIter iter;
+    int elem;
+
+    list_iterBegin(list, &iter);
+    assert(list_iterEnd(&iter));
+    assert(list_iterNext(&iter) == 1);
+    assert(list_iterGet(&iter, &elem) == 1);
+    assert(list_iterErase(&iter, NULL) == 1);
+    assert(!list_iterAt(&iter));
+
+    // 迭代结束时插入即追加：[0, 1, ..., 99]
+    for (elem = 0; elem < 100; elem++)
+        assert(!list_iterInsertBefore(&iter, &elem));
+    assert(list_len(list) == 100 && list_iterEnd(&iter));
+
+    // 删除偶数，奇数前插入其相反数，奇数乘以十：[-1, 10, -3, 30, ...]
+    for (list_iterBegin(list, &iter); !list_iterEnd(&iter);) {
+        assert(!list_iterGet(&iter, &elem));
+        if (elem % 2 == 0) {
+            int erased;
+            assert(!list_iterErase(&iter, &erased));
+            assert(erased == elem);
+            continue;
+        }
+        int neg = -elem;
+        assert(!list_iterInsertBefore(&iter, &neg));
+        elem *= 10;
+        assert(!list_iterSet(&iter, &elem));
+        assert(!list_iterNext(&iter));
+    }
+    assert(list_len(list) == 100);
+
+    int i = 0;
+    for (list_iterBegin(list, &iter); !list_iterGet(&iter, &elem); list_iterNext(&iter), i++) {
+        int odd = i / 2 * 2 + 1;
+        assert(elem == (i % 2 ? odd * 10 : -odd));
+        int *p = list_iterAt(&iter);
+        if (p)
+            assert(*p == elem);
+    }
+    assert(i == 100);
+
+    // 删除首部与尾部元素后从头插入。
+    list_iterBegin(list, &iter);
+    assert(!list_iterErase(&iter, &elem) && elem == -1);
+    for (i = 0; i < 98; i++)
+        assert(!list_iterNext(&iter));
+    assert(!list_iterErase(&iter, &elem) && elem == 990);
+    assert(list_iterEnd(&iter) && list_len(list) == 98);
+    elem = 1000;
+    assert(!list_iterInsertBefore(&iter, &elem));
+    assert(!list_rpop(list, &elem) && elem == 1000);
+    list_iterBegin(list, &iter);
+    elem = 7;
+    assert(!list_iterInsertBefore(&iter, &elem));
+    assert(!list_lpop(list, &elem) && elem == 7);
+    assert(!list_get(list, 0, &elem) && elem == 10);
+    assert(!list_get(list, 97, &elem) && elem == -99);
+
+    for (list_iterBegin(list, &iter); !list_iterEnd(&iter);)
+        assert(!list_iterErase(&iter, NULL));
+    assert(!list_len(list));
+    list_free(list);
 }
 
 static int intCmp(const void *o1, const void *o2) {
@@ -122,6 +662,10 @@ static int intCmp(const void *o1, const void *o2) {
     return o1 > o2 ? 1 : -1;
 }
 
+static void collectVisitor(void *p) {
+    collected[collectedLen++] = *(int *) p;
+}
+
 static void intVisitor(void *p) {
     int i = *(int *) p;
     assert(i > 0);
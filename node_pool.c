@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2023 ivfzhou
+ * clib is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+
+#include "node_pool.h"
+
+// 每块内存默认切分的节点数。
+const static size_t DefaultNodesPerSlab = 256;
+
+extern void *pointerAdd(void *p1, size_t delta);
+
+NodePool *nodePool_alloc(size_t nodesPerSlab) {
+    NodePool *pool = malloc(sizeof(NodePool));
+    pool->nodeSize = 0;
+    pool->nodesPerSlab = nodesPerSlab ? nodesPerSlab : DefaultNodesPerSlab;
+    pool->slabUsed = pool->nodesPerSlab;
+    pool->slabs = NULL;
+    pool->freeNodes = NULL;
+    return pool;
+}
+
+void nodePool_free(NodePool *pool) {
+    nodePool_reset(pool);
+    free(pool);
+}
+
+int nodePool_bind(NodePool *pool, size_t nodeSize) {
+    // 节点须能存放空闲链表指针，并按最大对齐要求排列。
+    if (nodeSize < sizeof(void *))
+        nodeSize = sizeof(void *);
+    nodeSize = (nodeSize + _Alignof(max_align_t) - 1) / _Alignof(max_align_t) * _Alignof(max_align_t);
+    if (pool->nodeSize && pool->nodeSize != nodeSize)
+        return 1;
+    pool->nodeSize = nodeSize;
+    return 0;
+}
+
+void *nodePool_get(NodePool *pool) {
+    if (pool->freeNodes) {
+        void *node = pool->freeNodes;
+        pool->freeNodes = *(void **) node;
+        return node;
+    }
+    if (pool->slabUsed == pool->nodesPerSlab) {
+        NodePoolSlab *slab = malloc(sizeof(NodePoolSlab) + pool->nodeSize * pool->nodesPerSlab);
+        if (slab == NULL)
+            return NULL;
+        slab->next = pool->slabs;
+        pool->slabs = slab;
+        pool->slabUsed = 0;
+    }
+    return pointerAdd(pool->slabs->nodes, pool->nodeSize * pool->slabUsed++);
+}
+
+void nodePool_put(NodePool *pool, void *node) {
+    *(void **) node = pool->freeNodes;
+    pool->freeNodes = node;
+}
+
+void nodePool_reset(NodePool *pool) {
+    NodePoolSlab *slab = pool->slabs;
+    while (slab) {
+        NodePoolSlab *next = slab->next;
+        free(slab);
+        slab = next;
+    }
+    pool->slabs = NULL;
+    pool->freeNodes = NULL;
+    pool->slabUsed = pool->nodesPerSlab;
+}
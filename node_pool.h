@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2023 ivfzhou
+ * clib is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+
+#ifndef CLIB_NODE_POOL_H
+#define CLIB_NODE_POOL_H
+
+#include <stddef.h>
+#include <stdlib.h>
+
+// 节点池内存块。
+typedef struct NodePoolSlab {
+    struct NodePoolSlab *next;
+    _Alignas(max_align_t) unsigned char nodes[];
+} NodePoolSlab;
+
+// 节点池，从大块内存中切分出等长节点，回收的节点经空闲链表复用。
+typedef struct {
+    size_t nodeSize;     // 每个节点占用的字节数，首次绑定时确定
+    size_t nodesPerSlab; // 每块内存切分的节点数
+    size_t slabUsed;     // 当前内存块已切分的节点数
+    NodePoolSlab *slabs; // 内存块链表，首个为当前内存块
+    void *freeNodes;     // 空闲节点链表，节点首部存放下一个空闲节点
+} NodePool;
+
+// 新建节点池。
+// nodesPerSlab：每块内存切分的节点数，0表示默认值。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+NodePool *nodePool_alloc(size_t nodesPerSlab);
+
+// 销毁节点池，释放全部内存块。
+// pool：节点池。
+// 时间复杂度：O(n)
+// 空间复杂度：O(1)
+void nodePool_free(NodePool *pool);
+
+// 绑定节点大小，同一节点池只能服务节点大小相同的线性表。
+// pool：节点池。
+// nodeSize：节点占用的字节数。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+// 返回1: 节点池已绑定其它节点大小。
+int nodePool_bind(NodePool *pool, size_t nodeSize);
+
+// 从节点池取一个节点。
+// pool：节点池。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+// 返回NULL: 内存不足。
+void *nodePool_get(NodePool *pool);
+
+// 归还节点到节点池。
+// pool：节点池。
+// node：由nodePool_get取得的节点。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+void nodePool_put(NodePool *pool, void *node);
+
+// 释放节点池全部内存块，之前取得的节点全部失效。
+// pool：节点池。
+// 时间复杂度：O(n)
+// 空间复杂度：O(1)
+void nodePool_reset(NodePool *pool);
+
+#endif // CLIB_NODE_POOL_H
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2023 ivfzhou
+ * clib is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "node_pool.c"
+
+int main(void) {
+    NodePool *pool = nodePool_alloc(4);
+    assert(pool);
+    assert(!nodePool_bind(pool, 1));
+    assert(pool->nodeSize == _Alignof(max_align_t));
+    assert(!nodePool_bind(pool, 2));
+    assert(nodePool_bind(pool, _Alignof(max_align_t) + 1));
+
+    // 一块内存切分完毕后才申请新的内存块。
+    void *nodes[10];
+    for (int i = 0; i < 10; i++) {
+        nodes[i] = nodePool_get(pool);
+        assert(nodes[i]);
+        assert((size_t) nodes[i] % _Alignof(max_align_t) == 0);
+        memset(nodes[i], i, pool->nodeSize);
+    }
+    size_t slabs = 0;
+    for (NodePoolSlab *slab = pool->slabs; slab; slab = slab->next)
+        slabs++;
+    assert(slabs == 3);
+    for (int i = 0; i < 10; i++)
+        for (int j = i + 1; j < 10; j++)
+            assert(nodes[i] != nodes[j]);
+
+    // 归还的节点后进先出地被复用。
+    nodePool_put(pool, nodes[3]);
+    nodePool_put(pool, nodes[7]);
+    assert(nodePool_get(pool) == nodes[7]);
+    assert(nodePool_get(pool) == nodes[3]);
+    assert(!pool->freeNodes);
+
+    nodePool_reset(pool);
+    assert(!pool->slabs && !pool->freeNodes);
+    assert(nodePool_get(pool));
+
+    nodePool_free(pool);
+}
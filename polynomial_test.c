@@ -10,6 +10,7 @@
  * See the Mulan PSL v2 for more details.
  */
 
+#include <assert.h>
 #include <stdarg.h>
 #include <stdio.h>
 
@@ -26,6 +27,10 @@ typedef List Polynomial;
 
 static void add(Polynomial *poly, Item *item);
 
+static int exponentCmp(const void *i1, const void *i2, void *ctx);
+
+static void assertItems(const Polynomial *poly, int num, const Item *items);
+
 // 新建多项式。
 Polynomial *polynomial_new(int num, ...) {
     va_list args;
@@ -51,19 +56,13 @@ void polynomial_free(Polynomial *poly) {
 Polynomial *polynomial_add(const Polynomial *x, const Polynomial *y) {
     Polynomial *newPolynomial = list_alloc(sizeof(Item), ListImplType_Array);
 
-    size_t len = list_len(x);
-    for (int i = 0; i < len; i++) {
-        Item item;
-        list_get(x, i, &item);
+    ListIter iter;
+    Item item;
+    for (list_iterBegin(x, &iter); !list_iterGet(&iter, &item); list_iterNext(&iter))
         add(newPolynomial, &item);
-    }
 
-    len = list_len(y);
-    for (int i = 0; i < len; i++) {
-        Item item;
-        list_get(y, i, &item);
+    for (list_iterBegin(y, &iter); !list_iterGet(&iter, &item); list_iterNext(&iter))
         add(newPolynomial, &item);
-    }
 
     return newPolynomial;
 }
@@ -72,16 +71,12 @@ Polynomial *polynomial_add(const Polynomial *x, const Polynomial *y) {
 Polynomial *polynomial_subtract(const Polynomial *x, const Polynomial *y) {
     Polynomial *newPolynomial = list_alloc(sizeof(Item), ListImplType_Array);
 
-    size_t len = list_len(x);
+    ListIter iter;
     Item item;
-    for (int i = 0; i < len; i++) {
-        list_get(x, i, &item);
+    for (list_iterBegin(x, &iter); !list_iterGet(&iter, &item); list_iterNext(&iter))
         add(newPolynomial, &item);
-    }
 
-    len = list_len(y);
-    for (int i = 0; i < len; i++) {
-        list_get(y, i, &item);
+    for (list_iterBegin(y, &iter); !list_iterGet(&iter, &item); list_iterNext(&iter)) {
         item.coefficient = -item.coefficient;
         add(newPolynomial, &item);
     }
@@ -93,17 +88,14 @@ Polynomial *polynomial_subtract(const Polynomial *x, const Polynomial *y) {
 Polynomial *polynomial_multiply(const Polynomial *x, const Polynomial *y) {
     Polynomial *newPolynomial = list_alloc(sizeof(Item), ListImplType_Array);
 
-    size_t lenX = list_len(x);
-    size_t lenY = list_len(y);
+    ListIter iterX, iterY;
     Item itemX;
     Item itemY;
-    for (int i = 0; i < lenX; i++) {
-        list_get(x, i, &itemX);
-        for (int j = 0; j < lenY; j++) {
-            list_get(y, j, &itemY);
+    for (list_iterBegin(x, &iterX); !list_iterGet(&iterX, &itemX); list_iterNext(&iterX)) {
+        for (list_iterBegin(y, &iterY); !list_iterGet(&iterY, &itemY); list_iterNext(&iterY)) {
             Item newItem = {
                     .coefficient = itemX.coefficient * itemY.coefficient,
-                    .exponent = itemX.exponent * itemY.exponent,
+                    .exponent = itemX.exponent + itemY.exponent,
             };
             add(newPolynomial, &newItem);
         }
@@ -114,11 +106,10 @@ Polynomial *polynomial_multiply(const Polynomial *x, const Polynomial *y) {
 
 // 打印多项式。
 void polynomial_fprint(const Polynomial *poly, FILE *f) {
-    size_t len = list_len(poly);
-
-    for (int i = 0; i < len; i++) {
-        Item item;
-        list_get(poly, i, &item);
+    ListIter iter;
+    Item item;
+    for (list_iterBegin(poly, &iter); !list_iterGet(&iter, &item); list_iterNext(&iter)) {
+        size_t i = iter.cursor.index;
 
         if (item.coefficient > 0) {
             if (i != 0)
@@ -179,33 +170,25 @@ void polynomial_fprint(const Polynomial *poly, FILE *f) {
     puts("");
 }
 
+// 按指数升序合并项，二分查找同指数的项。
 static void add(Polynomial *poly, Item *item) {
     if (item->coefficient == 0.0)
         return;
-    size_t len = list_len(poly);
-
-    Item tmp;
-    for (int i = 0; i < len; i++) {
-        list_get(poly, i, &tmp);
-        if (tmp.exponent == item->exponent) {
-            long double coefficient = tmp.coefficient + item->coefficient;
-            if (coefficient != 0.0) {
-                Item newItem = {
-                        .coefficient = coefficient,
-                        .exponent = tmp.exponent,
-                };
-                list_set(poly, i, &newItem);
-            } else {
-                list_del(poly, i);
-            }
-            return;
-        } else if (tmp.exponent > item->exponent) {
-            list_insert(poly, i, item);
-            return;
-        }
+
+    size_t index;
+    if (list_binarySearch(poly, exponentCmp, item, NULL, &index)) {
+        list_insert(poly, index, item);
+        return;
     }
+    Item *same = list_at(poly, index);
+    same->coefficient += item->coefficient;
+    if (same->coefficient == 0.0)
+        list_del(poly, index);
+}
 
-    list_rpush(poly, item);
+static int exponentCmp(const void *i1, const void *i2, void *ctx) {
+    int e1 = ((const Item *) i1)->exponent, e2 = ((const Item *) i2)->exponent;
+    return (e1 > e2) - (e1 < e2);
 }
 
 int main() {
@@ -238,12 +221,15 @@ int main() {
 
     Polynomial *poly1 = polynomial_add(poly, poly0);
     // polynomial_fprint(poly1, stdout);
+    assertItems(poly1, 2, (Item[]) {{8, -3}, {4, 1}});
 
     Polynomial *poly2 = polynomial_multiply(poly, poly0);
     // polynomial_fprint(poly2, stdout);
+    assertItems(poly2, 4, (Item[]) {{16, -6}, {16, -2}, {4, 2}, {-9, 4}});
 
     Polynomial *poly3 = polynomial_subtract(poly, poly0);
     // polynomial_fprint(poly3, stdout);
+    assertItems(poly3, 1, (Item[]) {{6, 2}});
 
     polynomial_free(poly);
     polynomial_free(poly0);
@@ -251,3 +237,15 @@ int main() {
     polynomial_free(poly2);
     polynomial_free(poly3);
 }
+
+// 校验多项式各项。
+static void assertItems(const Polynomial *poly, int num, const Item *items) {
+    assert(list_len(poly) == num);
+    ListIter iter;
+    Item item;
+    int i = 0;
+    for (list_iterBegin(poly, &iter); !list_iterGet(&iter, &item); list_iterNext(&iter), i++) {
+        assert(item.exponent == items[i].exponent);
+        assert(item.coefficient == items[i].coefficient);
+    }
+}
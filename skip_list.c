@@ -0,0 +1,348 @@
+/*
+ * Copyright (c) 2023 ivfzhou
+ * clib is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+
+#include <string.h>
+
+#include "skip_list.h"
+
+extern void memorySwap(void *p0, void *p1, size_t size);
+
+// 新建拥有level层的节点。
+static SkipListNode *newNode(const SkipList *list, size_t level, const void *elem);
+
+// 获取节点。
+static SkipListNode *getNode(const SkipList *list, size_t index);
+
+// 找到各层中位于index之前的最后一个节点及其排名。
+static void findPrev(const SkipList *list, size_t index, SkipListNode **update, size_t *rank);
+
+// 取出一个节点。
+static SkipListNode *popNode(SkipList *list, size_t index);
+
+// 随机层数。
+static size_t randomLevel(SkipList *list);
+
+static void freeNodes(SkipList *list);
+
+SkipList *skipList_alloc(size_t elemSize) {
+    SkipList *list = malloc(sizeof(SkipList));
+    list->elemSize = elemSize;
+    list->length = 0;
+    list->level = 1;
+    list->seed = 88172645463325252ull;
+    list->head = newNode(list, SKIP_LIST_MAX_LEVEL, NULL);
+    if (list->head == NULL) {
+        free(list);
+        return NULL;
+    }
+    for (size_t i = 0; i < SKIP_LIST_MAX_LEVEL; i++) {
+        list->head->links[i].next = NULL;
+        list->head->links[i].span = 1;
+    }
+    return list;
+}
+
+void skipList_free(SkipList *list) {
+    freeNodes(list);
+    free(list->head);
+    list->head = NULL;
+    list->length = list->elemSize = 0;
+    free(list);
+}
+
+size_t skipList_len(const SkipList *list) {
+    return list->length;
+}
+
+int skipList_get(const SkipList *list, size_t index, void *elem) {
+    if (index >= list->length)
+        return 1;
+    memcpy(elem, getNode(list, index)->elem, list->elemSize);
+    return 0;
+}
+
+int skipList_insert(SkipList *list, size_t index, const void *elem) {
+    if (index > list->length)
+        return 1;
+    size_t level = randomLevel(list);
+    SkipListNode *node = newNode(list, level, elem);
+    if (node == NULL)
+        return 2;
+
+    SkipListNode *update[SKIP_LIST_MAX_LEVEL];
+    size_t rank[SKIP_LIST_MAX_LEVEL];
+    findPrev(list, index, update, rank);
+    // 新增的层上头节点直接跨到尾部之后。
+    for (size_t i = list->level; i < level; i++) {
+        update[i] = list->head;
+        rank[i] = 0;
+        list->head->links[i].next = NULL;
+        list->head->links[i].span = list->length + 1;
+    }
+    if (level > list->level)
+        list->level = level;
+
+    for (size_t i = 0; i < level; i++) {
+        SkipListLink *link = update[i]->links + i;
+        node->links[i].next = link->next;
+        node->links[i].span = link->span - (index - rank[i]);
+        link->next = node;
+        link->span = index - rank[i] + 1;
+    }
+    for (size_t i = level; i < list->level; i++)
+        update[i]->links[i].span++;
+
+    list->length++;
+    return 0;
+}
+
+int skipList_del(SkipList *list, size_t index) {
+    if (index >= list->length)
+        return 1;
+    free(popNode(list, index));
+    return 0;
+}
+
+int skipList_locate(const SkipList *list, ListElemComparer cmp, const void *elem, size_t *index) {
+    SkipListNode *node = list->head->links[0].next;
+    for (size_t i = 0; i < list->length; i++) {
+        if (!cmp(node->elem, elem)) {
+            *index = i;
+            return 0;
+        }
+        node = node->links[0].next;
+    }
+    return 1;
+}
+
+int skipList_travel(const SkipList *list, ListElemVisitor visit) {
+    for (SkipListNode *node = list->head->links[0].next; node; node = node->links[0].next)
+        visit(node->elem);
+    return 0;
+}
+
+int skipList_locateCtx(const SkipList *list, ListElemCtxComparer cmp, const void *elem, void *ctx, size_t *index) {
+    SkipListNode *node = list->head->links[0].next;
+    for (size_t i = 0; i < list->length; i++) {
+        if (!cmp(node->elem, elem, ctx)) {
+            *index = i;
+            return 0;
+        }
+        node = node->links[0].next;
+    }
+    return 1;
+}
+
+int skipList_travelCtx(const SkipList *list, ListElemCtxVisitor visit, void *ctx) {
+    for (SkipListNode *node = list->head->links[0].next; node; node = node->links[0].next) {
+        int res = visit(node->elem, ctx);
+        if (res)
+            return res;
+    }
+    return 0;
+}
+
+int skipList_clear(SkipList *list) {
+    freeNodes(list);
+    for (size_t i = 0; i < SKIP_LIST_MAX_LEVEL; i++) {
+        list->head->links[i].next = NULL;
+        list->head->links[i].span = 1;
+    }
+    list->level = 1;
+    list->length = 0;
+    return 0;
+}
+
+int skipList_rpop(SkipList *list, void *elem) {
+    return skipList_getDel(list, list->length - 1, elem);
+}
+
+int skipList_lpush(SkipList *list, const void *elem) {
+    return skipList_insert(list, 0, elem);
+}
+
+int skipList_rpush(SkipList *list, const void *elem) {
+    return skipList_insert(list, list->length, elem);
+}
+
+int skipList_lpop(SkipList *list, void *elem) {
+    return skipList_getDel(list, 0, elem);
+}
+
+int skipList_set(SkipList *list, size_t index, const void *elem) {
+    if (index >= list->length)
+        return 1;
+    memcpy(getNode(list, index)->elem, elem, list->elemSize);
+    return 0;
+}
+
+int skipList_getDel(SkipList *list, size_t index, void *elem) {
+    if (index >= list->length)
+        return 1;
+    SkipListNode *node = popNode(list, index);
+    memcpy(elem, node->elem, list->elemSize);
+    free(node);
+    return 0;
+}
+
+int skipList_getSet(SkipList *list, size_t index, void *elem) {
+    if (index >= list->length)
+        return 1;
+    memorySwap(getNode(list, index)->elem, elem, list->elemSize);
+    return 0;
+}
+
+void *skipList_at(const SkipList *list, size_t index) {
+    if (index >= list->length)
+        return NULL;
+    return getNode(list, index)->elem;
+}
+
+void skipList_iterBegin(const SkipList *list, ListCursor *cursor) {
+    cursor->index = 0;
+    cursor->node = list->head->links[0].next;
+    cursor->prev = NULL;
+}
+
+int skipList_iterNext(const SkipList *list, ListCursor *cursor) {
+    if (cursor->index >= list->length)
+        return 1;
+    cursor->index++;
+    cursor->node = ((SkipListNode *) cursor->node)->links[0].next;
+    return 0;
+}
+
+void *skipList_iterAt(const SkipList *list, const ListCursor *cursor) {
+    if (cursor->index >= list->length)
+        return NULL;
+    return ((SkipListNode *) cursor->node)->elem;
+}
+
+// 插入需要各层的前驱，仍按位置查找；迭代位置上的节点不变。
+int skipList_iterInsertBefore(SkipList *list, ListCursor *cursor, const void *elem) {
+    int res = skipList_insert(list, cursor->index < list->length ? cursor->index : list->length, elem);
+    if (!res)
+        cursor->index++;
+    return res;
+}
+
+int skipList_iterErase(SkipList *list, ListCursor *cursor, void *elem) {
+    if (cursor->index >= list->length)
+        return 1;
+    SkipListNode *node = popNode(list, cursor->index);
+    cursor->node = node->links[0].next;
+    if (elem != NULL)
+        memcpy(elem, node->elem, list->elemSize);
+    free(node);
+    return 0;
+}
+
+int skipList_fprint(const SkipList *list, FILE *f, ListElemToString str, size_t sizeOfElem) {
+    fprintf(f, "[");
+    char s[sizeOfElem + 1];
+    for (SkipListNode *node = list->head->links[0].next; node; node = node->links[0].next) {
+        size_t len = str(node->elem, s);
+        s[len] = '\0';
+        fprintf(f, node == list->head->links[0].next ? "%s" : ", %s", s);
+    }
+    fprintf(f, "]");
+    fflush(f);
+    return 0;
+}
+
+// 元素放在各层后继之后，按max_align_t对齐。
+static SkipListNode *newNode(const SkipList *list, size_t level, const void *elem) {
+    size_t align = _Alignof(max_align_t);
+    size_t offset = (sizeof(SkipListNode) + level * sizeof(SkipListLink) + align - 1) / align * align;
+    SkipListNode *node = malloc(offset + (elem ? list->elemSize : 0));
+    if (node == NULL)
+        return NULL;
+    node->elem = elem ? (unsigned char *) node + offset : NULL;
+    if (elem)
+        memcpy(node->elem, elem, list->elemSize);
+    return node;
+}
+
+// 从最高层向下，每层尽量前进而不越过目标，排名为元素位置加一。
+static SkipListNode *getNode(const SkipList *list, size_t index) {
+    SkipListNode *node = list->head;
+    size_t rank = 0;
+    for (size_t i = list->level; i-- > 0;) {
+        while (node->links[i].next && rank + node->links[i].span <= index + 1) {
+            rank += node->links[i].span;
+            node = node->links[i].next;
+        }
+        if (rank == index + 1)
+            break;
+    }
+    return node;
+}
+
+static void findPrev(const SkipList *list, size_t index, SkipListNode **update, size_t *rank) {
+    SkipListNode *node = list->head;
+    size_t pos = 0;
+    update[0] = node; // 第0层在所有路径上都有值
+    rank[0] = 0;
+    for (size_t i = list->level; i-- > 0;) {
+        while (node->links[i].next && pos + node->links[i].span <= index) {
+            pos += node->links[i].span;
+            node = node->links[i].next;
+        }
+        update[i] = node;
+        rank[i] = pos;
+    }
+}
+
+// 经过被删节点的层合并两段跨度，其余层跨度减一；最高层空了就降层。
+static SkipListNode *popNode(SkipList *list, size_t index) {
+    SkipListNode *update[SKIP_LIST_MAX_LEVEL];
+    size_t rank[SKIP_LIST_MAX_LEVEL];
+    findPrev(list, index, update, rank);
+    SkipListNode *node = update[0]->links[0].next;
+    for (size_t i = 0; i < list->level; i++) {
+        SkipListLink *link = update[i]->links + i;
+        if (link->next == node) {
+            link->span += node->links[i].span - 1;
+            link->next = node->links[i].next;
+        } else {
+            link->span--;
+        }
+    }
+    while (list->level > 1 && !list->head->links[list->level - 1].next)
+        list->level--;
+    list->length--;
+    return node;
+}
+
+// xorshift64生成随机数，每两位为0则升一层，即升层概率为四分之一。
+static size_t randomLevel(SkipList *list) {
+    unsigned long long x = list->seed;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    list->seed = x;
+    size_t level = 1;
+    while (level < SKIP_LIST_MAX_LEVEL && !(x & 3)) {
+        level++;
+        x >>= 2;
+    }
+    return level;
+}
+
+static void freeNodes(SkipList *list) {
+    SkipListNode *node = list->head->links[0].next;
+    while (node) {
+        SkipListNode *next = node->links[0].next;
+        free(node);
+        node = next;
+    }
+}
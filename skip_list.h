@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2023 ivfzhou
+ * clib is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+
+#ifndef CLIB_SKIP_LIST_H
+#define CLIB_SKIP_LIST_H
+
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "list.h"
+
+// 跳表最大层数，每层节点约为下一层的四分之一。
+#define SKIP_LIST_MAX_LEVEL 32
+
+struct SkipListNode;
+
+// 跳表节点某一层的后继，span为沿第0层从本节点走到后继的步数。
+typedef struct {
+    struct SkipListNode *next;
+    size_t span;
+} SkipListLink;
+
+// 跳表节点，元素值存放在各层后继之后，与节点在同一块内存中。
+typedef struct SkipListNode {
+    unsigned char *elem;
+    SkipListLink links[];
+} SkipListNode;
+
+// 可按位置访问的跳表线性表，各层后继记录跨度，按位置查找、插入、删除期望为O(log n)，顺序访问沿第0层前进。
+typedef struct {
+    size_t length, elemSize;
+    size_t level;            // 当前使用的层数
+    SkipListNode *head;      // 头节点，拥有全部层数，不存放元素
+    unsigned long long seed; // 随机层数的种子
+} SkipList;
+
+// 新建跳表。
+// elemSize：每个元素占用的字节大小。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+SkipList *skipList_alloc(size_t elemSize);
+
+// 销毁跳表。
+// list：跳表。
+// 时间复杂度：O(n)
+// 空间复杂度：O(1)
+void skipList_free(SkipList *list);
+
+// 获取跳表中元素个数。
+// list：跳表。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+size_t skipList_len(const SkipList *list);
+
+// 获取跳表中某个位置的元素。
+// list：跳表。
+// index：元素所在位置。
+// elem：元素值塞入elem中。
+// 时间复杂度：期望O(log n)
+// 空间复杂度：O(1)
+// 返回1: 越界。
+int skipList_get(const SkipList *list, size_t index, void *elem);
+
+// 向跳表中插入元素。
+// list：跳表。
+// index：元素插入位置。
+// elem：被插入的元素。
+// 时间复杂度：期望O(log n)
+// 空间复杂度：O(1)
+// 返回1: 越界。
+// 返回2: 内存不足。
+int skipList_insert(SkipList *list, size_t index, const void *elem);
+
+// 删除跳表中某个位置的元素。
+// list：跳表。
+// index：元素所在位置。
+// 时间复杂度：期望O(log n)
+// 空间复杂度：O(1)
+// 返回1: 越界。
+int skipList_del(SkipList *list, size_t index);
+
+// 寻找元素在跳表中的位置。
+// list：跳表。
+// cmp：元素比较函数。
+// elem：要寻找的元素。
+// index：元素位置塞入index中。
+// 时间复杂度：O(n)
+// 空间复杂度：O(1)
+// 返回1: 未找到。
+int skipList_locate(const SkipList *list, ListElemComparer cmp, const void *elem, size_t *index);
+
+// 遍历跳表。
+// list：跳表。
+// visit：遍历函数。
+// 时间复杂度：O(n)
+// 空间复杂度：O(1)
+int skipList_travel(const SkipList *list, ListElemVisitor visit);
+
+// 带上下文查找元素在跳表中的位置。
+// list：跳表。
+// cmp：元素比较函数。
+// elem：要寻找的元素。
+// ctx：传给比较函数的上下文。
+// index：元素位置塞入index中。
+// 时间复杂度：O(n)
+// 空间复杂度：O(1)
+// 返回1: 未找到。
+int skipList_locateCtx(const SkipList *list, ListElemCtxComparer cmp, const void *elem, void *ctx, size_t *index);
+
+// 带上下文遍历跳表，遍历函数返回非0时停止。
+// list：跳表。
+// visit：遍历函数。
+// ctx：传给遍历函数的上下文。
+// 时间复杂度：O(n)
+// 空间复杂度：O(1)
+// 返回visit的非0返回值: 遍历提前结束。
+int skipList_travelCtx(const SkipList *list, ListElemCtxVisitor visit, void *ctx);
+
+// 清空跳表。
+// list：跳表。
+// 时间复杂度：O(n)
+// 空间复杂度：O(1)
+int skipList_clear(SkipList *list);
+
+// 取出跳表最右边的元素。
+// list：跳表。
+// elem：元素值塞入elem中。
+// 时间复杂度：期望O(log n)
+// 空间复杂度：O(1)
+// 返回1: 越界。
+int skipList_rpop(SkipList *list, void *elem);
+
+// 向跳表最左边添加元素。
+// list：跳表。
+// elem：被添加的元素。
+// 时间复杂度：期望O(log n)
+// 空间复杂度：O(1)
+// 返回2: 内存不足。
+int skipList_lpush(SkipList *list, const void *elem);
+
+// 向跳表最右边添加元素。
+// list：跳表。
+// elem：被添加的元素。
+// 时间复杂度：期望O(log n)
+// 空间复杂度：O(1)
+// 返回2: 内存不足。
+int skipList_rpush(SkipList *list, const void *elem);
+
+// 取出跳表最左边的元素。
+// list：跳表。
+// elem：元素值塞入elem中。
+// 时间复杂度：期望O(log n)
+// 空间复杂度：O(1)
+// 返回1: 越界。
+int skipList_lpop(SkipList *list, void *elem);
+
+// 设置跳表中某个位置的元素。
+// list：跳表。
+// index：元素所在位置。
+// elem：被设置的元素。
+// 时间复杂度：期望O(log n)
+// 空间复杂度：O(1)
+// 返回1: 越界。
+int skipList_set(SkipList *list, size_t index, const void *elem);
+
+// 获取跳表中某个位置的元素然后删除之。
+// list：跳表。
+// index：元素所在位置。
+// elem：元素值塞入elem中。
+// 时间复杂度：期望O(log n)
+// 空间复杂度：O(1)
+// 返回1: 越界。
+int skipList_getDel(SkipList *list, size_t index, void *elem);
+
+// 获取跳表中某个位置的元素然后设置新值。
+// list：跳表。
+// index：元素所在位置。
+// elem：元素值设置进表中，然后旧值塞入elem中。
+// 时间复杂度：期望O(log n)
+// 空间复杂度：O(1)
+// 返回1: 越界。
+int skipList_getSet(SkipList *list, size_t index, void *elem);
+
+// 获取跳表中元素的存储地址，可原地读写元素，删除该元素后地址失效。
+// list：跳表。
+// index：元素所在位置。
+// 时间复杂度：期望O(log n)
+// 空间复杂度：O(1)
+// 返回NULL: 越界。
+void *skipList_at(const SkipList *list, size_t index);
+
+// 迭代位置置于跳表首个元素。
+// list：跳表。
+// cursor：将被设置为迭代位置。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+void skipList_iterBegin(const SkipList *list, ListCursor *cursor);
+
+// 迭代位置前进到下一个元素。
+// list：跳表。
+// cursor：迭代位置。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+// 返回1: 迭代已结束。
+int skipList_iterNext(const SkipList *list, ListCursor *cursor);
+
+// 获取迭代位置上元素的存储地址。
+// list：跳表。
+// cursor：迭代位置。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+// 返回NULL: 迭代已结束。
+void *skipList_iterAt(const SkipList *list, const ListCursor *cursor);
+
+// 在迭代位置上的元素前插入元素，迭代位置仍指向原元素；迭代已结束时追加到尾部。
+// list：跳表。
+// cursor：迭代位置。
+// elem：被插入的元素。
+// 时间复杂度：期望O(log n)
+// 空间复杂度：O(1)
+// 返回2: 内存不足。
+int skipList_iterInsertBefore(SkipList *list, ListCursor *cursor, const void *elem);
+
+// 删除迭代位置上的元素，迭代位置指向下一个元素。
+// list：跳表。
+// cursor：迭代位置。
+// elem：非NULL时将被设置为删除的元素值。
+// 时间复杂度：期望O(log n)
+// 空间复杂度：O(1)
+// 返回1: 迭代已结束。
+int skipList_iterErase(SkipList *list, ListCursor *cursor, void *elem);
+
+// 打印跳表中的元素。
+// list：跳表。
+// f：打印输出对象。
+// str：元素转字符串函数。
+// sizeOfElem：每个元素转字符串表示占用的最大字节数。
+// 时间复杂度：O(n)
+// 空间复杂度：O(1)
+int skipList_fprint(const SkipList *list, FILE *f, ListElemToString str, size_t sizeOfElem);
+
+#endif // CLIB_SKIP_LIST_H
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2023 ivfzhou
+ * clib is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "skip_list.c"
+
+#define TEST_LENGTH 50000
+
+static int intCmp(const void *o1, const void *o2);
+
+static void intVisitor(void *p);
+
+static void checkSpans(const SkipList *list);
+
+int main(void) {
+    SkipList *list = skipList_alloc(sizeof(int));
+    assert(list);
+
+    int elem = 2;
+    size_t index = 0;
+    assert(!skipList_insert(list, index, &elem));
+
+    elem = 1;
+    assert(!skipList_lpush(list, &elem));
+
+    elem = 3;
+    assert(!skipList_rpush(list, &elem));
+
+    assert(!skipList_travel(list, intVisitor));
+
+    size_t length = skipList_len(list);
+    assert(length == 3);
+
+    elem = 4;
+    assert(!skipList_set(list, index, &elem));
+
+    assert(!skipList_get(list, index, &elem));
+    assert(elem == 4);
+
+    elem = 3;
+    assert(!skipList_locate(list, intCmp, &elem, &index));
+    assert(index == 2);
+
+    elem = 4;
+    assert(!skipList_getSet(list, index, &elem));
+    assert(elem == 3);
+
+    assert(!skipList_getDel(list, index, &elem));
+    assert(elem == 4);
+
+    assert(!skipList_lpop(list, &elem));
+    assert(elem == 4);
+
+    assert(!skipList_rpop(list, &elem));
+    assert(elem == 2);
+
+    assert(skipList_lpop(list, &elem) == 1);
+    assert(skipList_rpop(list, &elem) == 1);
+    assert(skipList_insert(list, 1, &elem) == 1);
+
+    // 与数组对照随机插入删除，并检查各层跨度。
+    srand(time(NULL) + 100);
+    int *expect = malloc(sizeof(int) * TEST_LENGTH);
+    int res = 0;
+    for (int i = 0; i < TEST_LENGTH; i++) {
+        elem = i + 1;
+        length = skipList_len(list);
+        index = rand() % (length + 1u);
+        assert(!skipList_insert(list, index, &elem));
+        memmove(expect + index + 1, expect + index, (length - index) * sizeof(int));
+        expect[index] = elem;
+        assert(!skipList_get(list, index, &res));
+        assert(res == elem);
+    }
+    assert(list->level > 1);
+    checkSpans(list);
+    for (size_t i = 0; i < TEST_LENGTH; i++)
+        assert(*(int *) skipList_at(list, i) == expect[i]);
+    ListCursor cursor;
+    skipList_iterBegin(list, &cursor);
+    for (size_t i = 0; i < TEST_LENGTH; i++, skipList_iterNext(list, &cursor))
+        assert(*(int *) skipList_iterAt(list, &cursor) == expect[i]);
+    assert(!skipList_iterAt(list, &cursor));
+    for (int i = 0; i < TEST_LENGTH - 100; i++) {
+        length = skipList_len(list);
+        index = rand() % length;
+        assert(!skipList_getDel(list, index, &res));
+        assert(res == expect[index]);
+        memmove(expect + index, expect + index + 1, (length - index - 1) * sizeof(int));
+    }
+    checkSpans(list);
+
+    // 迭代中删除与插入。
+    skipList_iterBegin(list, &cursor);
+    for (size_t i = 0; i < 100; i++) {
+        if (i % 2) {
+            assert(!skipList_iterErase(list, &cursor, &res));
+            assert(res == expect[i]);
+        } else {
+            elem = -expect[i];
+            assert(!skipList_iterInsertBefore(list, &cursor, &elem));
+            assert(!skipList_iterNext(list, &cursor));
+        }
+    }
+    assert(!skipList_iterAt(list, &cursor));
+    assert(skipList_iterErase(list, &cursor, NULL) == 1);
+    assert(skipList_len(list) == 100);
+    for (size_t i = 0; i < 100; i++)
+        assert(*(int *) skipList_at(list, i) == (i % 2 ? expect[i - 1] : -expect[i]));
+    checkSpans(list);
+
+    assert(!skipList_clear(list));
+    assert(!skipList_len(list) && list->level == 1);
+    for (int i = 0; i < 1000; i++)
+        assert(!skipList_rpush(list, &i));
+    for (int i = 0; i < 1000; i++)
+        assert(!skipList_lpop(list, &res) && res == i);
+    assert(list->level == 1);
+
+    skipList_free(list);
+    free(expect);
+}
+
+// 每层后继的跨度等于沿第0层走到它的步数，尾部跨度等于到末尾之后的步数。
+static void checkSpans(const SkipList *list) {
+    for (size_t i = 0; i < list->level; i++) {
+        SkipListNode *node = list->head;
+        size_t rank = 0;
+        while (node) {
+            SkipListLink link = node->links[i];
+            SkipListNode *walk = node;
+            for (size_t s = 0; s < link.span && walk; s++)
+                walk = walk->links[0].next;
+            assert(walk == link.next);
+            if (!link.next)
+                assert(rank + link.span == list->length + 1);
+            rank += link.span;
+            node = link.next;
+        }
+    }
+}
+
+static int intCmp(const void *o1, const void *o2) {
+    int *n1 = (int *) o1;
+    int *n2 = (int *) o2;
+    if (*n1 == *n2)
+        return 0;
+    return o1 > o2 ? 1 : -1;
+}
+
+static void intVisitor(void *p) {
+    static int prev = 1;
+    int i = *(int *) p;
+    assert(i == prev);
+    prev = i + 1;
+}
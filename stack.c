@@ -58,5 +58,5 @@ int stack_peekTop(const Stack *s, void *elem) {
 }
 
 _Bool stack_isFull(const Stack *s) {
-    return pointerDiff(s->top, s->bottom) >= s->length;
+    return pointerDiff(s->top, s->bottom) >= s->length * s->sizeOfElem;
 }
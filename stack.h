@@ -13,6 +13,7 @@
 #ifndef CLIB_STACK_H
 #define CLIB_STACK_H
 
+#include <signal.h>
 #include <stdlib.h>
 
 // 栈。
@@ -68,4 +69,51 @@ int stack_peekTop(const Stack *s, void *elem);
 // 空间复杂度：O(1)
 _Bool stack_isFull(const Stack *s);
 
+// 生成元素类型为T的栈类型Name及其static inline操作函数，元素大小是编译期常量，入栈出栈直接赋值而不调用memcpy。
+// 函数名为Name_加上同名stack_*函数的名字，参数相同，只是元素指针为T *，alloc无需元素大小。
+// 同时定义元素类型Name_Elem，使用时以分号结尾，例如：CLIB_STACK_DEFINE(IntStack, int);
+#define CLIB_STACK_DEFINE(Name, T)                                                                                   \
+    typedef struct {                                                                                                 \
+        T *bottom, *top;                                                                                             \
+        size_t length;                                                                                               \
+    } Name;                                                                                                          \
+                                                                                                                     \
+    static inline _Bool Name##_isEmpty(const Name *s) {                                                              \
+        return s->bottom == s->top;                                                                                  \
+    }                                                                                                                \
+                                                                                                                     \
+    static inline _Bool Name##_isFull(const Name *s) {                                                               \
+        return (size_t) (s->top - s->bottom) >= s->length;                                                           \
+    }                                                                                                                \
+                                                                                                                     \
+    static inline void Name##_push(Name *s, const T *elem) {                                                         \
+        if (Name##_isFull(s)) raise(SIGABRT);                                                                        \
+        *s->top++ = *elem;                                                                                           \
+    }                                                                                                                \
+                                                                                                                     \
+    static inline void Name##_pop(Name *s, T *elem) {                                                                \
+        if (Name##_isEmpty(s)) raise(SIGABRT);                                                                       \
+        *elem = *--s->top;                                                                                           \
+    }                                                                                                                \
+                                                                                                                     \
+    static inline int Name##_peekTop(const Name *s, T *elem) {                                                       \
+        if (Name##_isEmpty(s)) return 1;                                                                             \
+        *elem = s->top[-1];                                                                                          \
+        return 0;                                                                                                    \
+    }                                                                                                                \
+                                                                                                                     \
+    static inline Name *Name##_alloc(size_t maxLength) {                                                             \
+        Name *s = malloc(sizeof(Name));                                                                              \
+        s->length = maxLength;                                                                                       \
+        s->bottom = s->top = malloc(maxLength * sizeof(T));                                                          \
+        return s;                                                                                                    \
+    }                                                                                                                \
+                                                                                                                     \
+    static inline void Name##_free(Name *s) {                                                                        \
+        free(s->bottom);                                                                                             \
+        free(s);                                                                                                     \
+    }                                                                                                                \
+                                                                                                                     \
+    typedef T Name##_Elem
+
 #endif //CLIB_STACK_H
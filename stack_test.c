@@ -15,6 +15,8 @@
 
 #include "stack.c"
 
+CLIB_STACK_DEFINE(IntStack, int);
+
 int main(void) {
     Stack *s = stack_alloc(sizeof(int), 10);
     assert(s);
@@ -30,5 +32,28 @@ int main(void) {
     stack_pop(s, &elem);
     assert(elem == 1);
     assert(stack_isEmpty(s));
+
+    // 容量按元素个数计。
+    for (elem = 0; elem < 10; elem++) {
+        assert(!stack_isFull(s));
+        stack_push(s, &elem);
+    }
+    assert(stack_isFull(s));
     stack_free(s);
+
+    // 类型化栈。
+    IntStack *typed = IntStack_alloc(10);
+    assert(IntStack_isEmpty(typed) && IntStack_peekTop(typed, &elem) == 1);
+    for (elem = 0; elem < 10; elem++) {
+        assert(!IntStack_isFull(typed));
+        IntStack_push(typed, &elem);
+    }
+    assert(IntStack_isFull(typed));
+    assert(!IntStack_peekTop(typed, &elem) && elem == 9);
+    for (int i = 9; i >= 0; i--) {
+        IntStack_pop(typed, &elem);
+        assert(elem == i);
+    }
+    assert(IntStack_isEmpty(typed));
+    IntStack_free(typed);
 }
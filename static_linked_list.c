@@ -10,34 +10,94 @@
  * See the Mulan PSL v2 for more details.
  */
 
+#include <stdint.h>
 #include <string.h>
 
 #include "static_linked_list.h"
 
-// 扩容阈值。
+// 扩容阈值，容量小于该值时成倍扩容。
 const static int ExpandThreshold = 256;
 
-// 扩容系数。
-const static long double ExpandFactor = 1.25L;
-
-// 缩容系数。
-const static long double ReduceFactor = 2L;
+// 默认容量策略。
+const static ListGrowthPolicy DefaultPolicy = {
+        .initCapacity = 0,
+        .growFactor = 1.25,
+        .shrinkFactor = 4,
+        .neverShrink = 0,
+};
+
+// 排序时比较两个索引项所指槽位上的元素。
+typedef struct {
+    const StaticLinkedList *list;
+    ListElemCtxComparer *cmp;
+    void *ctx;
+} SlotSortCtx;
 
 extern void *pointerAdd(void *p1, size_t delta);
 
+extern void memorySwap(void *p0, void *p1, size_t size);
+
+extern void memorySort(void *base, size_t count, size_t size, ListElemCtxComparer cmp, void *ctx);
+
+extern int memorySortStable(void *base, size_t count, size_t size, ListElemCtxComparer cmp, void *ctx);
+
 static _Bool needReduce(StaticLinkedList *list);
 
 static _Bool needExpand(StaticLinkedList *list);
 
-static int expandAndInsert(StaticLinkedList *list, size_t index, const void *elem);
+static int expand(StaticLinkedList *list);
+
+static void reduce(StaticLinkedList *list);
+
+static int resize(StaticLinkedList *list, size_t capacity);
+
+static int relayout(StaticLinkedList *list, size_t capacity);
+
+static void releaseSlot(StaticLinkedList *list, size_t index);
+
+static size_t getIndex(const StaticLinkedList *list, size_t i);
+
+static void setIndex(StaticLinkedList *list, size_t i, size_t slot);
+
+static void *elemAt(const StaticLinkedList *list, size_t i);
 
-static int reduceAndPop(StaticLinkedList *list, size_t index, void *elem);
+static void moveIndexes(StaticLinkedList *list, size_t to, size_t from, size_t count);
+
+static size_t maxCapacity(const StaticLinkedList *list);
+
+static int slotCmp(const void *i1, const void *i2, void *ctx);
 
 StaticLinkedList *staticLinkedList_alloc(size_t elemSize) {
+    return staticLinkedList_allocWithPolicy(elemSize, NULL);
+}
+
+StaticLinkedList *staticLinkedList_allocWithPolicy(size_t elemSize, const ListGrowthPolicy *policy) {
+    return staticLinkedList_allocWithIndexWidth(elemSize, policy, ListIndexWidth_Default);
+}
+
+StaticLinkedList *staticLinkedList_allocWithIndexWidth(size_t elemSize, const ListGrowthPolicy *policy,
+                                                       ListIndexWidth width) {
+    size_t indexSize;
+    switch (width) {
+        case ListIndexWidth_16:
+            indexSize = sizeof(uint16_t);
+            break;
+        case ListIndexWidth_Default:
+        case ListIndexWidth_32:
+            indexSize = sizeof(uint32_t);
+            break;
+        case ListIndexWidth_64:
+            indexSize = sizeof(uint64_t);
+            break;
+        default:
+            return NULL;
+    }
     StaticLinkedList *list = malloc(sizeof(StaticLinkedList));
+    list->indexSize = indexSize;
     list->elemSize = elemSize;
     list->indexes = list->elems = NULL;
     list->length = list->capacity = 0;
+    list->policy = policy ? *policy : DefaultPolicy;
     return list;
 }
 
@@ -56,7 +116,7 @@ size_t staticLinkedList_len(const StaticLinkedList *list) {
 int staticLinkedList_get(const StaticLinkedList *list, size_t index, void *elem) {
     if (index >= list->length)
         return 1;
-    memcpy(elem, pointerAdd(list->elems, list->indexes[index] * list->elemSize), list->elemSize);
+    memcpy(elem, elemAt(list, index), list->elemSize);
     return 0;
 }
 
@@ -65,16 +125,17 @@ int staticLinkedList_insert(StaticLinkedList *list, size_t index, const void *el
         return 1;
 
     // 扩容
-    if (needExpand(list))
-        return expandAndInsert(list, index, elem);
+    if (needExpand(list) && expand(list))
+        return 2;
 
-    // 新元素加入到尾部。
-    memcpy(pointerAdd(list->elems, list->length * list->elemSize), elem, list->elemSize);
+    // 从空闲槽位栈顶取一个槽位存放新元素。
+    size_t slot = getIndex(list, list->length);
+    memcpy(pointerAdd(list->elems, slot * list->elemSize), elem, list->elemSize);
 
     // 移动索引。
     if (list->length - index > 0)
-        memmove(list->indexes + index + 1, list->indexes + index, (list->length - index) * sizeof(unsigned));
-    list->indexes[index] = list->length;
+        moveIndexes(list, index + 1, index, list->length - index);
+    setIndex(list, index, slot);
 
     list->length++;
     return 0;
@@ -83,25 +144,15 @@ int staticLinkedList_insert(StaticLinkedList *list, size_t index, const void *el
 int staticLinkedList_del(StaticLinkedList *list, size_t index) {
     if (index >= list->length)
         return 1;
+    releaseSlot(list, index);
     if (needReduce(list))
-        return reduceAndPop(list, index, NULL);
-    unsigned elemIndex = list->indexes[index];
-    if (list->length - elemIndex > 1)
-        memmove(pointerAdd(list->elems, elemIndex * list->elemSize),
-                pointerAdd(list->elems, (elemIndex + 1) * list->elemSize),
-                (list->length - elemIndex - 1) * list->elemSize);
-    if (list->length - index > 1)
-        memmove(list->indexes + index, list->indexes + index + 1, sizeof(unsigned) * (list->length - index - 1));
-    list->length--;
-    for (int i = 0; i < list->length; i++)
-        if (list->indexes[i] > elemIndex)
-            list->indexes[i]--;
+        reduce(list);
     return 0;
 }
 
 int staticLinkedList_locate(const StaticLinkedList *list, ListElemComparer cmp, const void *elem, size_t *index) {
     for (size_t i = 0; i < list->length; i++) {
-        if (!cmp(pointerAdd(list->elems, list->indexes[i] * list->elemSize), elem)) {
+        if (!cmp(elemAt(list, i), elem)) {
             *index = (int) i;
             return 0;
         }
@@ -111,11 +162,30 @@ int staticLinkedList_locate(const StaticLinkedList *list, ListElemComparer cmp,
 
 int staticLinkedList_travel(const StaticLinkedList *list, ListElemVisitor visit) {
     for (size_t i = 0; i < list->length; i++)
-        visit(pointerAdd(list->elems, list->indexes[i] * list->elemSize));
+        visit(elemAt(list, i));
 
     return 0;
 }
 
+int staticLinkedList_locateCtx(const StaticLinkedList *list, ListElemCtxComparer cmp, const void *elem, void *ctx, size_t *index) {
+    for (size_t i = 0; i < list->length; i++) {
+        if (!cmp(elemAt(list, i), elem, ctx)) {
+            *index = i;
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int staticLinkedList_travelCtx(const StaticLinkedList *list, ListElemCtxVisitor visit, void *ctx) {
+    for (size_t i = 0; i < list->length; i++) {
+        int res = visit(elemAt(list, i), ctx);
+        if (res)
+            return res;
+    }
+    return 0;
+}
+
 int staticLinkedList_clear(StaticLinkedList *list) {
     free(list->elems);
     free(list->indexes);
@@ -143,49 +213,72 @@ int staticLinkedList_lpop(StaticLinkedList *list, void *elem) {
 int staticLinkedList_set(StaticLinkedList *list, size_t index, const void *elem) {
     if (index >= list->length)
         return 1;
-    memcpy(pointerAdd(list->elems, list->indexes[index] * list->elemSize), elem, list->elemSize);
+    memcpy(elemAt(list, index), elem, list->elemSize);
     return 0;
 }
 
 int staticLinkedList_getDel(StaticLinkedList *list, size_t index, void *elem) {
     if (index >= list->length)
         return 1;
+    memcpy(elem, elemAt(list, index), list->elemSize);
+    releaseSlot(list, index);
     if (needReduce(list))
-        return reduceAndPop(list, index, elem);
-    unsigned elemIndex = list->indexes[index];
-    memcpy(elem, pointerAdd(list->elems, elemIndex * list->elemSize), list->elemSize);
-    if (list->length - elemIndex > 1)
-        memmove(pointerAdd(list->elems, elemIndex * list->elemSize),
-                pointerAdd(list->elems, (elemIndex + 1) * list->elemSize),
-                (list->length - elemIndex - 1) * list->elemSize);
-    if (list->length - index > 1)
-        memmove(list->indexes + index, list->indexes + index + 1, sizeof(unsigned) * (list->length - index - 1));
-    list->length--;
-    for (size_t i = 0; i < list->length; i++)
-        if (list->indexes[i] > elemIndex)
-            list->indexes[i]--;
+        reduce(list);
     return 0;
 }
 
 int staticLinkedList_getSet(StaticLinkedList *list, size_t index, void *elem) {
-    void *tmp = malloc(list->elemSize);
-    memcpy(tmp, pointerAdd(list->elems, list->indexes[index] * list->elemSize), list->elemSize);
-    memcpy(pointerAdd(list->elems, list->indexes[index] * list->elemSize), elem, list->elemSize);
-    memcpy(elem, tmp, list->elemSize);
-    free(tmp);
+    if (index >= list->length)
+        return 1;
+    memorySwap(elemAt(list, index), elem, list->elemSize);
     return 0;
 }
 
+int staticLinkedList_reserve(StaticLinkedList *list, size_t capacity) {
+    if (capacity <= list->capacity)
+        return 0;
+    if (capacity > maxCapacity(list))
+        return 2;
+    return resize(list, capacity);
+}
+
+int staticLinkedList_shrinkToFit(StaticLinkedList *list) {
+    if (list->length < list->capacity)
+        return relayout(list, list->length);
+    return 0;
+}
+
+int staticLinkedList_compact(StaticLinkedList *list) {
+    return relayout(list, list->capacity);
+}
+
+void *staticLinkedList_at(const StaticLinkedList *list, size_t index) {
+    if (index >= list->length)
+        return NULL;
+    return elemAt(list, index);
+}
+
+int staticLinkedList_sort(StaticLinkedList *list, ListElemCtxComparer cmp, void *ctx) {
+    SlotSortCtx sortCtx = {list, cmp, ctx};
+    memorySort(list->indexes, list->length, list->indexSize, slotCmp, &sortCtx);
+    return 0;
+}
+
+int staticLinkedList_sortStable(StaticLinkedList *list, ListElemCtxComparer cmp, void *ctx) {
+    SlotSortCtx sortCtx = {list, cmp, ctx};
+    return memorySortStable(list->indexes, list->length, list->indexSize, slotCmp, &sortCtx);
+}
+
 int staticLinkedList_fprint(const StaticLinkedList *list, FILE *f, ListElemToString str, size_t sizeOfElem) {
     fprintf(f, "[");
     char s[sizeOfElem + 1];
     for (size_t i = 0; i < list->length - 1 && list->length; i++) {
-        size_t len = str(pointerAdd(list->elems, list->indexes[i] * list->elemSize), s);
+        size_t len = str(elemAt(list, i), s);
         s[len] = '\0';
         fprintf(f, "%s, ", s);
     }
     if (list->length > 0) {
-        size_t len = str(pointerAdd(list->elems, list->indexes[list->length - 1] * list->elemSize), s);
+        size_t len = str(elemAt(list, list->length - 1), s);
         s[len] = '\0';
         fprintf(f, "%s", s);
     }
@@ -195,76 +288,145 @@ int staticLinkedList_fprint(const StaticLinkedList *list, FILE *f, ListElemToStr
 }
 
 static _Bool needReduce(StaticLinkedList *list) {
-    return list->length > ExpandThreshold && (list->length * ReduceFactor <= list->capacity);
+    return !list->policy.neverShrink && list->length > ExpandThreshold &&
+           list->length * list->policy.shrinkFactor <= list->capacity;
 }
 
 static _Bool needExpand(StaticLinkedList *list) {
     return list->length >= list->capacity;
 }
 
-static int expandAndInsert(StaticLinkedList *list, size_t index, const void *elem) {
-    if (list->capacity < ExpandThreshold)
-        list->capacity += list->capacity + 1;
+static int expand(StaticLinkedList *list) {
+    if (list->capacity >= maxCapacity(list))
+        return 2;
+    size_t capacity;
+    if (!list->capacity && list->policy.initCapacity)
+        capacity = list->policy.initCapacity;
+    else if (list->capacity < ExpandThreshold)
+        capacity = list->capacity + list->capacity + 1;
     else
-        list->capacity = (size_t) (list->capacity * ExpandFactor);
-
-    void *newElems = malloc(list->elemSize * list->capacity);
-    unsigned *newIndexed = malloc(sizeof(unsigned) * list->capacity);
-
-    // 复制元素。
-    if (list->length && list->elems != NULL)
-        memcpy(newElems, list->elems, list->length * list->elemSize);
+        capacity = (size_t) (list->capacity * list->policy.growFactor);
+    if (capacity <= list->capacity)
+        capacity = list->capacity + 1;
+    if (capacity > maxCapacity(list))
+        capacity = maxCapacity(list);
+    return resize(list, capacity);
+}
 
-    // 新元素添加到尾部。
-    memcpy(pointerAdd(newElems, list->length * list->elemSize), elem, list->elemSize);
+// 缩容后保留一半空闲区间，避免元素个数在阈值附近波动时反复扩缩。
+static void reduce(StaticLinkedList *list) {
+    size_t capacity = (size_t) (list->length * list->policy.shrinkFactor / 2);
+    relayout(list, capacity > list->length ? capacity : list->length);
+}
 
-    if (index && list->indexes != NULL)
-        memcpy(newIndexed, list->indexes, index * sizeof(unsigned));
-    newIndexed[index] = list->length;
-    if (list->length - index)
-        memcpy(newIndexed + index + 1, list->indexes + index, (list->length - index) * sizeof(unsigned));
+// 扩容时elems原地增长，新增的槽位依次压入空闲槽位栈。
+static int resize(StaticLinkedList *list, size_t capacity) {
+    void *elems = realloc(list->elems, list->elemSize * capacity);
+    if (elems == NULL)
+        return 2;
+    list->elems = elems;
+    void *indexes = realloc(list->indexes, list->indexSize * capacity);
+    if (indexes == NULL)
+        return 2;
+    list->indexes = indexes;
+    for (size_t i = list->capacity; i < capacity; i++)
+        setIndex(list, i, i);
+    list->capacity = capacity;
+    return 0;
+}
 
+// 按元素顺序重新排列到新的存储区，元素i存放在槽位i。
+static int relayout(StaticLinkedList *list, size_t capacity) {
+    if (!capacity) {
+        free(list->elems);
+        free(list->indexes);
+        list->indexes = list->elems = NULL;
+        list->capacity = 0;
+        return 0;
+    }
+    void *elems = malloc(list->elemSize * capacity);
+    if (elems == NULL)
+        return 2;
+    for (size_t i = 0; i < list->length; i++)
+        memcpy(pointerAdd(elems, i * list->elemSize), elemAt(list, i), list->elemSize);
+    void *indexes = realloc(list->indexes, list->indexSize * capacity);
+    if (indexes == NULL) {
+        free(elems);
+        return 2;
+    }
     free(list->elems);
-    free(list->indexes);
-    list->elems = newElems;
-    list->indexes = newIndexed;
-    list->length++;
-
+    list->elems = elems;
+    list->indexes = indexes;
+    for (size_t i = 0; i < capacity; i++)
+        setIndex(list, i, i);
+    list->capacity = capacity;
     return 0;
 }
 
-static int reduceAndPop(StaticLinkedList *list, size_t index, void *elem) {
-    unsigned elemIndex = list->indexes[index];
-    if (elem != NULL)
-        memcpy(elem, pointerAdd(list->elems, elemIndex * list->elemSize), list->elemSize);
-    list->capacity = (size_t) (list->length * ExpandFactor);
+// 移除第index个元素，其槽位压入空闲槽位栈，元素不移动。
+static void releaseSlot(StaticLinkedList *list, size_t index) {
+    size_t slot = getIndex(list, index);
+    if (list->length - index > 1)
+        moveIndexes(list, index, index + 1, list->length - index - 1);
+    list->length--;
+    setIndex(list, list->length, slot);
+}
 
-    void *newElems = malloc(list->elemSize * list->capacity);
-    unsigned *newIndexed = malloc(sizeof(unsigned) * list->capacity);
+static size_t getIndex(const StaticLinkedList *list, size_t i) {
+    switch (list->indexSize) {
+        case sizeof(uint16_t):
+            return ((const uint16_t *) list->indexes)[i];
+        case sizeof(uint32_t):
+            return ((const uint32_t *) list->indexes)[i];
+        default:
+            return ((const uint64_t *) list->indexes)[i];
+    }
+}
 
-    if (elemIndex > 1)
-        memcpy(newElems, list->elems, list->elemSize * (elemIndex - 1));
-    if (list->length - elemIndex > 1)
-        memcpy(
-                pointerAdd(newElems, elemIndex * list->elemSize),
-                pointerAdd(list->elems, (elemIndex + 1) * list->elemSize),
-                (list->length - elemIndex - 1) * list->elemSize
-        );
+static void setIndex(StaticLinkedList *list, size_t i, size_t slot) {
+    switch (list->indexSize) {
+        case sizeof(uint16_t):
+            ((uint16_t *) list->indexes)[i] = (uint16_t) slot;
+            break;
+        case sizeof(uint32_t):
+            ((uint32_t *) list->indexes)[i] = (uint32_t) slot;
+            break;
+        default:
+            ((uint64_t *) list->indexes)[i] = slot;
+    }
+}
 
-    if (index)
-        memcpy(newIndexed, list->indexes, index * sizeof(unsigned));
-    if (list->length - index > 1)
-        memcpy(newIndexed + index, list->indexes + index + 1, (list->length - index - 1) * sizeof(unsigned));
+static void *elemAt(const StaticLinkedList *list, size_t i) {
+    return pointerAdd(list->elems, getIndex(list, i) * list->elemSize);
+}
 
-    free(list->elems);
-    free(list->indexes);
-    list->indexes = newIndexed;
-    list->elems = newElems;
-    list->length--;
+static void moveIndexes(StaticLinkedList *list, size_t to, size_t from, size_t count) {
+    memmove(pointerAdd(list->indexes, to * list->indexSize), pointerAdd(list->indexes, from * list->indexSize),
+            count * list->indexSize);
+}
 
-    for (size_t i = 0; i < list->length; i++)
-        if (list->indexes[i] > elemIndex)
-            list->indexes[i]--;
+// 索引宽度可表示的最大容量。
+static size_t maxCapacity(const StaticLinkedList *list) {
+    if (list->indexSize >= sizeof(size_t))
+        return SIZE_MAX;
+    return (size_t) 1 << (list->indexSize * 8);
+}
 
-    return 0;
+// 索引项可能位于归并排序的缓冲区中，按值读取槽位。
+static int slotCmp(const void *i1, const void *i2, void *ctx) {
+    const SlotSortCtx *sortCtx = ctx;
+    const StaticLinkedList *list = sortCtx->list;
+    size_t s1, s2;
+    switch (list->indexSize) {
+        case sizeof(uint16_t):
+            s1 = *(const uint16_t *) i1, s2 = *(const uint16_t *) i2;
+            break;
+        case sizeof(uint32_t):
+            s1 = *(const uint32_t *) i1, s2 = *(const uint32_t *) i2;
+            break;
+        default:
+            s1 = *(const uint64_t *) i1, s2 = *(const uint64_t *) i2;
+    }
+    return sortCtx->cmp(pointerAdd(list->elems, s1 * list->elemSize), pointerAdd(list->elems, s2 * list->elemSize),
+                        sortCtx->ctx);
 }
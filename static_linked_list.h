@@ -18,10 +18,15 @@
 #include "list.h"
 
 // 静态线性表。
+// 元素存放在elems的槽位中，插入删除时不移动；indexes前length项依次为各元素所在槽位，
+// 其余项为空闲槽位栈，删除元素时槽位压栈，插入元素时从栈顶取槽位。
+// 每个索引占indexSize个字节，容量不超过该宽度可表示的槽位数。
 typedef struct {
     size_t length, capacity, elemSize;
-    unsigned *indexes;
+    size_t indexSize;
+    void *indexes;
     void *elems;
+    ListGrowthPolicy policy;
 } StaticLinkedList;
 
 // 新建静态链表。
@@ -30,6 +35,23 @@ typedef struct {
 // 空间复杂度：O(1)
 StaticLinkedList *staticLinkedList_alloc(size_t elemSize);
 
+// 按容量策略新建静态链表。
+// elemSize：每个元素占用的字节大小。
+// policy：容量策略，NULL表示默认策略。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+StaticLinkedList *staticLinkedList_allocWithPolicy(size_t elemSize, const ListGrowthPolicy *policy);
+
+// 按容量策略与索引宽度新建静态链表。
+// elemSize：每个元素占用的字节大小。
+// policy：容量策略，NULL表示默认策略。
+// width：索引宽度，16位时容量不超过65536，元素较少时索引更紧凑。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+// 返回NULL: 索引宽度无效。
+StaticLinkedList *staticLinkedList_allocWithIndexWidth(size_t elemSize, const ListGrowthPolicy *policy,
+                                                       ListIndexWidth width);
+
 // 销毁静态链表。
 // list：静态链表。
 // 时间复杂度：O(1)
@@ -55,16 +77,17 @@ int staticLinkedList_get(const StaticLinkedList *list, size_t index, void *elem)
 // list：静态链表。
 // index：插入位置。
 // elem：被插入的元素值。
-// 时间复杂度：O(1)
-// 空间复杂度：O(n)
+// 时间复杂度：O(n)，元素不移动，只移动其后的索引
+// 空间复杂度：O(1)
 // 返回1: 越界。
+// 返回2: 内存不足或超出索引宽度可表示的容量。
 int staticLinkedList_insert(StaticLinkedList *list, size_t index, const void *elem);
 
 // 删除静态链表中的元素。
 // list：静态链表。
 // index：元素所在位置。
-// 时间复杂度：O(1)
-// 空间复杂度：O(n)
+// 时间复杂度：O(n)，元素不移动，只移动其后的索引
+// 空间复杂度：O(1)
 // 返回1: 越界。
 int staticLinkedList_del(StaticLinkedList *list, size_t index);
 
@@ -85,6 +108,26 @@ int staticLinkedList_locate(const StaticLinkedList *list, ListElemComparer cmp,
 // 空间复杂度：O(1)
 int staticLinkedList_travel(const StaticLinkedList *list, ListElemVisitor visit);
 
+// 带上下文查找元素在静态链表中的位置。
+// list：静态链表。
+// cmp：元素比较函数。
+// elem：要寻找的元素。
+// ctx：传给比较函数的上下文。
+// index：元素位置塞入index中。
+// 时间复杂度：O(n)
+// 空间复杂度：O(1)
+// 返回1: 未找到。
+int staticLinkedList_locateCtx(const StaticLinkedList *list, ListElemCtxComparer cmp, const void *elem, void *ctx, size_t *index);
+
+// 带上下文遍历静态链表，遍历函数返回非0时停止。
+// list：静态链表。
+// visit：遍历函数。
+// ctx：传给遍历函数的上下文。
+// 时间复杂度：O(n)
+// 空间复杂度：O(1)
+// 返回visit的非0返回值: 遍历提前结束。
+int staticLinkedList_travelCtx(const StaticLinkedList *list, ListElemCtxVisitor visit, void *ctx);
+
 // 清空静态链表。
 // list：静态链表。
 // 时间复杂度：O(1)
@@ -134,8 +177,8 @@ int staticLinkedList_set(StaticLinkedList *list, size_t index, const void *elem)
 // list：静态链表。
 // index：元素所在位置。
 // elem：元素值塞入elem中。
-// 时间复杂度：O(1)
-// 空间复杂度：O(n)
+// 时间复杂度：O(n)，元素不移动，只移动其后的索引
+// 空间复杂度：O(1)
 // 返回1: 越界。
 int staticLinkedList_getDel(StaticLinkedList *list, size_t index, void *elem);
 
@@ -148,6 +191,53 @@ int staticLinkedList_getDel(StaticLinkedList *list, size_t index, void *elem);
 // 返回1: 越界。
 int staticLinkedList_getSet(StaticLinkedList *list, size_t index, void *elem);
 
+// 预留静态链表容量，之后插入元素直到容量用尽都不再重新分配内存。
+// list：静态链表。
+// capacity：至少能容纳的元素个数。
+// 时间复杂度：O(n)
+// 空间复杂度：O(n)
+// 返回2: 内存不足或超出索引宽度可表示的容量。
+int staticLinkedList_reserve(StaticLinkedList *list, size_t capacity);
+
+// 将静态链表容量缩减到元素个数，同时按元素顺序重排。
+// list：静态链表。
+// 时间复杂度：O(n)
+// 空间复杂度：O(n)
+// 返回2: 内存不足，容量与槽位排列不变。
+int staticLinkedList_shrinkToFit(StaticLinkedList *list);
+
+// 按元素顺序重排槽位，使相邻元素存放在相邻槽位，反复插入删除后可提升遍历的局部性。之前取得的元素地址失效。
+// list：静态链表。
+// 时间复杂度：O(n)
+// 空间复杂度：O(n)
+// 返回2: 内存不足或超出索引宽度可表示的容量。
+int staticLinkedList_compact(StaticLinkedList *list);
+
+// 获取静态链表中元素的存储地址，可原地读写元素，插入或删除元素后地址失效。
+// list：静态链表。
+// index：元素所在位置。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+// 返回NULL: 越界。
+void *staticLinkedList_at(const StaticLinkedList *list, size_t index);
+
+// 按比较函数升序排列静态链表，只重排indexes，元素不移动，不保证相等元素的相对顺序。
+// list：静态链表。
+// cmp：元素比较函数。
+// ctx：传给比较函数的上下文。
+// 时间复杂度：O(n*log(n))
+// 空间复杂度：O(log(n))
+int staticLinkedList_sort(StaticLinkedList *list, ListElemCtxComparer cmp, void *ctx);
+
+// 按比较函数升序排列静态链表，只重排indexes，元素不移动，相等元素保持原有顺序。
+// list：静态链表。
+// cmp：元素比较函数。
+// ctx：传给比较函数的上下文。
+// 时间复杂度：O(n*log(n))
+// 空间复杂度：O(n)
+// 返回2: 内存不足。
+int staticLinkedList_sortStable(StaticLinkedList *list, ListElemCtxComparer cmp, void *ctx);
+
 // 打印静态链表中的元素。
 // list：静态链表。
 // f：打印输出对象。
@@ -21,6 +21,8 @@ static int intCmp(const void *o1, const void *o2);
 
 static void intVisitor(void *p);
 
+static int ctxIntCmp(const void *o1, const void *o2, void *ctx);
+
 int main(void) {
     StaticLinkedList *list = staticLinkedList_alloc(sizeof(int));
     assert(list);
@@ -91,8 +93,116 @@ int main(void) {
         assert(!staticLinkedList_getDel(list, index, &elem));
     }
 
+    assert(!staticLinkedList_reserve(list, TEST_LENGTH));
+    assert(list->capacity == TEST_LENGTH);
+    for (int i = 0; i < TEST_LENGTH; i++) {
+        elem = i + 1;
+        assert(!staticLinkedList_rpush(list, &elem));
+    }
+    assert(list->capacity == TEST_LENGTH);
+    for (int i = 0; i < TEST_LENGTH - 10; i++)
+        assert(!staticLinkedList_lpop(list, &elem));
+    assert(list->capacity < TEST_LENGTH);
+    assert(!staticLinkedList_shrinkToFit(list));
+    assert(list->capacity == 10);
+    assert(!staticLinkedList_get(list, 0, &elem));
+    assert(elem == TEST_LENGTH - 9);
+    assert(*(int *) staticLinkedList_at(list, 9) == TEST_LENGTH);
+    assert(staticLinkedList_at(list, 10) == NULL);
+
     staticLinkedList_clear(list);
     staticLinkedList_free(list);
+
+    ListGrowthPolicy policy = {.initCapacity = 64, .growFactor = 2, .shrinkFactor = 4, .neverShrink = 1};
+    list = staticLinkedList_allocWithPolicy(sizeof(int), &policy);
+    assert(!staticLinkedList_rpush(list, &elem));
+    assert(list->capacity == 64);
+    staticLinkedList_free(list);
+
+    // 删除元素不移动其它元素，槽位被复用；重排后元素按顺序存放。
+    list = staticLinkedList_alloc(sizeof(int));
+    for (int i = 0; i < 1000; i++)
+        assert(!staticLinkedList_rpush(list, &i));
+    int *last = staticLinkedList_at(list, 999);
+    void *freed = staticLinkedList_at(list, 500);
+    assert(!staticLinkedList_del(list, 500));
+    assert(!staticLinkedList_del(list, 0));
+    assert(staticLinkedList_at(list, 997) == last && *last == 999);
+    elem = -1;
+    assert(!staticLinkedList_insert(list, 10, &elem));
+    assert(staticLinkedList_at(list, 10) != freed);
+    elem = -2;
+    assert(!staticLinkedList_insert(list, 20, &elem));
+    assert(staticLinkedList_at(list, 20) == freed);
+    for (int i = 0; i < 400; i++)
+        assert(!staticLinkedList_del(list, rand() % staticLinkedList_len(list)));
+    int before[600];
+    for (size_t i = 0; i < 600; i++)
+        assert(!staticLinkedList_get(list, i, before + i));
+    assert(!staticLinkedList_compact(list));
+    for (size_t i = 0; i < 600; i++) {
+        assert(getIndex(list, i) == i);
+        assert(*(int *) staticLinkedList_at(list, i) == before[i]);
+    }
+    for (int i = 0; i < 100; i++)
+        assert(!staticLinkedList_insert(list, rand() % (staticLinkedList_len(list) + 1), &i));
+    assert(staticLinkedList_len(list) == 700);
+    staticLinkedList_free(list);
+
+    // 16位索引容量不超过65536，64位索引与默认宽度行为一致。
+    assert(staticLinkedList_allocWithIndexWidth(sizeof(int), NULL, ListIndexWidth_64 + 1) == NULL);
+    list = staticLinkedList_allocWithIndexWidth(sizeof(int), NULL, ListIndexWidth_16);
+    assert(list->indexSize == 2);
+    assert(staticLinkedList_reserve(list, 65537) == 2);
+    for (int i = 0; i < 65536; i++)
+        assert(!staticLinkedList_rpush(list, &i));
+    assert(staticLinkedList_rpush(list, &elem) == 2);
+    assert(staticLinkedList_len(list) == 65536);
+    assert(!staticLinkedList_del(list, 100));
+    assert(!staticLinkedList_lpush(list, &elem));
+    assert(*(int *) staticLinkedList_at(list, 65535) == 65535);
+    assert(*(int *) staticLinkedList_at(list, 101) == 101);
+    staticLinkedList_free(list);
+    list = staticLinkedList_allocWithIndexWidth(sizeof(int), NULL, ListIndexWidth_64);
+    assert(list->indexSize == 8);
+    int expected[1000];
+    for (int i = 0; i < 1000; i++) {
+        size_t at = i / 2;
+        memmove(expected + at + 1, expected + at, (i - at) * sizeof(int));
+        expected[at] = i;
+        assert(!staticLinkedList_insert(list, at, &i));
+    }
+    for (int i = 0; i < 500; i++)
+        assert(!staticLinkedList_del(list, 0));
+    assert(!staticLinkedList_compact(list));
+    for (size_t i = 0; i < 500; i++) {
+        assert(getIndex(list, i) == i);
+        assert(*(int *) staticLinkedList_at(list, i) == expected[i + 500]);
+    }
+    staticLinkedList_free(list);
+
+    // 排序只重排索引，元素所在槽位不变。
+    int order = -1;
+    list = staticLinkedList_alloc(sizeof(int[2]));
+    for (int i = 0; i < 10000; i++)
+        assert(!staticLinkedList_rpush(list, (int[2]) {rand() % 100, i}));
+    for (int i = 0; i < 5000; i++)
+        assert(!staticLinkedList_del(list, rand() % staticLinkedList_len(list)));
+    int *slots = malloc(list->capacity * sizeof(int[2]));
+    memcpy(slots, list->elems, list->capacity * sizeof(int[2]));
+    assert(!staticLinkedList_sortStable(list, ctxIntCmp, &order));
+    assert(!memcmp(slots, list->elems, list->capacity * sizeof(int[2])));
+    for (int i = 1; i < 5000; i++) {
+        int *prev = staticLinkedList_at(list, i - 1), *cur = staticLinkedList_at(list, i);
+        assert(prev[0] > cur[0] || (prev[0] == cur[0] && prev[1] < cur[1]));
+    }
+    order = 1;
+    assert(!staticLinkedList_sort(list, ctxIntCmp, &order));
+    assert(!memcmp(slots, list->elems, list->capacity * sizeof(int[2])));
+    for (int i = 1; i < 5000; i++)
+        assert(*(int *) staticLinkedList_at(list, i - 1) <= *(int *) staticLinkedList_at(list, i));
+    free(slots);
+    staticLinkedList_free(list);
 }
 
 static int intCmp(const void *o1, const void *o2) {
@@ -109,3 +219,8 @@ static void intVisitor(void *p) {
     assert(i == prev);
     prev = i + 1;
 }
+
+static int ctxIntCmp(const void *o1, const void *o2, void *ctx) {
+    int n1 = *(const int *) o1, n2 = *(const int *) o2;
+    return ((n1 > n2) - (n1 < n2)) * *(int *) ctx;
+}
@@ -0,0 +1,404 @@
+/*
+ * Copyright (c) 2023 ivfzhou
+ * clib is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+
+#include <sched.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "thread_pool.h"
+
+// 任务队列的初始容量
+const static size_t InitQueueCapacity = 64;
+
+// parallelFor未指定段长时每个参与线程约分得的段数
+const static size_t ChunksPerThread = 8;
+
+// parallelFor的一次执行，各线程按段号递增领取
+typedef struct {
+    ThreadPoolRangeFunc *func;
+    void *ctx;
+    size_t begin, end, grain, chunks;
+    atomic_size_t next; // 下一个待领取的段号
+} RangeJob;
+
+// 当前线程所属的工作线程，非工作线程为NULL
+static _Thread_local ThreadPoolWorker *currentWorker;
+
+static pthread_once_t sharedOnce = PTHREAD_ONCE_INIT;
+
+static ThreadPool *sharedPool;
+
+static void *workerMain(void *arg);
+
+static int submitTask(ThreadPool *pool, ThreadPoolFunc func, void *arg, ThreadPoolFuture *future);
+
+static int pushTask(ThreadPoolWorker *worker, const ThreadPoolTask *task);
+
+static _Bool popTask(ThreadPoolWorker *worker, ThreadPoolTask *task);
+
+static _Bool stealTask(ThreadPool *pool, ThreadPoolWorker *thief, ThreadPoolTask *task);
+
+static _Bool findTask(ThreadPool *pool, ThreadPoolWorker *self, ThreadPoolTask *task);
+
+static void runTask(ThreadPool *pool, ThreadPoolTask *task);
+
+static void initFuture(ThreadPoolFuture *future);
+
+static void waitFuture(ThreadPool *pool, ThreadPoolFuture *future);
+
+static void destroyFuture(ThreadPoolFuture *future);
+
+static void rangeWork(RangeJob *job);
+
+static void *rangeTask(void *arg);
+
+static void createShared(void);
+
+ThreadPool *threadPool_alloc(size_t threads) {
+    if (!threads) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = online > 0 ? online : 1;
+    }
+    ThreadPool *pool = malloc(sizeof(ThreadPool));
+    if (pool == NULL)
+        return NULL;
+    pool->workers = calloc(threads, sizeof(ThreadPoolWorker));
+    if (pool->workers == NULL) {
+        free(pool);
+        return NULL;
+    }
+    pool->threads = threads;
+    atomic_init(&pool->queued, 0);
+    atomic_init(&pool->unfinished, 0);
+    atomic_init(&pool->next, 0);
+    atomic_init(&pool->sleeping, 0);
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+    pthread_cond_init(&pool->idle, NULL);
+    pool->stop = 0;
+
+    // 先建好全部队列再启动线程，窃取时遍历的队列都已可用。
+    size_t ready = 0;
+    for (; ready < threads; ready++) {
+        ThreadPoolWorker *worker = pool->workers + ready;
+        worker->tasks = malloc(InitQueueCapacity * sizeof(ThreadPoolTask));
+        if (worker->tasks == NULL)
+            break;
+        worker->capacity = InitQueueCapacity;
+        worker->head = worker->length = 0;
+        worker->pool = pool;
+        pthread_mutex_init(&worker->lock, NULL);
+    }
+    size_t started = 0;
+    if (ready == threads)
+        for (; started < threads; started++)
+            if (pthread_create(&pool->workers[started].thread, NULL, workerMain, pool->workers + started))
+                break;
+    if (started == threads)
+        return pool;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = 1;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+    for (size_t i = 0; i < started; i++)
+        pthread_join(pool->workers[i].thread, NULL);
+    for (size_t i = 0; i < ready; i++) {
+        pthread_mutex_destroy(&pool->workers[i].lock);
+        free(pool->workers[i].tasks);
+    }
+    pthread_cond_destroy(&pool->idle);
+    pthread_cond_destroy(&pool->wake);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->workers);
+    free(pool);
+    return NULL;
+}
+
+void threadPool_free(ThreadPool *pool) {
+    threadPool_wait(pool);
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = 1;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+    for (size_t i = 0; i < pool->threads; i++) {
+        pthread_join(pool->workers[i].thread, NULL);
+        pthread_mutex_destroy(&pool->workers[i].lock);
+        free(pool->workers[i].tasks);
+    }
+    pthread_cond_destroy(&pool->idle);
+    pthread_cond_destroy(&pool->wake);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->workers);
+    free(pool);
+}
+
+size_t threadPool_threads(const ThreadPool *pool) {
+    return pool->threads;
+}
+
+int threadPool_submit(ThreadPool *pool, ThreadPoolFunc func, void *arg) {
+    return submitTask(pool, func, arg, NULL);
+}
+
+ThreadPoolFuture *threadPool_async(ThreadPool *pool, ThreadPoolFunc func, void *arg) {
+    ThreadPoolFuture *future = malloc(sizeof(ThreadPoolFuture));
+    if (future == NULL)
+        return NULL;
+    initFuture(future);
+    if (submitTask(pool, func, arg, future)) {
+        destroyFuture(future);
+        free(future);
+        return NULL;
+    }
+    return future;
+}
+
+_Bool threadPool_isDone(ThreadPoolFuture *future) {
+    return atomic_load(&future->done);
+}
+
+void *threadPool_join(ThreadPool *pool, ThreadPoolFuture *future) {
+    waitFuture(pool, future);
+    void *result = future->result;
+    destroyFuture(future);
+    free(future);
+    return result;
+}
+
+void threadPool_wait(ThreadPool *pool) {
+    pthread_mutex_lock(&pool->lock);
+    while (atomic_load(&pool->unfinished))
+        pthread_cond_wait(&pool->idle, &pool->lock);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+int threadPool_parallelFor(ThreadPool *pool, size_t begin, size_t end, size_t grain, size_t threads,
+                           ThreadPoolRangeFunc func, void *ctx) {
+    if (end <= begin)
+        return 0;
+    if (!threads || threads > pool->threads + 1)
+        threads = pool->threads + 1;
+    if (!grain) {
+        grain = (end - begin) / (threads * ChunksPerThread);
+        if (!grain)
+            grain = 1;
+    }
+    RangeJob job = {.func = func, .ctx = ctx, .begin = begin, .end = end, .grain = grain,
+                    .chunks = (end - begin - 1) / grain + 1};
+    atomic_init(&job.next, 0);
+    size_t helpers = (threads < job.chunks ? threads : job.chunks) - 1;
+
+    // 帮手任务的结果一次分配，提交失败时少用几个帮手，余下的分段由调用线程完成。
+    ThreadPoolFuture *futures = NULL;
+    if (helpers) {
+        futures = malloc(helpers * sizeof(ThreadPoolFuture));
+        if (futures == NULL)
+            return 2;
+    }
+    size_t submitted = 0;
+    for (; submitted < helpers; submitted++) {
+        initFuture(futures + submitted);
+        if (submitTask(pool, rangeTask, &job, futures + submitted)) {
+            destroyFuture(futures + submitted);
+            break;
+        }
+    }
+    rangeWork(&job);
+    for (size_t i = 0; i < submitted; i++) {
+        waitFuture(pool, futures + i);
+        destroyFuture(futures + i);
+    }
+    free(futures);
+    return 0;
+}
+
+ThreadPool *threadPool_shared(void) {
+    pthread_once(&sharedOnce, createShared);
+    return sharedPool;
+}
+
+static void *workerMain(void *arg) {
+    ThreadPoolWorker *self = arg;
+    ThreadPool *pool = self->pool;
+    currentWorker = self;
+    for (;;) {
+        ThreadPoolTask task;
+        if (findTask(pool, self, &task)) {
+            runTask(pool, &task);
+            continue;
+        }
+        // 先登记为等待再检查任务数，提交方先增加任务数再检查等待数，两者至少有一方看到对方。
+        pthread_mutex_lock(&pool->lock);
+        atomic_fetch_add(&pool->sleeping, 1);
+        while (!pool->stop && !atomic_load(&pool->queued))
+            pthread_cond_wait(&pool->wake, &pool->lock);
+        atomic_fetch_sub(&pool->sleeping, 1);
+        _Bool stop = pool->stop && !atomic_load(&pool->queued);
+        pthread_mutex_unlock(&pool->lock);
+        if (stop)
+            return NULL;
+    }
+}
+
+// 工作线程提交时放入自己的队列，后提交的先执行，其它线程窃取最早提交的任务。
+static int submitTask(ThreadPool *pool, ThreadPoolFunc func, void *arg, ThreadPoolFuture *future) {
+    ThreadPoolWorker *worker = currentWorker;
+    if (worker == NULL || worker->pool != pool)
+        worker = pool->workers + atomic_fetch_add(&pool->next, 1) % pool->threads;
+    ThreadPoolTask task = {.func = func, .arg = arg, .future = future};
+    // 先计数再入队，任务被取走时计数不会减到负数。
+    atomic_fetch_add(&pool->unfinished, 1);
+    atomic_fetch_add(&pool->queued, 1);
+    if (pushTask(worker, &task)) {
+        atomic_fetch_sub(&pool->queued, 1);
+        atomic_fetch_sub(&pool->unfinished, 1);
+        return 2;
+    }
+    if (atomic_load(&pool->sleeping)) {
+        pthread_mutex_lock(&pool->lock);
+        pthread_cond_signal(&pool->wake);
+        pthread_mutex_unlock(&pool->lock);
+    }
+    return 0;
+}
+
+// 队列满时容量翻倍，并把环绕到数组开头的部分接到原有元素之后。
+static int pushTask(ThreadPoolWorker *worker, const ThreadPoolTask *task) {
+    pthread_mutex_lock(&worker->lock);
+    if (worker->length == worker->capacity) {
+        ThreadPoolTask *tasks = realloc(worker->tasks, worker->capacity * 2 * sizeof(ThreadPoolTask));
+        if (tasks == NULL) {
+            pthread_mutex_unlock(&worker->lock);
+            return 2;
+        }
+        memcpy(tasks + worker->capacity, tasks, worker->head * sizeof(ThreadPoolTask));
+        worker->tasks = tasks;
+        worker->capacity *= 2;
+    }
+    worker->tasks[(worker->head + worker->length) % worker->capacity] = *task;
+    worker->length++;
+    pthread_mutex_unlock(&worker->lock);
+    return 0;
+}
+
+static _Bool popTask(ThreadPoolWorker *worker, ThreadPoolTask *task) {
+    pthread_mutex_lock(&worker->lock);
+    _Bool found = worker->length;
+    if (found) {
+        worker->length--;
+        *task = worker->tasks[(worker->head + worker->length) % worker->capacity];
+    }
+    pthread_mutex_unlock(&worker->lock);
+    return found;
+}
+
+// 从thief之后的队列开始依次尝试，避免所有线程都先窃取同一个队列。
+static _Bool stealTask(ThreadPool *pool, ThreadPoolWorker *thief, ThreadPoolTask *task) {
+    size_t start = thief ? (size_t) (thief - pool->workers) + 1 : 0;
+    for (size_t i = 0; i < pool->threads; i++) {
+        ThreadPoolWorker *victim = pool->workers + (start + i) % pool->threads;
+        if (victim == thief)
+            continue;
+        pthread_mutex_lock(&victim->lock);
+        _Bool found = victim->length;
+        if (found) {
+            *task = victim->tasks[victim->head];
+            victim->head = (victim->head + 1) % victim->capacity;
+            victim->length--;
+        }
+        pthread_mutex_unlock(&victim->lock);
+        if (found)
+            return 1;
+    }
+    return 0;
+}
+
+static _Bool findTask(ThreadPool *pool, ThreadPoolWorker *self, ThreadPoolTask *task) {
+    if (!atomic_load(&pool->queued))
+        return 0;
+    if (popTask(self, task) || stealTask(pool, self, task)) {
+        atomic_fetch_sub(&pool->queued, 1);
+        return 1;
+    }
+    return 0;
+}
+
+static void runTask(ThreadPool *pool, ThreadPoolTask *task) {
+    void *result = task->func(task->arg);
+    ThreadPoolFuture *future = task->future;
+    if (future) {
+        pthread_mutex_lock(&future->lock);
+        future->result = result;
+        atomic_store(&future->done, 1);
+        pthread_cond_broadcast(&future->cond);
+        pthread_mutex_unlock(&future->lock);
+    }
+    if (atomic_fetch_sub(&pool->unfinished, 1) == 1) {
+        pthread_mutex_lock(&pool->lock);
+        pthread_cond_broadcast(&pool->idle);
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
+
+static void initFuture(ThreadPoolFuture *future) {
+    atomic_init(&future->done, 0);
+    future->result = NULL;
+    pthread_mutex_init(&future->lock, NULL);
+    pthread_cond_init(&future->cond, NULL);
+}
+
+// 工作线程等待时执行别的任务，没有可执行的任务时让出处理器；其它线程在条件变量上阻塞。
+static void waitFuture(ThreadPool *pool, ThreadPoolFuture *future) {
+    ThreadPoolWorker *self = currentWorker;
+    if (self && self->pool == pool) {
+        while (!atomic_load(&future->done)) {
+            ThreadPoolTask task;
+            if (findTask(pool, self, &task))
+                runTask(pool, &task);
+            else
+                sched_yield();
+        }
+        // 完成方在锁内置位并广播，取一次锁使其解锁后才销毁。
+        pthread_mutex_lock(&future->lock);
+        pthread_mutex_unlock(&future->lock);
+        return;
+    }
+    pthread_mutex_lock(&future->lock);
+    while (!atomic_load(&future->done))
+        pthread_cond_wait(&future->cond, &future->lock);
+    pthread_mutex_unlock(&future->lock);
+}
+
+static void destroyFuture(ThreadPoolFuture *future) {
+    pthread_cond_destroy(&future->cond);
+    pthread_mutex_destroy(&future->lock);
+}
+
+static void rangeWork(RangeJob *job) {
+    for (;;) {
+        size_t chunk = atomic_fetch_add(&job->next, 1);
+        if (chunk >= job->chunks)
+            return;
+        size_t from = job->begin + chunk * job->grain;
+        job->func(from, job->end - from > job->grain ? from + job->grain : job->end, job->ctx);
+    }
+}
+
+static void *rangeTask(void *arg) {
+    rangeWork(arg);
+    return NULL;
+}
+
+static void createShared(void) {
+    sharedPool = threadPool_alloc(0);
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2023 ivfzhou
+ * clib is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+
+#ifndef CLIB_THREAD_POOL_H
+#define CLIB_THREAD_POOL_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+
+// 线程池任务，返回值由threadPool_join取得。
+typedef void *ThreadPoolFunc(void *arg);
+
+// 区间任务，处理[from, to)。
+// ctx：调用方传入的上下文。
+typedef void ThreadPoolRangeFunc(size_t from, size_t to, void *ctx);
+
+// 任务的执行结果，由threadPool_async返回，threadPool_join等待并释放。
+typedef struct {
+    atomic_bool done;
+    void *result;
+    pthread_mutex_t lock;
+    pthread_cond_t cond; // 任务完成时唤醒等待的非工作线程
+} ThreadPoolFuture;
+
+// 队列中的任务。
+typedef struct {
+    ThreadPoolFunc *func;
+    void *arg;
+    ThreadPoolFuture *future; // NULL表示无需结果
+} ThreadPoolTask;
+
+struct ThreadPool;
+
+// 工作线程及其任务队列，队列为环形数组，所有者从尾部压入和弹出，其它线程从头部窃取。
+typedef struct {
+    pthread_mutex_t lock; // 保护任务队列
+    ThreadPoolTask *tasks;
+    size_t capacity, head, length;
+    pthread_t thread;
+    struct ThreadPool *pool;
+} ThreadPoolWorker;
+
+// 固定线程数的线程池，每个工作线程有自己的任务队列，自己的队列空了就窃取其它队列的任务。
+typedef struct ThreadPool {
+    size_t threads;
+    ThreadPoolWorker *workers;
+    atomic_size_t queued;     // 各队列中的任务数之和
+    atomic_size_t unfinished; // 已提交但尚未执行完的任务数
+    atomic_size_t next;       // 非工作线程提交任务时轮流放入的队列
+    atomic_size_t sleeping;   // 等待新任务的工作线程数，为0时提交任务无需加锁唤醒
+    pthread_mutex_t lock;     // 保护stop，并与以下条件变量配合
+    pthread_cond_t wake;      // 有新任务或要关闭
+    pthread_cond_t idle;      // 任务全部执行完
+    _Bool stop;
+} ThreadPool;
+
+// 新建线程池。
+// threads：工作线程数，0表示在线处理器个数。
+// 时间复杂度：O(threads)
+// 空间复杂度：O(threads)
+// 返回NULL: 内存不足或无法创建线程。
+ThreadPool *threadPool_alloc(size_t threads);
+
+// 关闭线程池，已提交的任务全部执行完后结束工作线程并释放线程池。
+// 不能在线程池自己的工作线程中调用，调用后不能再提交任务。
+// pool：线程池。
+void threadPool_free(ThreadPool *pool);
+
+// 获取工作线程数。
+// pool：线程池。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+size_t threadPool_threads(const ThreadPool *pool);
+
+// 提交无需结果的任务。
+// 在工作线程中提交时放入该线程自己的队列，否则轮流放入各队列。
+// pool：线程池。
+// func：任务函数。
+// arg：传给任务函数的参数。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+// 返回2: 内存不足。
+int threadPool_submit(ThreadPool *pool, ThreadPoolFunc func, void *arg);
+
+// 提交任务并返回其执行结果，须以threadPool_join等待并释放。
+// pool：线程池。
+// func：任务函数。
+// arg：传给任务函数的参数。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+// 返回NULL: 内存不足。
+ThreadPoolFuture *threadPool_async(ThreadPool *pool, ThreadPoolFunc func, void *arg);
+
+// 任务是否已执行完。
+// future：threadPool_async的返回值。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+_Bool threadPool_isDone(ThreadPoolFuture *future);
+
+// 等待任务执行完，释放future并返回任务的返回值。
+// 在工作线程中调用时不阻塞，而是执行队列中的其它任务直到该任务完成，因此任务中可以等待子任务。
+// pool：线程池。
+// future：threadPool_async的返回值。
+void *threadPool_join(ThreadPool *pool, ThreadPoolFuture *future);
+
+// 等待已提交的任务全部执行完，包括执行期间新提交的任务。
+// 不能在线程池自己的工作线程中调用。
+// pool：线程池。
+void threadPool_wait(ThreadPool *pool);
+
+// 把[begin, end)每grain个切为一段，由调用线程与工作线程并行执行，返回时各段都已执行完。
+// 各线程按递增顺序领取分段，只有领到分段时才调用func。
+// pool：线程池。
+// begin：区间起点。
+// end：区间终点，不含。
+// grain：每段的长度，0表示按参与线程数每个线程约分得八段。
+// threads：参与的线程数上限，含调用线程，0表示全部工作线程与调用线程。
+// func：区间任务。
+// ctx：传给区间任务的上下文。
+// 返回2: 内存不足，此时不执行任何分段。
+int threadPool_parallelFor(ThreadPool *pool, size_t begin, size_t end, size_t grain, size_t threads,
+                           ThreadPoolRangeFunc func, void *ctx);
+
+// 进程内共享的线程池，工作线程数为在线处理器个数，首次调用时创建，不会被释放。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+// 返回NULL: 创建失败。
+ThreadPool *threadPool_shared(void);
+
+#endif // CLIB_THREAD_POOL_H
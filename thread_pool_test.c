@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2023 ivfzhou
+ * clib is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "thread_pool.c"
+
+static ThreadPool *testPool;
+
+static atomic_size_t counter;
+
+static void *doubleTask(void *arg);
+
+static void *countTask(void *arg);
+
+static void *fibTask(void *arg);
+
+static void markRange(size_t from, size_t to, void *ctx);
+
+static void *nestedForTask(void *arg);
+
+int main(void) {
+    testPool = threadPool_alloc(4);
+    assert(testPool && threadPool_threads(testPool) == 4);
+
+    // 结果按提交顺序取回。
+    ThreadPoolFuture *futures[1000];
+    for (uintptr_t i = 0; i < 1000; i++)
+        assert((futures[i] = threadPool_async(testPool, doubleTask, (void *) i)));
+    for (uintptr_t i = 0; i < 1000; i++)
+        assert((uintptr_t) threadPool_join(testPool, futures[i]) == i * 2);
+
+    // 任务中等待子任务，等待的工作线程执行其它任务而不阻塞。
+    ThreadPoolFuture *fib = threadPool_async(testPool, fibTask, (void *) (uintptr_t) 20);
+    assert((uintptr_t) threadPool_join(testPool, fib) == 6765);
+
+    // 队列容量增长，wait等到全部执行完。
+    atomic_init(&counter, 0);
+    for (int i = 0; i < 10000; i++)
+        assert(!threadPool_submit(testPool, countTask, NULL));
+    threadPool_wait(testPool);
+    assert(atomic_load(&counter) == 10000);
+
+    // 每个下标恰好处理一次，段长与线程数上限各取几种。
+    const size_t length = 100003, grains[] = {0, 1, 7, 4096, 200000}, threads[] = {0, 1, 2, 5, 64};
+    unsigned char *marks = calloc(length, 1);
+    for (int g = 0; g < 5; g++) {
+        for (int t = 0; t < 5; t++) {
+            memset(marks, 0, length);
+            assert(!threadPool_parallelFor(testPool, 3, length, grains[g], threads[t], markRange, marks));
+            for (size_t i = 0; i < length; i++)
+                assert(marks[i] == (i >= 3));
+        }
+    }
+    assert(!threadPool_parallelFor(testPool, 5, 5, 0, 0, markRange, marks));
+
+    // 工作线程中嵌套parallelFor。
+    memset(marks, 0, length);
+    ThreadPoolFuture *nested = threadPool_async(testPool, nestedForTask, marks);
+    assert(!threadPool_join(testPool, nested));
+    for (size_t i = 0; i < length; i++)
+        assert(marks[i] == (i >= 3));
+    free(marks);
+
+    ThreadPoolFuture *done = threadPool_async(testPool, doubleTask, (void *) (uintptr_t) 1);
+    while (!threadPool_isDone(done));
+    assert((uintptr_t) threadPool_join(testPool, done) == 2);
+
+    // 关闭前执行完已提交的任务。
+    atomic_store(&counter, 0);
+    for (int i = 0; i < 1000; i++)
+        assert(!threadPool_submit(testPool, countTask, NULL));
+    threadPool_free(testPool);
+    assert(atomic_load(&counter) == 1000);
+
+    ThreadPool *shared = threadPool_shared();
+    assert(shared && shared == threadPool_shared() && threadPool_threads(shared) >= 1);
+    marks = calloc(length, 1);
+    assert(!threadPool_parallelFor(shared, 0, length, 0, 0, markRange, marks));
+    for (size_t i = 0; i < length; i++)
+        assert(marks[i] == 1);
+    free(marks);
+}
+
+static void *doubleTask(void *arg) {
+    return (void *) ((uintptr_t) arg * 2);
+}
+
+static void *countTask(void *arg) {
+    atomic_fetch_add(&counter, 1);
+    return arg;
+}
+
+static void *fibTask(void *arg) {
+    uintptr_t n = (uintptr_t) arg;
+    if (n < 2)
+        return arg;
+    ThreadPoolFuture *left = threadPool_async(testPool, fibTask, (void *) (n - 1));
+    uintptr_t right = (uintptr_t) fibTask((void *) (n - 2));
+    return (void *) ((uintptr_t) threadPool_join(testPool, left) + right);
+}
+
+static void markRange(size_t from, size_t to, void *ctx) {
+    unsigned char *marks = ctx;
+    for (size_t i = from; i < to; i++)
+        marks[i]++;
+}
+
+static void *nestedForTask(void *arg) {
+    return (void *) (uintptr_t) threadPool_parallelFor(testPool, 3, 100003, 100, 0, markRange, arg);
+}
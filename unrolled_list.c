@@ -0,0 +1,511 @@
+/*
+ * Copyright (c) 2023 ivfzhou
+ * clib is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+
+#include <string.h>
+
+#include "unrolled_list.h"
+
+extern void *pointerAdd(void *p1, size_t delta);
+
+extern void memorySwap(void *p0, void *p1, size_t size);
+
+extern size_t memoryFind(const void *base, size_t count, size_t stride, size_t offset, const void *key,
+                         size_t keySize);
+
+static UnrolledListBlock *newBlock(const UnrolledList *list);
+
+static void *blockElem(const UnrolledList *list, const UnrolledListBlock *block, size_t offset);
+
+static void linkAfter(UnrolledList *list, UnrolledListBlock *block, UnrolledListBlock *prev);
+
+static void unlinkBlock(UnrolledList *list, UnrolledListBlock *block);
+
+static void setFinger(const UnrolledList *list, UnrolledListBlock *block, size_t base);
+
+static UnrolledListBlock *findBlock(const UnrolledList *list, size_t index, size_t *base);
+
+static int insertAt(UnrolledList *list, UnrolledListBlock *block, size_t base, size_t offset, const void *elem);
+
+static void removeAt(UnrolledList *list, UnrolledListBlock *block, size_t base, size_t offset, void *elem);
+
+static void seek(const UnrolledList *list, ListCursor *cursor);
+
+static _Bool canMerge(const UnrolledList *list, const UnrolledListBlock *block, const UnrolledListBlock *other);
+
+UnrolledList *unrolledList_alloc(size_t elemSize) {
+    return unrolledList_allocWithBlockSize(elemSize, 0);
+}
+
+UnrolledList *unrolledList_allocWithBlockSize(size_t elemSize, size_t blockSize) {
+    UnrolledList *list = malloc(sizeof(UnrolledList));
+    list->elemSize = elemSize;
+    list->length = 0;
+    if (!blockSize)
+        blockSize = elemSize && UNROLLED_LIST_BLOCK_BYTES / elemSize > 8 ? UNROLLED_LIST_BLOCK_BYTES / elemSize : 8;
+    list->blockCapacity = blockSize;
+    list->head = list->tail = list->finger = NULL;
+    list->fingerBase = 0;
+    return list;
+}
+
+void unrolledList_free(UnrolledList *list) {
+    unrolledList_clear(list);
+    list->elemSize = 0;
+    free(list);
+}
+
+size_t unrolledList_len(const UnrolledList *list) {
+    return list->length;
+}
+
+int unrolledList_get(const UnrolledList *list, size_t index, void *elem) {
+    if (index >= list->length)
+        return 1;
+    size_t base;
+    UnrolledListBlock *block = findBlock(list, index, &base);
+    memcpy(elem, blockElem(list, block, index - base), list->elemSize);
+    return 0;
+}
+
+int unrolledList_insert(UnrolledList *list, size_t index, const void *elem) {
+    if (index > list->length)
+        return 1;
+    if (index == list->length) {
+        size_t count = list->tail ? list->tail->count : 0;
+        return insertAt(list, list->tail, list->length - count, count, elem);
+    }
+    size_t base;
+    UnrolledListBlock *block = findBlock(list, index, &base);
+    return insertAt(list, block, base, index - base, elem);
+}
+
+int unrolledList_del(UnrolledList *list, size_t index) {
+    return unrolledList_getDel(list, index, NULL);
+}
+
+int unrolledList_locate(const UnrolledList *list, ListElemComparer cmp, const void *elem, size_t *index) {
+    size_t base = 0;
+    for (UnrolledListBlock *block = list->head; block; block = block->next) {
+        for (size_t i = 0; i < block->count; i++) {
+            if (!cmp(blockElem(list, block, i), elem)) {
+                *index = base + i;
+                return 0;
+            }
+        }
+        base += block->count;
+    }
+    return 1;
+}
+
+int unrolledList_locateKey(const UnrolledList *list, size_t offset, const void *key, size_t keySize, size_t *index) {
+    if (offset > list->elemSize || keySize > list->elemSize - offset)
+        return 1;
+    size_t base = 0;
+    for (UnrolledListBlock *block = list->head; block; block = block->next) {
+        size_t i = memoryFind(block->elems, block->count, list->elemSize, offset, key, keySize);
+        if (i < block->count) {
+            *index = base + i;
+            return 0;
+        }
+        base += block->count;
+    }
+    return 1;
+}
+
+int unrolledList_travel(const UnrolledList *list, ListElemVisitor visit) {
+    for (UnrolledListBlock *block = list->head; block; block = block->next)
+        for (size_t i = 0; i < block->count; i++)
+            visit(blockElem(list, block, i));
+    return 0;
+}
+
+int unrolledList_locateCtx(const UnrolledList *list, ListElemCtxComparer cmp, const void *elem, void *ctx,
+                          size_t *index) {
+    size_t base = 0;
+    for (UnrolledListBlock *block = list->head; block; block = block->next) {
+        for (size_t i = 0; i < block->count; i++) {
+            if (!cmp(blockElem(list, block, i), elem, ctx)) {
+                *index = base + i;
+                return 0;
+            }
+        }
+        base += block->count;
+    }
+    return 1;
+}
+
+int unrolledList_travelCtx(const UnrolledList *list, ListElemCtxVisitor visit, void *ctx) {
+    return unrolledList_travelRange(list, 0, list->length, visit, ctx);
+}
+
+int unrolledList_travelRange(const UnrolledList *list, size_t index, size_t count, ListElemCtxVisitor visit,
+                             void *ctx) {
+    if (index > list->length || count > list->length - index)
+        return 1;
+    if (!count)
+        return 0;
+    size_t base;
+    UnrolledListBlock *block = findBlock(list, index, &base);
+    size_t offset = index - base;
+    while (count) {
+        for (; offset < block->count && count; offset++, count--) {
+            int res = visit(blockElem(list, block, offset), ctx);
+            if (res)
+                return res;
+        }
+        block = block->next;
+        offset = 0;
+    }
+    return 0;
+}
+
+int unrolledList_clear(UnrolledList *list) {
+    UnrolledListBlock *block = list->head;
+    while (block) {
+        UnrolledListBlock *next = block->next;
+        free(block);
+        block = next;
+    }
+    list->head = list->tail = list->finger = NULL;
+    list->length = list->fingerBase = 0;
+    return 0;
+}
+
+int unrolledList_rpop(UnrolledList *list, void *elem) {
+    if (!list->length)
+        return 1;
+    UnrolledListBlock *tail = list->tail;
+    removeAt(list, tail, list->length - tail->count, tail->count - 1, elem);
+    return 0;
+}
+
+int unrolledList_lpush(UnrolledList *list, const void *elem) {
+    return insertAt(list, list->head, 0, 0, elem);
+}
+
+int unrolledList_rpush(UnrolledList *list, const void *elem) {
+    return unrolledList_insert(list, list->length, elem);
+}
+
+int unrolledList_lpop(UnrolledList *list, void *elem) {
+    if (!list->length)
+        return 1;
+    removeAt(list, list->head, 0, 0, elem);
+    return 0;
+}
+
+int unrolledList_set(UnrolledList *list, size_t index, const void *elem) {
+    if (index >= list->length)
+        return 1;
+    size_t base;
+    UnrolledListBlock *block = findBlock(list, index, &base);
+    memcpy(blockElem(list, block, index - base), elem, list->elemSize);
+    return 0;
+}
+
+int unrolledList_getDel(UnrolledList *list, size_t index, void *elem) {
+    if (index >= list->length)
+        return 1;
+    size_t base;
+    UnrolledListBlock *block = findBlock(list, index, &base);
+    removeAt(list, block, base, index - base, elem);
+    return 0;
+}
+
+int unrolledList_getSet(UnrolledList *list, size_t index, void *elem) {
+    if (index >= list->length)
+        return 1;
+    size_t base;
+    UnrolledListBlock *block = findBlock(list, index, &base);
+    memorySwap(blockElem(list, block, index - base), elem, list->elemSize);
+    return 0;
+}
+
+void *unrolledList_at(const UnrolledList *list, size_t index) {
+    if (index >= list->length)
+        return NULL;
+    size_t base;
+    UnrolledListBlock *block = findBlock(list, index, &base);
+    return blockElem(list, block, index - base);
+}
+
+int unrolledList_getRange(const UnrolledList *list, size_t index, size_t count, void *elems) {
+    if (index > list->length || count > list->length - index)
+        return 1;
+    if (!count)
+        return 0;
+    size_t base;
+    UnrolledListBlock *block = findBlock(list, index, &base);
+    size_t offset = index - base;
+    while (count) {
+        size_t n = block->count - offset < count ? block->count - offset : count;
+        memcpy(elems, blockElem(list, block, offset), n * list->elemSize);
+        elems = pointerAdd(elems, n * list->elemSize);
+        count -= n;
+        block = block->next;
+        offset = 0;
+    }
+    return 0;
+}
+
+int unrolledList_span(const UnrolledList *list, size_t index, size_t count, ListSpan *span) {
+    if (index > list->length || count > list->length - index)
+        return 1;
+    span->length = count;
+    span->stride = list->elemSize;
+    if (!count) {
+        span->base = NULL;
+        return 0;
+    }
+    size_t base;
+    UnrolledListBlock *block = findBlock(list, index, &base);
+    if (index - base + count > block->count)
+        return 2;
+    span->base = blockElem(list, block, index - base);
+    return 0;
+}
+
+void unrolledList_iterBegin(const UnrolledList *list, ListCursor *cursor) {
+    cursor->index = cursor->offset = 0;
+    cursor->node = list->head;
+    cursor->prev = NULL;
+}
+
+int unrolledList_iterNext(const UnrolledList *list, ListCursor *cursor) {
+    if (cursor->index >= list->length)
+        return 1;
+    UnrolledListBlock *block = cursor->node;
+    cursor->index++;
+    if (++cursor->offset >= block->count && block->next) {
+        cursor->node = block->next;
+        cursor->offset = 0;
+    }
+    return 0;
+}
+
+void *unrolledList_iterAt(const UnrolledList *list, const ListCursor *cursor) {
+    if (cursor->index >= list->length)
+        return NULL;
+    return blockElem(list, cursor->node, cursor->offset);
+}
+
+// 插入或删除后经由指向所改动块的缓存重新定位。
+int unrolledList_iterInsertBefore(UnrolledList *list, ListCursor *cursor, const void *elem) {
+    if (cursor->index >= list->length) {
+        int res = unrolledList_rpush(list, elem);
+        if (!res) {
+            cursor->index = list->length;
+            seek(list, cursor);
+        }
+        return res;
+    }
+    int res = insertAt(list, cursor->node, cursor->index - cursor->offset, cursor->offset, elem);
+    if (res)
+        return res;
+    cursor->index++;
+    seek(list, cursor);
+    return 0;
+}
+
+int unrolledList_iterErase(UnrolledList *list, ListCursor *cursor, void *elem) {
+    if (cursor->index >= list->length)
+        return 1;
+    removeAt(list, cursor->node, cursor->index - cursor->offset, cursor->offset, elem);
+    seek(list, cursor);
+    return 0;
+}
+
+int unrolledList_fprint(const UnrolledList *list, FILE *f, ListElemToString str, size_t sizeOfElem) {
+    fprintf(f, "[");
+    char s[sizeOfElem + 1];
+    size_t index = 0;
+    for (UnrolledListBlock *block = list->head; block; block = block->next) {
+        for (size_t i = 0; i < block->count; i++) {
+            size_t len = str(blockElem(list, block, i), s);
+            s[len] = '\0';
+            fprintf(f, index++ ? ", %s" : "%s", s);
+        }
+    }
+    fprintf(f, "]");
+    fflush(f);
+    return 0;
+}
+
+static UnrolledListBlock *newBlock(const UnrolledList *list) {
+    UnrolledListBlock *block = malloc(sizeof(UnrolledListBlock) + list->blockCapacity * list->elemSize);
+    if (block == NULL)
+        return NULL;
+    block->count = 0;
+    block->prev = block->next = NULL;
+    return block;
+}
+
+// 遍历等热循环逐个调用，直接计算地址以便内联。
+static void *blockElem(const UnrolledList *list, const UnrolledListBlock *block, size_t offset) {
+    return (unsigned char *) block->elems + offset * list->elemSize;
+}
+
+// 把block链接在prev之后，prev为NULL时作为首块。
+static void linkAfter(UnrolledList *list, UnrolledListBlock *block, UnrolledListBlock *prev) {
+    block->prev = prev;
+    block->next = prev ? prev->next : list->head;
+    if (block->next)
+        block->next->prev = block;
+    else
+        list->tail = block;
+    if (prev)
+        prev->next = block;
+    else
+        list->head = block;
+}
+
+static void unlinkBlock(UnrolledList *list, UnrolledListBlock *block) {
+    if (block->prev)
+        block->prev->next = block->next;
+    else
+        list->head = block->next;
+    if (block->next)
+        block->next->prev = block->prev;
+    else
+        list->tail = block->prev;
+}
+
+// 缓存不影响线性表内容，只读访问时也更新。
+static void setFinger(const UnrolledList *list, UnrolledListBlock *block, size_t base) {
+    UnrolledList *mutableList = (UnrolledList *) list;
+    mutableList->finger = block;
+    mutableList->fingerBase = base;
+}
+
+// 从首块、尾块与缓存块中离index最近的出发逐块移动，base被设置为所在块首个元素的位置。
+static UnrolledListBlock *findBlock(const UnrolledList *list, size_t index, size_t *base) {
+    UnrolledListBlock *block = list->head;
+    size_t start = 0, distance = index;
+    if (list->length - index < distance) {
+        block = list->tail;
+        start = list->length - block->count;
+        distance = list->length - index;
+    }
+    if (list->finger) {
+        size_t fingerDistance = index > list->fingerBase ? index - list->fingerBase : list->fingerBase - index;
+        if (fingerDistance < distance) {
+            block = list->finger;
+            start = list->fingerBase;
+        }
+    }
+    while (index < start) {
+        block = block->prev;
+        start -= block->count;
+    }
+    while (index >= start + block->count) {
+        start += block->count;
+        block = block->next;
+    }
+    setFinger(list, block, start);
+    *base = start;
+    return block;
+}
+
+// 在block的offset处插入，block为NULL表示空表；块满时在块首或块尾插入则新增相邻的块，否则对半分裂。
+static int insertAt(UnrolledList *list, UnrolledListBlock *block, size_t base, size_t offset, const void *elem) {
+    if (block == NULL || block->count == list->blockCapacity) {
+        UnrolledListBlock *fresh = newBlock(list);
+        if (fresh == NULL)
+            return 2;
+        if (block == NULL) {
+            linkAfter(list, fresh, NULL);
+            block = fresh;
+        } else if (offset == block->count) {
+            linkAfter(list, fresh, block);
+            base += block->count;
+            block = fresh;
+            offset = 0;
+        } else if (offset == 0) {
+            linkAfter(list, fresh, block->prev);
+            block = fresh;
+        } else {
+            size_t half = block->count / 2;
+            memcpy(fresh->elems, blockElem(list, block, half), (block->count - half) * list->elemSize);
+            fresh->count = block->count - half;
+            block->count = half;
+            linkAfter(list, fresh, block);
+            if (offset > half) {
+                base += half;
+                offset -= half;
+                block = fresh;
+            }
+        }
+    }
+    memmove(blockElem(list, block, offset + 1), blockElem(list, block, offset),
+            (block->count - offset) * list->elemSize);
+    memcpy(blockElem(list, block, offset), elem, list->elemSize);
+    block->count++;
+    list->length++;
+    setFinger(list, block, base);
+    return 0;
+}
+
+// 删除block中offset处的元素，块空了则释放，与相邻块满足canMerge时合并。
+static void removeAt(UnrolledList *list, UnrolledListBlock *block, size_t base, size_t offset, void *elem) {
+    if (elem != NULL)
+        memcpy(elem, blockElem(list, block, offset), list->elemSize);
+    memmove(blockElem(list, block, offset), blockElem(list, block, offset + 1),
+            (block->count - offset - 1) * list->elemSize);
+    block->count--;
+    list->length--;
+
+    if (!block->count) {
+        unlinkBlock(list, block);
+        if (block->next)
+            setFinger(list, block->next, base);
+        else if (block->prev)
+            setFinger(list, block->prev, base - block->prev->count);
+        else
+            setFinger(list, NULL, 0);
+        free(block);
+        return;
+    }
+    UnrolledListBlock *next = block->next, *prev = block->prev;
+    if (next && canMerge(list, block, next)) {
+        memcpy(blockElem(list, block, block->count), next->elems, next->count * list->elemSize);
+        block->count += next->count;
+        unlinkBlock(list, next);
+        free(next);
+    } else if (prev && canMerge(list, block, prev)) {
+        memcpy(blockElem(list, prev, prev->count), block->elems, block->count * list->elemSize);
+        base -= prev->count;
+        prev->count += block->count;
+        unlinkBlock(list, block);
+        free(block);
+        block = prev;
+    }
+    setFinger(list, block, base);
+}
+
+// 合计不超过四分之三块容量，或block不足四分之一且合计放得下时才合并。
+// insertAt把满块对半拆分，若合计放得下就合并，在同一位置交替插入删除会反复拆分合并整块。
+static _Bool canMerge(const UnrolledList *list, const UnrolledListBlock *block, const UnrolledListBlock *other) {
+    size_t total = block->count + other->count;
+    return total <= list->blockCapacity / 4 * 3 ||
+           (block->count < list->blockCapacity / 4 && total <= list->blockCapacity);
+}
+
+static void seek(const UnrolledList *list, ListCursor *cursor) {
+    if (cursor->index < list->length) {
+        size_t base;
+        cursor->node = findBlock(list, cursor->index, &base);
+        cursor->offset = cursor->index - base;
+    } else {
+        cursor->node = list->tail;
+        cursor->offset = list->tail ? list->tail->count : 0;
+    }
+}
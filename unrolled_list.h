@@ -0,0 +1,300 @@
+/*
+ * Copyright (c) 2023 ivfzhou
+ * clib is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+
+#ifndef CLIB_UNROLLED_LIST_H
+#define CLIB_UNROLLED_LIST_H
+
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "list.h"
+
+// 默认每块存放元素的目标字节数，即若干缓存行。
+#define UNROLLED_LIST_BLOCK_BYTES 256
+
+// 块，块内元素连续存放，块之间双向链接。
+typedef struct UnrolledListBlock {
+    struct UnrolledListBlock *prev, *next;
+    size_t count; // 块内元素个数
+    _Alignas(max_align_t) unsigned char elems[];
+} UnrolledListBlock;
+
+// 分块链表，复杂度中的B为每块容量。
+// 按位置访问时缓存最近定位的块，邻近位置的访问从缓存块出发，因此只读访问也会修改缓存，多线程同时读需自行加锁。
+typedef struct {
+    size_t length, elemSize;
+    size_t blockCapacity;           // 每块最多存放的元素个数
+    UnrolledListBlock *head, *tail; // 首尾块，空表时为NULL
+    UnrolledListBlock *finger;      // 最近定位的块，NULL表示无缓存
+    size_t fingerBase;              // finger中首个元素的位置
+} UnrolledList;
+
+// 新建分块链表。
+// elemSize：每个元素占用的字节大小。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+UnrolledList *unrolledList_alloc(size_t elemSize);
+
+// 按块容量新建分块链表。
+// elemSize：每个元素占用的字节大小。
+// blockSize：每块最多存放的元素个数，0表示默认，即UNROLLED_LIST_BLOCK_BYTES字节可容纳的个数且不少于8个。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+UnrolledList *unrolledList_allocWithBlockSize(size_t elemSize, size_t blockSize);
+
+// 销毁分块链表。
+// list：分块链表。
+// 时间复杂度：O(n/B)
+// 空间复杂度：O(1)
+void unrolledList_free(UnrolledList *list);
+
+// 获取分块链表中元素个数。
+// list：分块链表。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+size_t unrolledList_len(const UnrolledList *list);
+
+// 获取分块链表中某个位置的元素。
+// list：分块链表。
+// index：元素所在位置。
+// elem：元素值塞入elem中。
+// 时间复杂度：O(n/B)
+// 空间复杂度：O(1)
+// 返回1: 越界。
+int unrolledList_get(const UnrolledList *list, size_t index, void *elem);
+
+// 向分块链表中插入元素，块满时在首尾插入则新增一块，否则对半分裂。
+// list：分块链表。
+// index：元素插入位置。
+// elem：被插入的元素。
+// 时间复杂度：O(n/B + B)
+// 空间复杂度：O(1)
+// 返回1: 越界。
+// 返回2: 内存不足。
+int unrolledList_insert(UnrolledList *list, size_t index, const void *elem);
+
+// 删除分块链表中某个位置的元素，块与相邻块能合为一块时合并。
+// list：分块链表。
+// index：元素所在位置。
+// 时间复杂度：O(n/B)
+// 空间复杂度：O(1)
+// 返回1: 越界。
+int unrolledList_del(UnrolledList *list, size_t index);
+
+// 寻找元素在分块链表中的位置。
+// list：分块链表。
+// cmp：元素比较函数。
+// elem：要寻找的元素。
+// index：元素位置塞入index中。
+// 时间复杂度：O(n)
+// 空间复杂度：O(1)
+// 返回1: 未找到。
+int unrolledList_locate(const UnrolledList *list, ListElemComparer cmp, const void *elem, size_t *index);
+
+// 按字节查找元素在分块链表中的位置，比较每个元素offset处的keySize个字节，不调用比较函数。
+// 逐块比较块内连续存放的元素。
+// list：分块链表。
+// offset：键在元素中的字节偏移。
+// key：要寻找的键。
+// keySize：键的字节大小。
+// index：元素位置塞入index中。
+// 时间复杂度：O(n)
+// 空间复杂度：O(1)
+// 返回1: 未找到，或键超出了元素范围。
+int unrolledList_locateKey(const UnrolledList *list, size_t offset, const void *key, size_t keySize, size_t *index);
+
+// 遍历分块链表。
+// list：分块链表。
+// visit：遍历函数。
+// 时间复杂度：O(n)
+// 空间复杂度：O(1)
+int unrolledList_travel(const UnrolledList *list, ListElemVisitor visit);
+
+// 带上下文查找元素在分块链表中的位置。
+// list：分块链表。
+// cmp：元素比较函数。
+// elem：要寻找的元素。
+// ctx：传给比较函数的上下文。
+// index：元素位置塞入index中。
+// 时间复杂度：O(n)
+// 空间复杂度：O(1)
+// 返回1: 未找到。
+int unrolledList_locateCtx(const UnrolledList *list, ListElemCtxComparer cmp, const void *elem, void *ctx,
+                          size_t *index);
+
+// 带上下文遍历分块链表，遍历函数返回非0时停止。
+// list：分块链表。
+// visit：遍历函数。
+// ctx：传给遍历函数的上下文。
+// 时间复杂度：O(n)
+// 空间复杂度：O(1)
+// 返回visit的非0返回值: 遍历提前结束。
+int unrolledList_travelCtx(const UnrolledList *list, ListElemCtxVisitor visit, void *ctx);
+
+// 带上下文遍历分块链表中从index开始的count个元素，遍历函数返回非0时停止。
+// list：分块链表。
+// index：第一个元素的位置。
+// count：元素个数。
+// visit：遍历函数。
+// ctx：传给遍历函数的上下文。
+// 时间复杂度：O(n/B + count)
+// 空间复杂度：O(1)
+// 返回1: 越界。
+// 返回visit的非0返回值: 遍历提前结束。
+int unrolledList_travelRange(const UnrolledList *list, size_t index, size_t count, ListElemCtxVisitor visit, void *ctx);
+
+// 清空分块链表。
+// list：分块链表。
+// 时间复杂度：O(n)
+// 空间复杂度：O(1)
+// 返回2: 内存不足。
+int unrolledList_clear(UnrolledList *list);
+
+// 取出分块链表最右边的元素。
+// list：分块链表。
+// elem：元素值塞入elem中。
+// 时间复杂度：O(B)
+// 空间复杂度：O(1)
+// 返回1: 越界。
+int unrolledList_rpop(UnrolledList *list, void *elem);
+
+// 向分块链表最左边添加元素。
+// list：分块链表。
+// elem：被添加的元素。
+// 时间复杂度：O(B)
+// 空间复杂度：O(1)
+// 返回2: 内存不足。
+int unrolledList_lpush(UnrolledList *list, const void *elem);
+
+// 向分块链表最右边添加元素。
+// list：分块链表。
+// elem：被添加的元素。
+// 时间复杂度：O(B)
+// 空间复杂度：O(1)
+// 返回2: 内存不足。
+int unrolledList_rpush(UnrolledList *list, const void *elem);
+
+// 取出分块链表最左边的元素。
+// list：分块链表。
+// elem：元素值塞入elem中。
+// 时间复杂度：O(B)
+// 空间复杂度：O(1)
+// 返回1: 越界。
+int unrolledList_lpop(UnrolledList *list, void *elem);
+
+// 设置分块链表中某个位置的元素。
+// list：分块链表。
+// index：元素所在位置。
+// elem：被设置的元素。
+// 时间复杂度：O(n/B)
+// 空间复杂度：O(1)
+// 返回1: 越界。
+int unrolledList_set(UnrolledList *list, size_t index, const void *elem);
+
+// 获取分块链表中某个位置的元素然后删除之。
+// list：分块链表。
+// index：元素所在位置。
+// elem：元素值塞入elem中。
+// 时间复杂度：O(n/B)
+// 空间复杂度：O(1)
+// 返回1: 越界。
+int unrolledList_getDel(UnrolledList *list, size_t index, void *elem);
+
+// 获取分块链表中某个位置的元素然后设置新值。
+// list：分块链表。
+// index：元素所在位置。
+// elem：元素值设置进表中，然后旧值塞入elem中。
+// 时间复杂度：O(n/B)
+// 空间复杂度：O(1)
+// 返回1: 越界。
+int unrolledList_getSet(UnrolledList *list, size_t index, void *elem);
+
+// 获取分块链表中元素的存储地址，可原地读写元素，插入或删除元素后地址失效。
+// list：分块链表。
+// index：元素所在位置。
+// 时间复杂度：O(n/B)
+// 空间复杂度：O(1)
+// 返回NULL: 越界。
+void *unrolledList_at(const UnrolledList *list, size_t index);
+
+// 获取分块链表中连续多个元素，逐块整段复制。
+// list：分块链表。
+// index：第一个元素的位置。
+// count：元素个数。
+// elems：将被设置为元素值。
+// 时间复杂度：O(n/B + count)
+// 空间复杂度：O(1)
+// 返回1: 越界。
+int unrolledList_getRange(const UnrolledList *list, size_t index, size_t count, void *elems);
+
+// 获取同一块中连续多个元素的视图，插入或删除元素后视图失效。
+// list：分块链表。
+// index：第一个元素的位置。
+// count：元素个数。
+// span：将被设置为元素视图。
+// 时间复杂度：O(n/B)
+// 空间复杂度：O(1)
+// 返回1: 越界。
+// 返回2: 这些元素不在同一块中。
+int unrolledList_span(const UnrolledList *list, size_t index, size_t count, ListSpan *span);
+
+// 迭代位置置于分块链表首个元素。
+// list：分块链表。
+// cursor：将被设置为迭代位置。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+void unrolledList_iterBegin(const UnrolledList *list, ListCursor *cursor);
+
+// 迭代位置前进到下一个元素。
+// list：分块链表。
+// cursor：迭代位置。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+// 返回1: 迭代已结束。
+int unrolledList_iterNext(const UnrolledList *list, ListCursor *cursor);
+
+// 获取迭代位置上元素的存储地址。
+// list：分块链表。
+// cursor：迭代位置。
+// 时间复杂度：O(1)
+// 空间复杂度：O(1)
+// 返回NULL: 迭代已结束。
+void *unrolledList_iterAt(const UnrolledList *list, const ListCursor *cursor);
+
+// 在迭代位置上的元素前插入元素，迭代位置仍指向原元素；迭代已结束时追加到尾部。
+// list：分块链表。
+// cursor：迭代位置。
+// elem：被插入的元素。
+// 时间复杂度：O(B)
+// 空间复杂度：O(1)
+// 返回2: 内存不足。
+int unrolledList_iterInsertBefore(UnrolledList *list, ListCursor *cursor, const void *elem);
+
+// 删除迭代位置上的元素，迭代位置指向下一个元素。
+// list：分块链表。
+// cursor：迭代位置。
+// elem：非NULL时将被设置为删除的元素值。
+// 时间复杂度：O(B)
+// 空间复杂度：O(1)
+// 返回1: 迭代已结束。
+int unrolledList_iterErase(UnrolledList *list, ListCursor *cursor, void *elem);
+
+// 打印分块链表中的元素。
+// list：分块链表。
+// f：打印输出对象。
+// str：元素转字符串函数。
+// sizeOfElem：每个元素转字符串表示占用的最大字节数。
+// 时间复杂度：O(n)
+// 空间复杂度：O(1)
+int unrolledList_fprint(const UnrolledList *list, FILE *f, ListElemToString str, size_t sizeOfElem);
+
+#endif // CLIB_UNROLLED_LIST_H
@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2023 ivfzhou
+ * clib is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "unrolled_list.c"
+
+#define TEST_LENGTH 50000
+
+static int intCmp(const void *o1, const void *o2);
+
+static void intVisitor(void *p);
+
+static int sumVisitor(void *p, void *ctx);
+
+static void checkBlocks(const UnrolledList *list);
+
+static void testRandom(size_t blockSize);
+
+int main(void) {
+    UnrolledList *list = unrolledList_alloc(sizeof(int));
+    assert(list);
+
+    int elem = 2;
+    size_t index = 0;
+    assert(!unrolledList_insert(list, index, &elem));
+
+    elem = 1;
+    assert(!unrolledList_lpush(list, &elem));
+
+    elem = 3;
+    assert(!unrolledList_rpush(list, &elem));
+
+    assert(!unrolledList_travel(list, intVisitor));
+
+    size_t length = unrolledList_len(list);
+    assert(length == 3);
+
+    elem = 4;
+    assert(!unrolledList_set(list, index, &elem));
+
+    assert(!unrolledList_get(list, index, &elem));
+    assert(elem == 4);
+
+    elem = 3;
+    assert(!unrolledList_locate(list, intCmp, &elem, &index));
+    assert(index == 2);
+
+    elem = 4;
+    assert(!unrolledList_getSet(list, index, &elem));
+    assert(elem == 3);
+
+    assert(!unrolledList_getDel(list, index, &elem));
+    assert(elem == 4);
+
+    assert(!unrolledList_lpop(list, &elem));
+    assert(elem == 4);
+
+    assert(!unrolledList_rpop(list, &elem));
+    assert(elem == 2);
+
+    assert(unrolledList_lpop(list, &elem) == 1);
+    assert(unrolledList_rpop(list, &elem) == 1);
+    assert(unrolledList_insert(list, 1, &elem) == 1);
+    assert(!list->head && !list->tail);
+
+    // 两端追加时块保持满。
+    for (int i = 0; i < 1000; i++)
+        assert(!unrolledList_rpush(list, &i));
+    for (int i = -1; i >= -1000; i--)
+        assert(!unrolledList_lpush(list, &i));
+    checkBlocks(list);
+    for (UnrolledListBlock *block = list->head->next; block != list->tail; block = block->next)
+        assert(block->count == list->blockCapacity);
+    for (int i = -1000; i < 1000; i++)
+        assert(!unrolledList_lpop(list, &elem) && elem == i);
+    assert(!list->head && !unrolledList_len(list));
+
+    // 满块在中间插入拆成两半后，同一位置交替删除插入不会立即合并再拆分。
+    for (int i = 0; i < (int) list->blockCapacity; i++)
+        assert(!unrolledList_rpush(list, &i));
+    size_t middle = list->blockCapacity / 2;
+    assert(!unrolledList_insert(list, middle, &elem));
+    UnrolledListBlock *head = list->head, *tail = list->tail;
+    assert(head != tail && head->next == tail);
+    for (int i = 0; i < 100; i++) {
+        assert(!unrolledList_del(list, middle));
+        assert(!unrolledList_insert(list, middle, &elem));
+        assert(list->head == head && list->tail == tail && head->next == tail);
+    }
+    checkBlocks(list);
+    assert(!unrolledList_clear(list));
+    unrolledList_free(list);
+
+    srand(time(NULL) + 100);
+    testRandom(0);
+    testRandom(1);
+    testRandom(3);
+    testRandom(8);
+}
+
+// 与数组对照随机插入删除，块大小取默认值与很小的值以覆盖分裂与合并。
+static void testRandom(size_t blockSize) {
+    UnrolledList *list = unrolledList_allocWithBlockSize(sizeof(int), blockSize);
+    int *expect = malloc(sizeof(int) * TEST_LENGTH);
+    int elem, res = 0;
+    size_t index, length;
+    for (int i = 0; i < TEST_LENGTH; i++) {
+        elem = i + 1;
+        length = unrolledList_len(list);
+        index = rand() % (length + 1u);
+        assert(!unrolledList_insert(list, index, &elem));
+        memmove(expect + index + 1, expect + index, (length - index) * sizeof(int));
+        expect[index] = elem;
+        assert(!unrolledList_get(list, index, &res));
+        assert(res == elem);
+    }
+    checkBlocks(list);
+    for (size_t i = 0; i < TEST_LENGTH; i++)
+        assert(*(int *) unrolledList_at(list, i) == expect[i]);
+    for (size_t i = TEST_LENGTH; i > 0; i--)
+        assert(*(int *) unrolledList_at(list, i - 1) == expect[i - 1]);
+    ListCursor cursor;
+    unrolledList_iterBegin(list, &cursor);
+    for (size_t i = 0; i < TEST_LENGTH; i++, unrolledList_iterNext(list, &cursor))
+        assert(*(int *) unrolledList_iterAt(list, &cursor) == expect[i]);
+    assert(!unrolledList_iterAt(list, &cursor));
+    assert(unrolledList_iterNext(list, &cursor) == 1);
+
+    // 区间读取与遍历。
+    int *range = malloc(sizeof(int) * 1000);
+    for (int i = 0; i < 100; i++) {
+        size_t count = rand() % 1000u;
+        index = rand() % (TEST_LENGTH - count + 1u);
+        assert(!unrolledList_getRange(list, index, count, range));
+        assert(!memcmp(range, expect + index, count * sizeof(int)));
+        long long sum = 0, want = 0;
+        for (size_t j = 0; j < count; j++)
+            want += expect[index + j];
+        assert(!unrolledList_travelRange(list, index, count, sumVisitor, &sum));
+        assert(sum == want);
+    }
+    free(range);
+    assert(unrolledList_getRange(list, TEST_LENGTH, 1, &res) == 1);
+    assert(unrolledList_travelRange(list, 1, TEST_LENGTH, sumVisitor, &res) == 1);
+
+    // 视图只在同一块内有效。
+    ListSpan span;
+    size_t base;
+    UnrolledListBlock *block = findBlock(list, TEST_LENGTH / 2, &base);
+    assert(!unrolledList_span(list, base, block->count, &span));
+    assert(span.length == block->count && span.stride == sizeof(int));
+    assert(!memcmp(span.base, expect + base, block->count * sizeof(int)));
+    assert(unrolledList_span(list, base, block->count + 1, &span) == 2);
+    assert(unrolledList_span(list, TEST_LENGTH, 1, &span) == 1);
+
+    for (int i = 0; i < TEST_LENGTH - 100; i++) {
+        length = unrolledList_len(list);
+        index = rand() % length;
+        assert(!unrolledList_getDel(list, index, &res));
+        assert(res == expect[index]);
+        memmove(expect + index, expect + index + 1, (length - index - 1) * sizeof(int));
+        if (i % 10000 == 0)
+            checkBlocks(list);
+    }
+    checkBlocks(list);
+
+    // 迭代中删除与插入。
+    unrolledList_iterBegin(list, &cursor);
+    for (size_t i = 0; i < 100; i++) {
+        if (i % 2) {
+            assert(!unrolledList_iterErase(list, &cursor, &res));
+            assert(res == expect[i]);
+        } else {
+            elem = -expect[i];
+            assert(!unrolledList_iterInsertBefore(list, &cursor, &elem));
+            assert(*(int *) unrolledList_iterAt(list, &cursor) == expect[i]);
+            assert(!unrolledList_iterNext(list, &cursor));
+        }
+        checkBlocks(list);
+    }
+    assert(!unrolledList_iterAt(list, &cursor));
+    assert(unrolledList_iterErase(list, &cursor, NULL) == 1);
+    elem = 0;
+    assert(!unrolledList_iterInsertBefore(list, &cursor, &elem));
+    assert(!unrolledList_iterAt(list, &cursor));
+    assert(!unrolledList_rpop(list, &res) && res == 0);
+    assert(unrolledList_len(list) == 100);
+    for (size_t i = 0; i < 100; i++)
+        assert(*(int *) unrolledList_at(list, i) == (i % 2 ? expect[i - 1] : -expect[i]));
+    checkBlocks(list);
+    free(expect);
+
+    assert(!unrolledList_clear(list));
+    assert(!unrolledList_len(list) && !list->head && !list->finger);
+    unrolledList_free(list);
+}
+
+// 块个数之和等于长度，块非空且不超容量，前后链接一致，缓存块位于链上且位置正确。
+static void checkBlocks(const UnrolledList *list) {
+    size_t length = 0;
+    _Bool fingerFound = list->finger == NULL;
+    const UnrolledListBlock *prev = NULL;
+    for (const UnrolledListBlock *block = list->head; block; block = block->next) {
+        assert(block->count > 0 && block->count <= list->blockCapacity);
+        assert(block->prev == prev);
+        if (block == list->finger) {
+            assert(list->fingerBase == length);
+            fingerFound = 1;
+        }
+        length += block->count;
+        prev = block;
+    }
+    assert(prev == list->tail);
+    assert(length == list->length);
+    assert(fingerFound);
+}
+
+static int intCmp(const void *o1, const void *o2) {
+    int *n1 = (int *) o1;
+    int *n2 = (int *) o2;
+    if (*n1 == *n2)
+        return 0;
+    return o1 > o2 ? 1 : -1;
+}
+
+static void intVisitor(void *p) {
+    static int prev = 1;
+    int i = *(int *) p;
+    assert(i == prev);
+    prev = i + 1;
+}
+
+static int sumVisitor(void *p, void *ctx) {
+    *(long long *) ctx += *(int *) p;
+    return 0;
+}